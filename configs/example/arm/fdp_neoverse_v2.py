@@ -207,6 +207,12 @@ parser.add_argument(
     help="Which SimPoint index to restore (0, 1, 2, etc.).",
 )
 
+parser.add_argument(
+    "--block-cache",
+    action="store_true",
+    help="Replay pre-decoded basic blocks on the fast-forward cores.",
+)
+
 args = parser.parse_args()
 
 
@@ -227,7 +233,12 @@ class FDPSwitchableProcessor(SwitchableProcessor):
     and NeoverseV2 O3 CPU for detailed simulation with FDP support.
     """
 
-    def __init__(self, num_cores: int = 1, disable_fdp: bool = False):
+    def __init__(
+        self,
+        num_cores: int = 1,
+        disable_fdp: bool = False,
+        block_cache: bool = False,
+    ):
         self._start_key = "start"
         self._switch_key = "switch"
         self._current_is_start = True
@@ -238,6 +249,10 @@ class FDPSwitchableProcessor(SwitchableProcessor):
             SimpleCore(cpu_type=CPUTypes.ATOMIC, core_id=i, isa=ISA.ARM)
             for i in range(num_cores)
         ]
+        # Replay pre-decoded basic blocks while fast-forwarding
+        if block_cache:
+            for core in start_cores:
+                core.get_simobject().blockCache = True
 
         # NeoverseV2 cores for detailed simulation
         switch_cores = []
@@ -391,7 +406,11 @@ cache_hierarchy = CacheHierarchy(disable_fdp=args.disable_fdp)
 
 if use_simpoint_mode:
     # SimPoint mode: use switchable processor for fast-forward + detailed
-    processor = FDPSwitchableProcessor(num_cores=1, disable_fdp=args.disable_fdp)
+    processor = FDPSwitchableProcessor(
+        num_cores=1,
+        disable_fdp=args.disable_fdp,
+        block_cache=args.block_cache,
+    )
     # Register detailed cores with cache hierarchy for FDP prefetcher
     cache_hierarchy.set_detailed_cores(processor.get_detailed_cores())
     print(
@@ -143,6 +143,21 @@ parser.add_argument(
     help="Enable Load Value Prediction.",
 )
 
+parser.add_argument(
+    "--lvp-mode",
+    type=str,
+    default="LastValue",
+    choices=["LastValue", "Stride", "TwoDeltaStride", "Context"],
+    help="Load Value Prediction scheme used when --enable-lvp is set.",
+)
+
+parser.add_argument(
+    "--lvp-selective-replay",
+    action="store_true",
+    help="Recover from value mispredictions by replaying only the "
+    "dependents of the load instead of squashing.",
+)
+
 parser.add_argument(
     "--enable-comp-simp",
     action="store_true",
@@ -271,6 +286,8 @@ for core in processor.cores:
     # Enable Load Value Prediction if requested.
     if args.enable_lvp:
         cpu.loadValuePredictor.enabled = True
+        cpu.loadValuePredictor.mode = args.lvp_mode
+        cpu.loadValuePredictor.selectiveReplay = args.lvp_selective_replay
 
     # Enable Computation Simplification if requested.
     if args.enable_comp_simp:
@@ -47,3 +47,10 @@ class ArmDecoder(InstDecoder):
     dvm_enabled = Param.Bool(
         False, "Does the decoder implement DVM operations"
     )
+    share_decoded_insts = Param.Bool(
+        True,
+        "Share decoded instructions with the other decoders of the "
+        "same configuration. Only decoders whose CPUs run on the same "
+        "event queue share, so nothing is shared between the cores of a "
+        "parallel fast-forward, where each core has its own queue.",
+    )
@@ -70,6 +70,9 @@ Decoder::Decoder(const ArmDecoderParams &params)
     smeLen = (safe_cast<ISA *>(params.isa)
             ->getCurSmeVecLenInBitsAtReset() >> 7) - 1;
 
+    if (params.share_decoded_insts)
+        defaultCache.share((uint64_t(decoderFlavor) << 1) | dvmEnabled);
+
     if (dvmEnabled) {
         warn_once(
             "DVM Ops instructions are micro-architecturally "
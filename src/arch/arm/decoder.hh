@@ -98,6 +98,12 @@ class Decoder : public InstDecoder
     GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
+    size_t
+    decodeCacheFootprint() const override
+    {
+        return defaultCache.footprint();
+    }
+
     /**
      * Pre-decode an instruction from the current state of the
      * decoder.
@@ -159,18 +165,21 @@ class Decoder : public InstDecoder
     {
         fpscrLen = fpscr.len;
         fpscrStride = fpscr.stride;
+        contextChanged();
     }
 
     void
     setSveLen(uint8_t len)
     {
         sveLen = len;
+        contextChanged();
     }
 
     void
     setSmeLen(uint8_t len)
     {
         smeLen = len;
+        contextChanged();
     }
 };
 
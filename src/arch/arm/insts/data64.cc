@@ -37,12 +37,31 @@
 
 #include "arch/arm/insts/data64.hh"
 
+#include <cstring>
+
 namespace gem5
 {
 
 namespace ArmISA
 {
 
+namespace
+{
+
+/** Index of the source operand reading integer register reg, or -1. */
+int
+findIntSrc(const StaticInst &inst, RegIndex reg)
+{
+    const RegId id = intRegClass[reg];
+    for (int i = 0; i < inst.numSrcRegs(); i++) {
+        if (inst.srcRegIdx(i) == id)
+            return i;
+    }
+    return -1;
+}
+
+} // anonymous namespace
+
 std::string
 DataXImmOp::generateDisassembly(
         Addr pc, const loader::SymbolTable *symtab) const
@@ -53,6 +72,16 @@ DataXImmOp::generateDisassembly(
     return ss.str();
 }
 
+bool
+DataXImmOp::isRegMove(int &src_idx) const
+{
+    // mov xd, sp is add xd, sp, #0. The 32-bit form zero extends.
+    if (strcmp(mnemonic, "add") != 0 || imm != 0 || intWidth != 64)
+        return false;
+    src_idx = findIntSrc(*this, op1);
+    return src_idx >= 0;
+}
+
 std::string
 DataXImmOnlyOp::generateDisassembly(
         Addr pc, const loader::SymbolTable *symtab) const
@@ -74,6 +103,30 @@ DataXSRegOp::generateDisassembly(
     return ss.str();
 }
 
+bool
+DataXSRegOp::isRegMove(int &src_idx) const
+{
+    // mov xd, xm is orr xd, xzr, xm. The 32-bit form zero extends.
+    if (strcmp(mnemonic, "orr") != 0 || shiftAmt != 0 || intWidth != 64 ||
+        !couldBeZero(op1) || couldBeZero(op2)) {
+        return false;
+    }
+    src_idx = findIntSrc(*this, op2);
+    return src_idx >= 0;
+}
+
+bool
+DataXSRegOp::isZeroIdiom() const
+{
+    // mov xd, xzr is orr xd, xzr, xzr.
+    if (strcmp(mnemonic, "orr") == 0)
+        return couldBeZero(op1) && couldBeZero(op2);
+    // eor xd, xn, xn and sub xd, xn, xn.
+    if (strcmp(mnemonic, "eor") == 0 || strcmp(mnemonic, "sub") == 0)
+        return op1 == op2 && shiftAmt == 0;
+    return false;
+}
+
 std::string
 DataXERegOp::generateDisassembly(
         Addr pc, const loader::SymbolTable *symtab) const
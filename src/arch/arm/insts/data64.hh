@@ -61,6 +61,9 @@ class DataXImmOp : public ArmStaticInst
 
     std::string generateDisassembly(
             Addr pc, const loader::SymbolTable *symtab) const override;
+
+  public:
+    bool isRegMove(int &src_idx) const override;
 };
 
 class DataXImmOnlyOp : public ArmStaticInst
@@ -96,6 +99,10 @@ class DataXSRegOp : public ArmStaticInst
 
     std::string generateDisassembly(
             Addr pc, const loader::SymbolTable *symtab) const override;
+
+  public:
+    bool isRegMove(int &src_idx) const override;
+    bool isZeroIdiom() const override;
 };
 
 class DataXERegOp : public ArmStaticInst
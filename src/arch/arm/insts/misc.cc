@@ -37,8 +37,10 @@
  */
 
 #include "arch/arm/insts/misc.hh"
-#include "arch/arm/tlbi_op.hh"
 
+#include <cstring>
+
+#include "arch/arm/tlbi_op.hh"
 #include "cpu/reg_class.hh"
 
 namespace gem5
@@ -306,6 +308,13 @@ RegImmImmOp::generateDisassembly(
     return ss.str();
 }
 
+bool
+RegImmImmOp::isZeroIdiom() const
+{
+    // movz xd, #0
+    return strcmp(mnemonic, "movz") == 0 && imm1 == 0;
+}
+
 std::string
 RegRegImmImmOp::generateDisassembly(
         Addr pc, const loader::SymbolTable *symtab) const
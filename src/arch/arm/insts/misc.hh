@@ -341,6 +341,9 @@ class RegImmImmOp : public ArmISA::PredOp
 
     std::string generateDisassembly(
             Addr pc, const loader::SymbolTable *symtab) const override;
+
+  public:
+    bool isZeroIdiom() const override;
 };
 
 class RegRegImmImmOp : public ArmISA::PredOp
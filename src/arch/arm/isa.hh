@@ -255,6 +255,13 @@ class ISA : public BaseISA
         return ArmISA::inUserMode(cpsr);
     }
 
+    bool
+    dataIndependentTiming() const override
+    {
+        CPSR cpsr = miscRegs[MISCREG_CPSR];
+        return cpsr.dit;
+    }
+
     void copyRegsFrom(ThreadContext *src) override;
 
     void handleLockedRead(const RequestPtr &req) override;
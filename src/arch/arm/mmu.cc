@@ -201,6 +201,7 @@ MMU::invalidateMiscReg()
     s1State.miscRegValid = false;
     s1State.computeAddrTop.flush();
     s2State.computeAddrTop.flush();
+    translationChanged();
 }
 
 void
@@ -218,6 +219,7 @@ MMU::flush(const TLBIOp &tlbi_op)
 void
 MMU::flushStage1(const TLBIOp &tlbi_op)
 {
+    translationChanged();
     for (auto tlb : instruction) {
         static_cast<TLB*>(tlb)->flush(tlbi_op);
     }
@@ -232,6 +234,7 @@ MMU::flushStage1(const TLBIOp &tlbi_op)
 void
 MMU::flushStage2(const TLBIOp &tlbi_op)
 {
+    translationChanged();
     itbStage2->flush(tlbi_op);
     dtbStage2->flush(tlbi_op);
 }
@@ -239,6 +242,7 @@ MMU::flushStage2(const TLBIOp &tlbi_op)
 void
 MMU::iflush(const TLBIOp &tlbi_op)
 {
+    translationChanged();
     for (auto tlb : instruction) {
         static_cast<TLB*>(tlb)->flush(tlbi_op);
     }
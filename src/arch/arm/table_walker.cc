@@ -540,6 +540,9 @@ TableWalker::Port::sendAtomicReq(
 {
     auto pkt = createPacket(req, data, delay, nullptr);
 
+    // The walker lives on the memory system's event queue; a CPU on
+    // another queue walking atomically migrates for the access.
+    EventQueue::ScopedMigration migrate(owner.eventQueue());
     Tick lat = sendAtomic(pkt);
 
     handleRespPacket(pkt, lat);
@@ -72,14 +72,19 @@ class TLBIOp
 
     /**
      * Broadcast the TLB Invalidate operation to all
-     * TLBs in the Arm system.
+     * TLBs in the Arm system. The other CPUs may be translating on
+     * their own host threads, so each MMU is updated holding its
+     * translation lock.
      * @param tc Thread Context
      */
     void
     broadcast(ThreadContext *tc)
     {
-        for (auto *oc: tc->getSystemPtr()->threads)
+        for (auto *oc: tc->getSystemPtr()->threads) {
+            std::lock_guard<std::mutex> lock(
+                oc->getMMUPtr()->translationLock());
             (*this)(oc);
+        }
     }
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const;
@@ -29,9 +29,16 @@
 #ifndef __ARCH_GENERIC_DECODE_CACHE_HH__
 #define __ARCH_GENERIC_DECODE_CACHE_HH__
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
 #include "cpu/static_inst_fwd.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -39,6 +46,66 @@ namespace gem5
 namespace GenericISA
 {
 
+/**
+ * Decoded instructions shared between decoders.
+ *
+ * StaticInsts don't change once decoded, so decoders which would decode
+ * a machine instruction the same way can share one object instead of
+ * each allocating their own. A configuration key selects the table and
+ * has to capture every decoder parameter decodeInst() depends on; the
+ * machine instruction carries the rest of the decoding state.
+ *
+ * StaticInsts are not reference counted atomically, so every event
+ * queue has its own tables, which only the thread running that queue
+ * touches.
+ */
+template <typename EMI, typename InstPtr = StaticInstPtr>
+class SharedInstTable
+{
+  private:
+    struct Entry
+    {
+        InstPtr inst;
+        // The decoder which decoded inst.
+        const void *owner = nullptr;
+    };
+    std::unordered_map<EMI, Entry> insts;
+
+  public:
+    /// Get the table for a decoder configuration on the current event
+    /// queue.
+    static SharedInstTable &
+    get(uint64_t config)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<uint64_t, EventQueue *>,
+                        SharedInstTable> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return tables[{config, curEventQueue()}];
+    }
+
+    /// Find a decoded instruction, decoding it if no decoder using this
+    /// table has seen it yet.
+    /// @param mach_inst The binary instruction to look up.
+    /// @param user The decoder doing the lookup.
+    /// @param decode Decodes mach_inst if it isn't in the table.
+    /// @param shared Set if another decoder decoded the instruction.
+    template <class Decode>
+    InstPtr
+    lookup(const EMI &mach_inst, const void *user, Decode decode,
+           bool &shared)
+    {
+        Entry &entry = insts[mach_inst];
+        if (!entry.inst) {
+            entry.inst = decode();
+            entry.owner = user;
+        }
+        shared = entry.owner != user;
+        return entry.inst;
+    }
+};
+
 template <typename Decoder, typename EMI>
 class BasicDecodeCache
 {
@@ -51,17 +118,60 @@ class BasicDecodeCache
     };
     decode_cache::AddrMap<AddrMapEntry> decodePages;
 
+    /// Configuration key of the shared table, if sharing.
+    std::optional<uint64_t> shareConfig;
+    SharedInstTable<EMI> *sharedTable = nullptr;
+    EventQueue *sharedQueue = nullptr;
+
+    /// Switch to the shared table of the current event queue, dropping
+    /// the instructions of the previous one.
+    void
+    updateSharedTable()
+    {
+        instMap.clear();
+        decodePages.clear();
+        sharedTable = &SharedInstTable<EMI>::get(*shareConfig);
+        sharedQueue = curEventQueue();
+    }
+
+    /// Decode an instruction missing from instMap, going through the
+    /// shared table if there is one.
+    StaticInstPtr
+    decodeMiss(Decoder *const decoder, EMI mach_inst)
+    {
+        if (!shareConfig)
+            return decoder->decodeInst(mach_inst);
+
+        bool shared;
+        StaticInstPtr inst = sharedTable->lookup(mach_inst, decoder,
+                [&]() { return decoder->decodeInst(mach_inst); }, shared);
+        if (shared)
+            decoder->decodeCacheStats.sharedInsts++;
+        return inst;
+    }
+
   public:
+    /// Share decoded instructions with the other decoders using the same
+    /// configuration key, see SharedInstTable.
+    /// @param config Key covering the parameters of the decoder.
+    void share(uint64_t config) { shareConfig = config; }
+
     /// Decode a machine instruction.
     /// @param mach_inst The binary instruction to decode.
     /// @retval A pointer to the corresponding StaticInst object.
     StaticInstPtr
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
+        if (shareConfig && sharedQueue != curEventQueue())
+            updateSharedTable();
+
         auto &entry = decodePages.lookup(addr);
-        if (entry.inst && (entry.machInst == mach_inst))
+        if (entry.inst && (entry.machInst == mach_inst)) {
+            decoder->decodeCacheStats.hits++;
             return entry.inst;
+        }
 
+        decoder->decodeCacheStats.misses++;
         entry.machInst = mach_inst;
 
         auto iter = instMap.find(mach_inst);
@@ -70,10 +180,13 @@ class BasicDecodeCache
             return entry.inst;
         }
 
-        entry.inst = decoder->decodeInst(mach_inst);
+        entry.inst = decodeMiss(decoder, mach_inst);
         instMap[mach_inst] = entry.inst;
         return entry.inst;
     }
+
+    /// Bytes allocated for the per-address entries.
+    size_t footprint() const { return decodePages.footprint(); }
 };
 
 } // namespace GenericISA
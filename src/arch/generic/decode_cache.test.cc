@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "arch/generic/decode_cache.hh"
+#include "base/refcnt.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct TestInst : public RefCounted
+{
+    explicit TestInst(uint64_t _bits) : bits(_bits) {}
+    uint64_t bits;
+};
+
+typedef RefCountingPtr<TestInst> TestInstPtr;
+typedef GenericISA::SharedInstTable<uint64_t, TestInstPtr> TestTable;
+
+} // anonymous namespace
+
+/** The first user decodes an instruction; later users share it. */
+TEST(SharedInstTableTest, UsersShareEntries)
+{
+    TestTable table;
+    int owner, other;
+    int decodes = 0;
+    auto decode = [&]() { decodes++; return TestInstPtr(new TestInst(7)); };
+
+    bool shared = true;
+    TestInstPtr first = table.lookup(7, &owner, decode, shared);
+    EXPECT_FALSE(shared);
+    EXPECT_EQ(1, decodes);
+    EXPECT_EQ(7, first->bits);
+
+    TestInstPtr second = table.lookup(7, &other, decode, shared);
+    EXPECT_TRUE(shared);
+    EXPECT_EQ(1, decodes);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+/** The owner looking an instruction up again doesn't count as sharing. */
+TEST(SharedInstTableTest, OwnerIsNotShared)
+{
+    TestTable table;
+    int owner, other;
+    auto decode = [&]() { return TestInstPtr(new TestInst(1)); };
+
+    bool shared;
+    table.lookup(1, &owner, decode, shared);
+    table.lookup(1, &other, decode, shared);
+    table.lookup(1, &owner, decode, shared);
+    EXPECT_FALSE(shared);
+}
+
+/** Different machine instructions get different entries. */
+TEST(SharedInstTableTest, DistinctInstructions)
+{
+    TestTable table;
+    int owner, other;
+
+    bool shared;
+    TestInstPtr a = table.lookup(1, &owner,
+            [] { return TestInstPtr(new TestInst(1)); }, shared);
+    TestInstPtr b = table.lookup(2, &other,
+            [] { return TestInstPtr(new TestInst(2)); }, shared);
+    EXPECT_FALSE(shared);
+    EXPECT_NE(a.get(), b.get());
+    EXPECT_EQ(2, b->bits);
+}
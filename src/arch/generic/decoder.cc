@@ -28,10 +28,33 @@
 #include "arch/generic/decoder.hh"
 
 #include "base/logging.hh"
+#include "cpu/static_inst.hh"
 
 namespace gem5
 {
 
+InstDecoder::DecodeCacheStats::DecodeCacheStats(InstDecoder *decoder)
+    : statistics::Group(decoder, "decodeCache"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of decodes served from the decode cache"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of decodes missing in the decode cache"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Decode cache hit rate", hits / (hits + misses)),
+      ADD_STAT(footprint, statistics::units::Byte::get(),
+               "Bytes allocated by the decode cache"),
+      ADD_STAT(sharedInsts, statistics::units::Count::get(),
+               "Number of instructions decoded by another decoder and "
+               "shared with this one"),
+      ADD_STAT(bytesSavedLowerBound, statistics::units::Byte::get(),
+               "Lower bound of the bytes saved by sharing instructions "
+               "with other decoders, counting sizeof(StaticInst) for each",
+               sharedInsts * statistics::constant(sizeof(StaticInst)))
+{
+    hitRate.precision(6);
+    footprint.method(decoder, &InstDecoder::decodeCacheFootprint);
+}
+
 StaticInstPtr
 InstDecoder::fetchRomMicroop(MicroPC micropc, StaticInstPtr curMacroop)
 {
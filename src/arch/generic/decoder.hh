@@ -31,6 +31,7 @@
 #include "arch/generic/pcstate.hh"
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 #include "params/InstDecoder.hh"
@@ -49,12 +50,41 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    /** Generation of the decoding context, see contextGeneration(). */
+    uint64_t _contextGeneration = 0;
+
+    /** Called by decoders whenever state other than the instruction
+     * bytes and the PC that influences decoding changes. */
+    void contextChanged() { ++_contextGeneration; }
+
+    struct DecodeCacheStats : public statistics::Group
+    {
+        DecodeCacheStats(InstDecoder *decoder);
+
+        /** Decodes served from the decode cache */
+        statistics::Scalar hits;
+        /** Decodes which had to decode the instruction */
+        statistics::Scalar misses;
+        statistics::Formula hitRate;
+        /** Bytes allocated by the decode cache */
+        statistics::Value footprint;
+        /** Instructions reused from another decoder's decodes */
+        statistics::Scalar sharedInsts;
+        statistics::Formula bytesSavedLowerBound;
+    } decodeCacheStats;
+
+    /**
+     * Bytes held by the decode cache used by this decoder. Decoders
+     * sharing a cache all report its full size.
+     */
+    virtual size_t decodeCacheFootprint() const { return 0; }
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
         SimObject(params), _moreBytesPtr(mb_buf),
         _moreBytesSize(sizeof(MoreBytesType)),
-        _pcMask(~mask(floorLog2(_moreBytesSize)))
+        _pcMask(~mask(floorLog2(_moreBytesSize))), decodeCacheStats(this)
     {}
 
     virtual StaticInstPtr fetchRomMicroop(
@@ -96,6 +126,16 @@ class InstDecoder : public SimObject
     size_t moreBytesSize() const { return _moreBytesSize; }
     Addr pcMask() const { return _pcMask; }
 
+    /**
+     * Generation of the decoding context.
+     *
+     * It changes whenever the decoder is reconfigured in a way that can
+     * make the same bytes at the same PC decode to a different
+     * instruction, e.g. a new vector length. CPU models keeping decoded
+     * instructions around use it to know when to drop them.
+     */
+    uint64_t contextGeneration() const { return _contextGeneration; }
+
     /**
      * Is an instruction ready to be decoded?
      *
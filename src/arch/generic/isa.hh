@@ -146,6 +146,15 @@ class BaseISA : public SimObject
      * For other ISAs, this function returns -1.
      */
     virtual int64_t getVectorLengthInBytes() const { return -1; }
+
+    /**
+     * Whether the thread is currently executing with data-independent
+     * timing requested (e.g. PSTATE.DIT on Arm). While set, the timing of
+     * an instruction must not depend on the values it operates on, so
+     * value-dependent microarchitectural optimizations have to be
+     * disabled. ISAs without such a control return false.
+     */
+    virtual bool dataIndependentTiming() const { return false; }
 };
 
 } // namespace gem5
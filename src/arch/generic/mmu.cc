@@ -80,6 +80,8 @@ BaseMMU::init()
 void
 BaseMMU::flushAll()
 {
+    translationChanged();
+
     for (auto tlb : instruction) {
         tlb->flushAll();
     }
@@ -103,6 +105,7 @@ BaseMMU::reset()
 void
 BaseMMU::demapPage(Addr vaddr, uint64_t asn)
 {
+    translationChanged();
     itb->demapPage(vaddr, asn);
     dtb->demapPage(vaddr, asn);
 }
@@ -38,6 +38,7 @@
 #ifndef __ARCH_GENERIC_MMU_HH__
 #define __ARCH_GENERIC_MMU_HH__
 
+#include <mutex>
 #include <set>
 
 #include "mem/request.hh"
@@ -158,6 +159,29 @@ class BaseMMU : public SimObject
 
     virtual void takeOverFrom(BaseMMU *old_mmu);
 
+    /**
+     * Lock serialising translations of the owning CPU with TLB updates
+     * made from other host threads, e.g. broadcast TLB invalidations,
+     * when CPUs are simulated on separate event queues.
+     */
+    std::mutex &translationLock() { return _translationLock; }
+
+    /**
+     * Generation of the translations. It changes whenever cached
+     * translations are flushed or the translation regime changes, so CPU
+     * models keeping translated addresses around know when to drop them.
+     */
+    uint64_t translationGeneration() const { return _translationGeneration; }
+
+  protected:
+    /** Called whenever translations may have changed. */
+    void translationChanged() { ++_translationGeneration; }
+
+  private:
+    std::mutex _translationLock;
+
+    uint64_t _translationGeneration = 0;
+
   public:
     BaseTLB* dtb;
     BaseTLB* itb;
@@ -71,6 +71,12 @@ class Decoder : public InstDecoder
     static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
+    size_t
+    decodeCacheFootprint() const override
+    {
+        return defaultCache.footprint();
+    }
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
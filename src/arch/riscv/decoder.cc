@@ -122,8 +122,12 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
             mach_inst.instBits, addr);
 
     StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
+    if (si) {
+        decodeCacheStats.hits++;
+    } else {
+        decodeCacheStats.misses++;
         si = decodeInst(mach_inst);
+    }
 
     si->size(compressed(mach_inst) ? 2 : 4);
 
@@ -361,14 +361,14 @@ Walker::WalkerState::walkGStage(Addr guest_paddr, Addr& host_paddr)
     }
     else {
         do {
-            walker->port.sendAtomic(read);
+            walker->port.sendAtomicMigrated(read);
             PacketPtr write = NULL;
             fault = stepWalkGStage(write);
             assert(fault == NoFault || read == NULL);
             gstate = nextgState;
             nextgState = Ready;
             if (write) {
-                walker->port.sendAtomic(write);
+                walker->port.sendAtomicMigrated(write);
             }
         } while (read);
 
@@ -470,7 +470,7 @@ Walker::WalkerState::walkOneStage(Addr vaddr)
             walker->port.sendFunctional(read);
         }
         else {
-            walker->port.sendAtomic(read);
+            walker->port.sendAtomicMigrated(read);
         }
 
         PacketPtr write = NULL;
@@ -482,7 +482,7 @@ Walker::WalkerState::walkOneStage(Addr vaddr)
         // On a functional access (page table lookup), writes should
         // not happen so this pointer is ignored after stepWalk
         if (write && !functional) {
-            walker->port.sendAtomic(write);
+            walker->port.sendAtomicMigrated(write);
         }
     } while (read);
 
@@ -554,7 +554,7 @@ Walker::WalkerState::walkTwoStage(Addr vaddr)
         if (functional) {
             walker->port.sendFunctional(read);
         } else {
-            walker->port.sendAtomic(read);
+            walker->port.sendAtomicMigrated(read);
         }
 
         PacketPtr write = NULL;
@@ -574,7 +574,7 @@ Walker::WalkerState::walkTwoStage(Addr vaddr)
         // On a functional access (page table lookup), writes should
         // not happen so this pointer is ignored after stepWalk
         if (write && !functional) {
-            walker->port.sendAtomic(write);
+            walker->port.sendAtomicMigrated(write);
         }
     } while (read);
 
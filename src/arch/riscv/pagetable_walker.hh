@@ -72,6 +72,15 @@ namespace RiscvISA
                   RequestPort(_name), walker(_walker)
             {}
 
+            /** Atomic access from the walker's event queue, which CPUs
+             * on another queue migrate to for the access. */
+            Tick
+            sendAtomicMigrated(PacketPtr pkt)
+            {
+                EventQueue::ScopedMigration migrate(walker->eventQueue());
+                return sendAtomic(pkt);
+            }
+
           protected:
             Walker *walker;
 
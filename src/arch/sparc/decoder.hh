@@ -79,6 +79,7 @@ class Decoder : public InstDecoder
     setContext(RegVal _asi)
     {
         asi = _asi;
+        contextChanged();
     }
 
   protected:
@@ -86,6 +87,12 @@ class Decoder : public InstDecoder
     static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
+    size_t
+    decodeCacheFootprint() const override
+    {
+        return defaultCache.footprint();
+    }
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -637,8 +637,10 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
 
     auto iter = instMap->find(mach_inst);
     if (iter != instMap->end()) {
+        decodeCacheStats.hits++;
         si = iter->second;
     } else {
+        decodeCacheStats.misses++;
         si = decodeInst(mach_inst);
         (*instMap)[mach_inst] = si;
     }
@@ -239,6 +239,9 @@ Walker::WalkerState::startWalk()
         timingFault = NoFault;
         sendPackets();
     } else {
+        // The walker lives on the memory system's event queue; a CPU on
+        // another queue walking atomically migrates for the accesses.
+        EventQueue::ScopedMigration migrate(walker->eventQueue());
         do {
             walker->port.sendAtomic(read);
             PacketPtr write = NULL;
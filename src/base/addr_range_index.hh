@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __BASE_ADDR_RANGE_INDEX_HH__
+#define __BASE_ADDR_RANGE_INDEX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A hashed index of byte address ranges.
+ *
+ * Each entry is identified by a caller-chosen key, e.g. the absolute index
+ * of a CircularQueue slot, and is filed under every aligned granule its
+ * range touches. A lookup returns the keys of all entries that share a
+ * granule with the queried range. That is a superset of the overlapping
+ * entries, so callers still run their exact overlap test, but only on
+ * entries near the address instead of on the whole queue.
+ *
+ * Inserting an existing key replaces its range. Zero-sized ranges are not
+ * indexed.
+ */
+class AddrRangeIndex
+{
+  public:
+    using Key = uint64_t;
+
+  private:
+    /** log2 of the granule size in bytes. */
+    unsigned shift;
+
+    /** Keys filed under each granule number. */
+    std::unordered_map<Addr, std::vector<Key>> buckets;
+
+    /** First and last granule of each indexed entry. */
+    std::unordered_map<Key, std::pair<Addr, Addr>> ranges;
+
+    void
+    unfile(Addr granule, Key key)
+    {
+        auto bucket = buckets.find(granule);
+        assert(bucket != buckets.end());
+        auto &keys = bucket->second;
+        auto it = std::find(keys.begin(), keys.end(), key);
+        assert(it != keys.end());
+        *it = keys.back();
+        keys.pop_back();
+        if (keys.empty()) {
+            buckets.erase(bucket);
+        }
+    }
+
+  public:
+    explicit AddrRangeIndex(unsigned granule_shift=6)
+        : shift(granule_shift)
+    {}
+
+    /** Number of indexed entries. */
+    size_t size() const { return ranges.size(); }
+
+    /** Is the key indexed? */
+    bool contains(Key key) const { return ranges.count(key); }
+
+    /** Index [addr, addr + size) under key. */
+    void
+    insert(Key key, Addr addr, Addr size)
+    {
+        erase(key);
+        if (size == 0) {
+            return;
+        }
+
+        const Addr first = addr >> shift;
+        const Addr last = (addr + size - 1) >> shift;
+        ranges.emplace(key, std::make_pair(first, last));
+        for (Addr granule = first; granule <= last; ++granule) {
+            buckets[granule].push_back(key);
+        }
+    }
+
+    /** Remove key from the index, if present. */
+    void
+    erase(Key key)
+    {
+        auto range = ranges.find(key);
+        if (range == ranges.end()) {
+            return;
+        }
+
+        for (Addr granule = range->second.first;
+             granule <= range->second.second; ++granule) {
+            unfile(granule, key);
+        }
+        ranges.erase(range);
+    }
+
+    /** Remove all entries. */
+    void
+    clear()
+    {
+        buckets.clear();
+        ranges.clear();
+    }
+
+    /**
+     * Find the entries sharing a granule with [addr, addr + size).
+     *
+     * @param keys Replaced with the matching keys, sorted ascending and
+     *             free of duplicates.
+     */
+    void
+    lookup(Addr addr, Addr size, std::vector<Key> &keys) const
+    {
+        keys.clear();
+        if (size == 0) {
+            return;
+        }
+
+        const Addr first = addr >> shift;
+        const Addr last = (addr + size - 1) >> shift;
+        for (Addr granule = first; granule <= last; ++granule) {
+            auto bucket = buckets.find(granule);
+            if (bucket != buckets.end()) {
+                keys.insert(keys.end(), bucket->second.begin(),
+                            bucket->second.end());
+            }
+        }
+
+        std::sort(keys.begin(), keys.end());
+        if (first != last) {
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_ADDR_RANGE_INDEX_HH__
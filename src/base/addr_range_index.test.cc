@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "base/addr_range_index.hh"
+
+using namespace gem5;
+
+TEST(AddrRangeIndexTest, Empty)
+{
+    AddrRangeIndex index;
+    std::vector<AddrRangeIndex::Key> keys{1, 2};
+
+    index.lookup(0x1000, 8, keys);
+    ASSERT_TRUE(keys.empty());
+    ASSERT_EQ(index.size(), 0);
+}
+
+/** Entries sharing a granule are found, others are not. */
+TEST(AddrRangeIndexTest, SameGranule)
+{
+    AddrRangeIndex index(6);
+    std::vector<AddrRangeIndex::Key> keys;
+
+    index.insert(3, 0x1000, 8);
+    index.insert(1, 0x1038, 8);
+    index.insert(2, 0x1040, 8);
+
+    index.lookup(0x1010, 4, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{1, 3}));
+
+    index.lookup(0x1044, 4, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{2}));
+}
+
+/** An entry crossing a granule boundary is filed under both granules and
+ * reported once. */
+TEST(AddrRangeIndexTest, SpansGranules)
+{
+    AddrRangeIndex index(6);
+    std::vector<AddrRangeIndex::Key> keys;
+
+    index.insert(7, 0x103c, 8);
+    index.lookup(0x1000, 4, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{7}));
+    index.lookup(0x1040, 4, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{7}));
+    index.lookup(0x1000, 0x80, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{7}));
+}
+
+/** Re-inserting a key moves it, erasing removes it. */
+TEST(AddrRangeIndexTest, ReplaceAndErase)
+{
+    AddrRangeIndex index(6);
+    std::vector<AddrRangeIndex::Key> keys;
+
+    index.insert(5, 0x2000, 8);
+    index.insert(5, 0x3000, 8);
+    ASSERT_EQ(index.size(), 1);
+    index.lookup(0x2000, 8, keys);
+    ASSERT_TRUE(keys.empty());
+    index.lookup(0x3000, 8, keys);
+    ASSERT_EQ(keys, (std::vector<AddrRangeIndex::Key>{5}));
+
+    index.erase(5);
+    ASSERT_FALSE(index.contains(5));
+    index.lookup(0x3000, 8, keys);
+    ASSERT_TRUE(keys.empty());
+
+    // Zero-sized ranges are not indexed.
+    index.insert(6, 0x3000, 0);
+    ASSERT_FALSE(index.contains(6));
+}
+
+/** The lookup result is a superset of the byte-overlapping entries and
+ * never contains an entry from an unrelated granule. */
+TEST(AddrRangeIndexTest, MatchesLinearScan)
+{
+    const unsigned shift = 4;
+    AddrRangeIndex index(shift);
+    std::map<AddrRangeIndex::Key, std::pair<Addr, Addr>> entries;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Addr> addr_dist(0, 0x400);
+    std::uniform_int_distribution<Addr> size_dist(1, 40);
+    std::vector<AddrRangeIndex::Key> keys;
+
+    for (AddrRangeIndex::Key key = 0; key < 2000; ++key) {
+        const Addr addr = addr_dist(rng);
+        const Addr size = size_dist(rng);
+        index.insert(key, addr, size);
+        entries[key] = {addr, addr + size};
+
+        // Keep a window of live entries like a load/store queue.
+        if (key >= 64) {
+            index.erase(key - 64);
+            entries.erase(key - 64);
+        }
+
+        const Addr q_s = addr_dist(rng);
+        const Addr q_e = q_s + size_dist(rng);
+        index.lookup(q_s, q_e - q_s, keys);
+        ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+        for (const auto &[k, range] : entries) {
+            const bool overlaps = q_s < range.second && range.first < q_e;
+            const bool same_granule =
+                (q_s >> shift) <= ((range.second - 1) >> shift) &&
+                (range.first >> shift) <= ((q_e - 1) >> shift);
+            const bool found =
+                std::binary_search(keys.begin(), keys.end(), k);
+            ASSERT_EQ(found, same_granule);
+            if (overlaps) {
+                ASSERT_TRUE(found);
+            }
+        }
+        ASSERT_EQ(index.size(), entries.size());
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __BASE_POOLED_LIST_HH__
+#define __BASE_POOLED_LIST_HH__
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <utility>
+
+namespace gem5
+{
+
+/**
+ * A doubly-linked list that recycles its nodes.
+ *
+ * Erased nodes are kept on a free pool and reused by later insertions, so
+ * once the pool has been reserved (or has grown to the list's high-water
+ * mark) insertion and erasure never touch the heap. Nodes move between the
+ * live list and the pool with std::list::splice, which keeps the iterator
+ * semantics of std::list: iterators to live elements stay valid until the
+ * element is erased, and end() is stable. Iterators are plain
+ * std::list<T>::iterator, so code that stores them keeps working.
+ *
+ * An erased element is reset to a default-constructed T before its node is
+ * pooled, so it drops any reference it holds straight away.
+ *
+ * @tparam T Type of the elements in the list
+ */
+template <typename T>
+class PooledList
+{
+  private:
+    using List = std::list<T>;
+
+    /** The elements of the list. */
+    List live;
+    /** Recycled nodes, all holding default-constructed values. */
+    List pool;
+
+  public:
+    using value_type = T;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = typename List::size_type;
+    using iterator = typename List::iterator;
+    using const_iterator = typename List::const_iterator;
+    using reverse_iterator = typename List::reverse_iterator;
+    using const_reverse_iterator = typename List::const_reverse_iterator;
+
+    explicit PooledList(size_type reserved=0) { reserve(reserved); }
+
+    PooledList(const PooledList &) = delete;
+    PooledList &operator=(const PooledList &) = delete;
+
+    /** Make sure at least n elements can be held without allocating. */
+    void
+    reserve(size_type n)
+    {
+        while (live.size() + pool.size() < n)
+            pool.emplace_back();
+    }
+
+    /** Number of nodes held, live or pooled. */
+    size_type capacity() const { return live.size() + pool.size(); }
+
+    size_type size() const { return live.size(); }
+    bool empty() const { return live.empty(); }
+
+    reference front() { return live.front(); }
+    const_reference front() const { return live.front(); }
+    reference back() { return live.back(); }
+    const_reference back() const { return live.back(); }
+
+    iterator begin() { return live.begin(); }
+    const_iterator begin() const { return live.begin(); }
+    iterator end() { return live.end(); }
+    const_iterator end() const { return live.end(); }
+    reverse_iterator rbegin() { return live.rbegin(); }
+    const_reverse_iterator rbegin() const { return live.rbegin(); }
+    reverse_iterator rend() { return live.rend(); }
+    const_reverse_iterator rend() const { return live.rend(); }
+
+    /** Insert an element before pos, reusing a pooled node if any. */
+    iterator
+    insert(const_iterator pos, T val)
+    {
+        if (pool.empty())
+            pool.emplace_back();
+        iterator it = pool.begin();
+        *it = std::move(val);
+        live.splice(pos, pool, it);
+        return it;
+    }
+
+    void push_back(T val) { insert(live.end(), std::move(val)); }
+    void push_front(T val) { insert(live.begin(), std::move(val)); }
+
+    /** Erase the element at pos and return the iterator following it. */
+    iterator
+    erase(const_iterator pos)
+    {
+        // Turn pos into a mutable iterator without walking the list.
+        iterator it = live.erase(pos, pos);
+        iterator next = std::next(it);
+        *it = T();
+        pool.splice(pool.begin(), live, it);
+        return next;
+    }
+
+    void pop_front() { erase(live.begin()); }
+    void pop_back() { erase(std::prev(live.end())); }
+
+    void
+    clear()
+    {
+        for (auto &val : live)
+            val = T();
+        pool.splice(pool.begin(), live);
+    }
+
+    /** Move all elements of another list before pos. */
+    void
+    splice(const_iterator pos, PooledList &other)
+    {
+        live.splice(pos, other.live);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOLED_LIST_HH__
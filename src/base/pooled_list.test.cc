@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/pooled_list.hh"
+
+using namespace gem5;
+
+TEST(PooledListTest, Reserve)
+{
+    PooledList<int> list(8);
+
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0);
+    ASSERT_EQ(list.capacity(), 8);
+}
+
+/** Behaves as a FIFO/LIFO at both ends. */
+TEST(PooledListTest, PushPop)
+{
+    PooledList<int> list(4);
+
+    list.push_back(1);
+    list.push_back(2);
+    list.push_front(0);
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(list.front(), 0);
+    ASSERT_EQ(list.back(), 2);
+
+    list.pop_front();
+    ASSERT_EQ(list.front(), 1);
+    list.pop_back();
+    ASSERT_EQ(list.back(), 1);
+    ASSERT_EQ(list.size(), 1);
+    ASSERT_EQ(list.capacity(), 4);
+}
+
+/** Nodes are recycled rather than allocated past the high-water mark. */
+TEST(PooledListTest, Recycle)
+{
+    PooledList<int> list;
+
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 16; i++)
+            list.push_back(i);
+        for (int i = 0; i < 16; i++) {
+            ASSERT_EQ(list.front(), i);
+            list.pop_front();
+        }
+        ASSERT_EQ(list.capacity(), 16);
+    }
+}
+
+/** Insert and erase in the middle, as an ordered list. */
+TEST(PooledListTest, InsertErase)
+{
+    PooledList<int> list;
+
+    list.push_back(1);
+    list.push_back(3);
+    auto it = list.insert(std::next(list.begin()), 2);
+    ASSERT_EQ(*it, 2);
+
+    std::vector<int> expected = {1, 2, 3};
+    ASSERT_EQ(std::vector<int>(list.begin(), list.end()), expected);
+
+    auto next = list.erase(it);
+    ASSERT_EQ(*next, 3);
+    expected = {1, 3};
+    ASSERT_EQ(std::vector<int>(list.begin(), list.end()), expected);
+}
+
+/** Iterators to other elements and end() survive insertion and erasure. */
+TEST(PooledListTest, IteratorStability)
+{
+    PooledList<int> list(2);
+
+    auto end = list.end();
+    list.push_back(1);
+    auto first = list.begin();
+    list.push_back(2);
+    list.push_back(3);
+    list.erase(std::next(first));
+
+    ASSERT_EQ(*first, 1);
+    ASSERT_EQ(std::next(first, 2), end);
+    ASSERT_EQ(list.end(), end);
+}
+
+/** Erased elements are reset, releasing what they own. */
+TEST(PooledListTest, ReleaseOnErase)
+{
+    PooledList<std::shared_ptr<int>> list;
+    auto val = std::make_shared<int>(42);
+
+    list.push_back(val);
+    list.push_back(val);
+    ASSERT_EQ(val.use_count(), 3);
+
+    list.pop_front();
+    ASSERT_EQ(val.use_count(), 2);
+
+    list.clear();
+    ASSERT_EQ(val.use_count(), 1);
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.capacity(), 2);
+}
+
+TEST(PooledListTest, Splice)
+{
+    PooledList<int> a;
+    PooledList<int> b;
+
+    a.push_back(1);
+    b.push_back(2);
+    b.push_back(3);
+    a.splice(a.end(), b);
+
+    std::vector<int> expected = {1, 2, 3};
+    ASSERT_EQ(std::vector<int>(a.begin(), a.end()), expected);
+    ASSERT_TRUE(b.empty());
+}
@@ -134,6 +134,13 @@ class OpClass(Enum):
     ]
 
 
+class OpLatencyModel(SimObject):
+    type = "OpLatencyModel"
+    abstract = True
+    cxx_header = "cpu/func_unit.hh"
+    cxx_class = "gem5::OpLatencyModel"
+
+
 class OpDesc(SimObject):
     type = "OpDesc"
     cxx_header = "cpu/func_unit.hh"
@@ -146,6 +153,11 @@ class OpDesc(SimObject):
         "set to true when the functional unit for"
         "this op is fully pipelined. False means not pipelined at all.",
     )
+    valueLat = Param.OpLatencyModel(
+        NULL,
+        "operand-value-dependent latency model applied at issue; opLat "
+        "is used unchanged if not set",
+    )
 
 
 class FUDesc(SimObject):
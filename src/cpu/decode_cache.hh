@@ -29,6 +29,7 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
@@ -46,94 +47,178 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
+/**
+ * A sparse map from an Addr to a Value.
+ *
+ * Entries live in a two-level radix page table. A hash map indexed by
+ * the upper address bits holds directories, each directly mapping
+ * 1 << DirShift page chunks. Chunks are split into lines of
+ * 1 << LineShift entries which are only allocated once touched, so
+ * sparsely used code pages stay small. A direct-mapped cache of
+ * recently used lines sits in front of the table.
+ */
 template<class Value, Addr CacheChunkShift = 12>
 class AddrMap
 {
   protected:
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
+    static constexpr Addr LineShift = std::min<Addr>(CacheChunkShift, 6);
+    static constexpr Addr LineBytes = 1ULL << LineShift;
+    static constexpr Addr LinesPerChunk = CacheChunkBytes / LineBytes;
+    static constexpr Addr DirShift = 9;
+    static constexpr Addr ChunksPerDir = 1ULL << DirShift;
+    static constexpr Addr DirBytesShift = CacheChunkShift + DirShift;
+    static constexpr unsigned RecentLines = 64;
 
     static constexpr Addr
-    chunkOffset(Addr addr)
+    lineOffset(Addr addr)
     {
-        return addr & (CacheChunkBytes - 1);
+        return addr & (LineBytes - 1);
     }
 
     static constexpr Addr
-    chunkStart(Addr addr)
+    lineStart(Addr addr)
     {
-        return addr & ~(CacheChunkBytes - 1);
+        return addr & ~(LineBytes - 1);
     }
 
-    // A chunk of cache entries.
+    // A line of cache entries.
+    struct Line
+    {
+        Value items[LineBytes];
+    };
+    // A page chunk, pointing to the lines in use.
     struct CacheChunk
     {
-        Value items[CacheChunkBytes];
+        Line *lines[LinesPerChunk];
     };
-    // A map of cache chunks which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
-    ChunkMap chunkMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // A directory of page chunks.
+    struct Directory
+    {
+        CacheChunk *chunks[ChunksPerDir];
+    };
+    // Directories by address, which allows a sparse mapping.
+    typedef typename std::unordered_map<Addr, Directory *> DirMap;
+    DirMap dirMap;
+
+    // Direct-mapped cache of recently used lines.
+    struct RecentLine
+    {
+        Addr addr;
+        Line *line;
+    };
+    RecentLine recent[RecentLines];
+
+    // Last directory looked up in dirMap.
+    Addr lastDirAddr = 0;
+    Directory *lastDir = nullptr;
+
+    size_t _footprint = 0;
+
+    template <class T>
+    T *
+    allocate()
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        _footprint += sizeof(T);
+        return new T();
     }
 
-    /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
-    /// @param addr The address to look up.
-    CacheChunk *
-    getChunk(Addr addr)
+    RecentLine &
+    recentFor(Addr addr)
     {
-        Addr chunk_addr = chunkStart(addr);
-
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        return recent[(addr >> LineShift) % RecentLines];
+    }
 
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
-        }
+    void
+    resetRecent()
+    {
+        for (auto &r: recent)
+            r = {0, nullptr};
+        lastDirAddr = 0;
+        lastDir = nullptr;
+    }
 
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+    Directory *
+    getDir(Addr addr)
+    {
+        Addr dir_addr = addr >> DirBytesShift;
+        if (lastDir && lastDirAddr == dir_addr)
+            return lastDir;
+
+        Directory *&dir = dirMap[dir_addr];
+        if (!dir)
+            dir = allocate<Directory>();
+        lastDirAddr = dir_addr;
+        lastDir = dir;
+        return dir;
+    }
+
+    /// Find the Line which goes with a particular address, allocating
+    /// it and the levels above it as needed. First check the cache of
+    /// recent lines, then walk the page table.
+    /// @param addr The address to look up.
+    Line *
+    getLine(Addr addr)
+    {
+        Addr line_addr = lineStart(addr);
+        RecentLine &r = recentFor(line_addr);
+        if (GEM5_LIKELY(r.line && r.addr == line_addr))
+            return r.line;
+
+        Directory *dir = getDir(addr);
+        CacheChunk *&chunk =
+            dir->chunks[bits(addr, DirBytesShift - 1, CacheChunkShift)];
+        if (!chunk)
+            chunk = allocate<CacheChunk>();
+        Line *&line = chunk->lines[
+            (addr & (CacheChunkBytes - 1)) >> LineShift];
+        if (!line)
+            line = allocate<Line>();
+
+        r = {line_addr, line};
+        return line;
     }
 
   public:
     /// Constructor
     AddrMap()
     {
-        recent[0] = recent[1] = chunkMap.end();
+        resetRecent();
     }
 
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap() { clear(); }
+
     Value &
     lookup(Addr addr)
     {
-        CacheChunk *chunk = getChunk(addr);
-        return chunk->items[chunkOffset(addr)];
+        return getLine(addr)->items[lineOffset(addr)];
+    }
+
+    /// Drop all entries and release their storage.
+    void
+    clear()
+    {
+        for (auto &dir_entry: dirMap) {
+            Directory *dir = dir_entry.second;
+            for (CacheChunk *chunk: dir->chunks) {
+                if (!chunk)
+                    continue;
+                for (Line *line: chunk->lines)
+                    delete line;
+                delete chunk;
+            }
+            delete dir;
+        }
+        dirMap.clear();
+        resetRecent();
+        _footprint = 0;
     }
+
+    /// Bytes of entry and page table storage currently allocated.
+    size_t footprint() const { return _footprint; }
 };
 
 } // namespace decode_cache
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "base/types.hh"
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+/** Entries are default-initialized and keep the values stored in them. */
+TEST(AddrMapTest, LookupStoresValues)
+{
+    decode_cache::AddrMap<int> map;
+
+    EXPECT_EQ(0, map.lookup(0x1000));
+    for (Addr addr = 0; addr < 0x40000; addr += 2)
+        map.lookup(addr) = addr;
+    for (Addr addr = 0; addr < 0x40000; addr += 2) {
+        EXPECT_EQ(addr, map.lookup(addr));
+        EXPECT_EQ(0, map.lookup(addr + 1));
+    }
+}
+
+/** Addresses far apart, or aliasing in the lookup caches, stay distinct. */
+TEST(AddrMapTest, SparseAddresses)
+{
+    decode_cache::AddrMap<int> map;
+    const Addr addrs[] = {
+        0x0, 0x40, 0x1000, 0x200000, 0x40000000, 0x8000'0000'0000,
+        0xffff'ffff'ffff'fffc,
+    };
+
+    int value = 1;
+    for (Addr addr : addrs)
+        map.lookup(addr) = value++;
+
+    value = 1;
+    for (Addr addr : addrs)
+        EXPECT_EQ(value++, map.lookup(addr));
+}
+
+/** Only touched parts of a page are allocated, and clear() frees them. */
+TEST(AddrMapTest, Footprint)
+{
+    decode_cache::AddrMap<uint64_t> map;
+    EXPECT_EQ(0, map.footprint());
+
+    map.lookup(0x1000) = 1;
+    const size_t one_line = map.footprint();
+    EXPECT_LT(one_line, 4096 * sizeof(uint64_t));
+
+    map.lookup(0x1008) = 2;
+    EXPECT_EQ(one_line, map.footprint());
+
+    map.lookup(0x1800) = 3;
+    EXPECT_GT(map.footprint(), one_line);
+
+    map.clear();
+    EXPECT_EQ(0, map.footprint());
+    EXPECT_EQ(0, map.lookup(0x1000));
+}
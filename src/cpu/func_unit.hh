@@ -34,9 +34,11 @@
 #include <string>
 #include <vector>
 
+#include "base/types.hh"
 #include "cpu/op_class.hh"
 #include "params/FUDesc.hh"
 #include "params/OpDesc.hh"
+#include "params/OpLatencyModel.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -65,16 +67,47 @@ namespace gem5
 //
 //
 
+/** A source operand as seen by an OpLatencyModel. */
+struct OpLatencySrc
+{
+    /** The low 64 bits of the operand. */
+    RegVal val = 0;
+    /** Whether val is known; registers of some classes have no value. */
+    bool valid = false;
+};
+
+/**
+ * Operand-value-dependent execution latency. A model is attached to an
+ * OpDesc and is asked, at issue, for the latency of an operation given
+ * the values of its source operands (e.g. an early-out divider or a
+ * floating-point unit with a denormal slow path).
+ */
+class OpLatencyModel : public SimObject
+{
+  public:
+    OpLatencyModel(const OpLatencyModelParams &p) : SimObject(p) {}
+
+    /**
+     * @param op_lat The operation's fixed latency (OpDesc::opLat).
+     * @param srcs Each source operand, indexed by source register index.
+     * @param num_srcs Number of source operands.
+     * @return The latency of the operation for these operand values.
+     */
+    virtual Cycles latency(Cycles op_lat, const OpLatencySrc *srcs,
+                           int num_srcs) const = 0;
+};
+
 class OpDesc : public SimObject
 {
   public:
     OpClass opClass;
     Cycles opLat;
     bool pipelined;
+    OpLatencyModel *valueLat;
 
     OpDesc(const OpDescParams &p)
         : SimObject(p), opClass(p.opClass), opLat(p.opLat),
-          pipelined(p.pipelined) {};
+          pipelined(p.pipelined), valueLat(p.valueLat) {};
 };
 
 class FUDesc : public SimObject
@@ -47,6 +47,7 @@ from m5.objects.FUPool import *
 from m5.objects.IndexingPolicies import *
 from m5.objects.IQUnit import *
 from m5.objects.CompSimplifier import *
+from m5.objects.MemoryRenamer import *
 from m5.objects.LoadValuePredictor import *
 from m5.objects.ReplacementPolicies import *
 from m5.objects.SMT import *
@@ -146,6 +147,12 @@ class BaseO3CPU(BaseCPU):
     LSQDepCheckShift = Param.Unsigned(
         4, "Number of places to shift addr before check"
     )
+    LSQAddrIndex = Param.Bool(
+        False,
+        "Index in-flight loads and stores by cache line to search for "
+        "forwarding stores and ordering violations without scanning the "
+        "whole LSQ. Results are identical to the linear search",
+    )
     LSQCheckLoads = Param.Bool(
         True,
         "Should dependency violations be checked for "
@@ -187,6 +194,17 @@ class BaseO3CPU(BaseCPU):
     # most ISAs don't use condition-code regs, so default is 0
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     instQueues = VectorParam.IQUnit(IQUnit(), "Vector of IQs")
+    iqSteeringPolicy = Param.IQSteeringPolicy(
+        "FirstFit",
+        "Policy choosing the IQ (cluster) an instruction is dispatched to: "
+        "the first IQ with a free entry, the least occupied IQ or the IQ "
+        "of the producer of an outstanding operand",
+    )
+    interClusterBypassLatency = Param.Cycles(
+        0,
+        "Extra cycles before a result wakes up consumers that were "
+        "dispatched to a different IQ than its producer",
+    )
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
@@ -215,7 +233,32 @@ class BaseO3CPU(BaseCPU):
         CompSimplifier(enabled=False),
         "Computation Simplifier",
     )
+    memoryRenamer = Param.MemoryRenamer(
+        MemoryRenamer(enabled=False),
+        "Memory renaming unit",
+    )
     needsTSO = Param.Bool(False, "Enable TSO Memory model")
+    dynInstPool = Param.Bool(
+        True,
+        "Recycle DynInst storage through a per-CPU slab pool. Disable to "
+        "debug memory errors with heap tools such as ASan or Valgrind",
+    )
+    moveElimination = Param.Bool(
+        False,
+        "Eliminate register moves at rename by mapping the destination onto "
+        "the source's physical register",
+    )
+    zeroIdiomElimination = Param.Bool(
+        False,
+        "Eliminate zero idioms at rename by zeroing the destination register",
+    )
+    skipStalledCycles = Param.Bool(
+        False,
+        "Deschedule the CPU while fetch is the only active stage and is "
+        "stalled on decode, until an event wakes it up. Timing and stats "
+        "are unchanged. Only single-threaded CPUs skip, and not while the "
+        "CommitStall probe has listeners",
+    )
 
     recvRespThrottling = Param.Bool(
         False, "Enable load receive response throttling in the LSQ"
@@ -235,6 +278,18 @@ class BaseO3CPU(BaseCPU):
         "Number of entries in the Fetch target queue. (only used for "
         "decoupled front-end)",
     )
+    ftqAdaptiveDepth = Param.Bool(
+        False,
+        "Adapt the FTQ run-ahead depth between ftqMinDepth and "
+        "numFTQEntries to the I-cache latency seen by fetch and the FTQ "
+        "occupancy",
+    )
+    ftqMinDepth = Param.Unsigned(
+        2, "Minimum FTQ run-ahead depth with ftqAdaptiveDepth"
+    )
+    ftqDepthEpoch = Param.Cycles(
+        1024, "Number of cycles between FTQ run-ahead depth adjustments"
+    )
     minInstSize = Param.Unsigned(
         1,
         "Minimum instruction size (bytes). Determines the granularity "
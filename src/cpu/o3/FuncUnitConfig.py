@@ -42,6 +42,51 @@ from m5.params import *
 from m5.SimObject import SimObject
 
 
+class LeadingZeroLatency(OpLatencyModel):
+    type = "LeadingZeroLatency"
+    cxx_header = "cpu/o3/fu_pool.hh"
+    cxx_class = "gem5::o3::LeadingZeroLatency"
+
+    operand = Param.Unsigned(
+        1, "source operand whose leading one sets the latency (the divisor)"
+    )
+    relativeTo = Param.Int(
+        -1,
+        "if non-negative, the work is the significant-bit difference "
+        "between this operand and 'operand' (quotient bits of an early-out "
+        "divider); otherwise it is the leading-zero count of 'operand'",
+    )
+    width = Param.Unsigned(64, "operand width in bits")
+    bitsPerCycle = Param.Unsigned(4, "bits of work retired per cycle")
+    minLat = Param.Cycles(2, "latency with no work; capped at opLat")
+
+
+class ZeroOperandLatency(OpLatencyModel):
+    type = "ZeroOperandLatency"
+    cxx_header = "cpu/o3/fu_pool.hh"
+    cxx_class = "gem5::o3::ZeroOperandLatency"
+
+    operands = VectorParam.Unsigned(
+        [], "source operands checked for zero; empty checks all of them"
+    )
+    width = Param.Unsigned(64, "operand width in bits")
+    zeroLat = Param.Cycles(1, "latency when a checked operand is zero")
+
+
+class DenormalLatency(OpLatencyModel):
+    type = "DenormalLatency"
+    cxx_header = "cpu/o3/fu_pool.hh"
+    cxx_class = "gem5::o3::DenormalLatency"
+
+    operands = VectorParam.Unsigned(
+        [], "source operands checked for subnormals; empty checks all of them"
+    )
+    fpBits = Param.Unsigned(64, "floating-point format width (16, 32, 64)")
+    penalty = Param.Cycles(
+        10, "extra latency when a checked operand is subnormal"
+    )
+
+
 class IntALU(FUDesc):
     opList = [OpDesc(opClass="IntAlu")]
     count = 6
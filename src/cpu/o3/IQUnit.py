@@ -43,6 +43,14 @@ from m5.proxy import Parent
 from m5.SimObject import SimObject
 
 
+class IssuePolicy(ScopedEnum):
+    vals = ["OldestFirst", "LoadFirst", "CriticalPath", "Random"]
+
+
+class IQSteeringPolicy(ScopedEnum):
+    vals = ["FirstFit", "LoadBalance", "Dependence"]
+
+
 class IQUnit(SimObject):
     type = "IQUnit"
     cxx_class = "gem5::o3::IQUnit"
@@ -58,3 +66,10 @@ class IQUnit(SimObject):
 
     smtIQPolicy = Param.SMTQueuePolicy("Partitioned", "SMT IQ Sharing Policy")
     smtIQThreshold = Param.Int(100, "SMT IQ Threshold Sharing Parameter")
+
+    issuePolicy = Param.IssuePolicy(
+        "OldestFirst",
+        "Policy selecting the next ready instruction to issue: oldest "
+        "first, loads first, instructions with waiting dependents first "
+        "or random",
+    )
@@ -2,6 +2,10 @@ from m5.params import *
 from m5.SimObject import SimObject
 
 
+class LVPMode(ScopedEnum):
+    vals = ["LastValue", "Stride", "TwoDeltaStride", "Context"]
+
+
 class LoadValuePredictor(SimObject):
     type = "LoadValuePredictor"
     cxx_class = "gem5::o3::LoadValuePredictor"
@@ -14,3 +18,25 @@ class LoadValuePredictor(SimObject):
     confidenceBits = Param.Unsigned(3, "Number of bits for the saturating "
                                     "confidence counter")
     enabled = Param.Bool(False, "Enable load value prediction")
+    mode = Param.LVPMode("LastValue", "Prediction scheme that drives "
+                         "value speculation")
+    evaluateAll = Param.Bool(False, "Also look up and train every other "
+                             "prediction scheme in the background so each "
+                             "reports its own coverage and accuracy")
+    selectiveReplay = Param.Bool(False, "Recover from value mispredictions "
+                                 "by re-executing only the dependents of "
+                                 "the load instead of squashing all younger "
+                                 "instructions")
+    predictFloatVec = Param.Bool(True, "Predict loads that write FP or "
+                                 "vector registers")
+    vecPredictBytes = Param.Unsigned(16, "Number of low-order bytes "
+                                     "predicted per vector register; the "
+                                     "remaining bytes are predicted as zero")
+    contextOrder = Param.Unsigned(4, "Number of previous values hashed "
+                                  "into the context predictor's index")
+    contextTableSize = Param.Unsigned(4096, "Number of entries in the "
+                                      "context predictor's value table "
+                                      "(must be a power of 2)")
+    contextMaxWalk = Param.Unsigned(4, "Maximum number of in-flight "
+                                    "instances of a load the context "
+                                    "predictor extrapolates over")
@@ -0,0 +1,25 @@
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class MemoryRenamer(SimObject):
+    type = "MemoryRenamer"
+    cxx_class = "gem5::o3::MemoryRenamer"
+    cxx_header = "cpu/o3/mem_rename.hh"
+
+    enabled = Param.Bool(False, "Enable memory renaming")
+    tableSize = Param.Unsigned(1024, "Number of entries in the store "
+                               "distance table (must be a power of 2)")
+    storeTableSize = Param.Unsigned(256, "Number of recently committed "
+                                    "stores tracked to train store "
+                                    "distances (must be a power of 2)")
+    maxDistance = Param.Unsigned(32, "Largest store distance that is "
+                                 "predicted")
+    confidenceBits = Param.Unsigned(2, "Number of bits for the saturating "
+                                    "confidence counter")
+    confidenceThreshold = Param.Unsigned(3, "Minimum confidence counter "
+                                         "value required to link a load")
+    selectiveReplay = Param.Bool(False, "Recover from wrong links by "
+                                 "re-executing only the dependents of "
+                                 "the load instead of squashing all younger "
+                                 "instructions")
@@ -102,6 +102,7 @@ BAC::BAC(CPU *_cpu, const BaseO3CPUParams &params)
     for (int i = 0; i < MaxThreads; i++) {
         bacPC[i].reset(params.isa[0]->newPCState());
         stalls[i] = {false, false, false};
+        btbBubbles[i] = 0;
     }
 }
 
@@ -153,6 +154,7 @@ BAC::clearStates(ThreadID tid)
     stalls[tid].fetch = false;
     stalls[tid].drain = false;
     stalls[tid].bpu = false;
+    btbBubbles[tid] = 0;
 
     assert(ftq != nullptr);
     ftq->resetState(tid);
@@ -494,6 +496,7 @@ BAC::squash(const PCStateBase &new_pc, ThreadID tid)
 
     // Set the new PC
     set(bacPC[tid], new_pc);
+    btbBubbles[tid] = 0;
 
     // Then squash all fetch targets
     ftq->squash(tid);
@@ -512,12 +515,21 @@ BAC::tick()
         // the branch predction unit.
 
         for (const ThreadID tid : *activeThreads) {
+            // Adjust the run-ahead depth before checking if the FTQ is full.
+            ftq->updateDepth(tid);
+
             // Check stall and squash signals first.
             status_change = status_change || checkSignalsAndUpdate(tid);
 
-            // Generate fetch targets if BAC is in running state
+            // Generate fetch targets if BAC is in running state. A hit
+            // in a slow BTB level delays the next fetch target.
             if (bacStatus[tid] == Running) {
-                generateFetchTargets(tid, status_change);
+                if (btbBubbles[tid] > 0) {
+                    btbBubbles[tid]--;
+                    stats.btbBubbles++;
+                } else {
+                    generateFetchTargets(tid, status_change);
+                }
                 activity = true;
             }
             stats.status[bacStatus[tid]]++;
@@ -550,6 +562,81 @@ BAC::tick()
     }
 }
 
+bool
+BAC::canSkipCycles()
+{
+    if (!decoupledFrontEnd) {
+        return true;
+    }
+
+    for (const ThreadID tid : *activeThreads) {
+        if (stalls[tid].drain) {
+            return false;
+        }
+
+        // Mirror checkSignalsAndUpdate(): the status must not change.
+        const bool stalled = checkStall(tid);
+        switch (bacStatus[tid]) {
+          case Blocked:
+            if (!stalled) {
+                return false;
+            }
+            break;
+          case Idle:
+            if (stalled || ftq->isReady(tid) || ftq->isFull(tid)) {
+                return false;
+            }
+            break;
+          case FTQFull:
+            if (stalled || !ftq->isReady(tid) || !ftq->isFull(tid)) {
+                return false;
+            }
+            break;
+          case FTQLocked:
+            if (stalled || !ftq->isLocked(tid) || ftq->isFull(tid)) {
+                return false;
+            }
+            break;
+          default:
+            return false;
+        }
+    }
+
+    // A depth change can unblock the BAC, so the epoch end must be ticked.
+    const Cycles next_update = nextDepthUpdate();
+    return next_update == 0 || next_update > cpu->curCycle() + 1;
+}
+
+void
+BAC::skipCycles(Cycles cycles)
+{
+    if (!decoupledFrontEnd) {
+        return;
+    }
+
+    for (const ThreadID tid : *activeThreads) {
+        ftq->skipCycles(tid, cycles);
+        stats.status[bacStatus[tid]] += cycles;
+    }
+}
+
+Cycles
+BAC::nextDepthUpdate() const
+{
+    Cycles next_update(0);
+    if (!decoupledFrontEnd) {
+        return next_update;
+    }
+
+    for (const ThreadID tid : *activeThreads) {
+        const Cycles epoch_end = ftq->depthEpochEnd(tid);
+        if (next_update == 0 || epoch_end < next_update) {
+            next_update = epoch_end;
+        }
+    }
+    return next_update;
+}
+
 FetchTargetPtr
 BAC::newFetchTarget(ThreadID tid, const PCStateBase &start_pc)
 {
@@ -630,6 +717,7 @@ BAC::generateFetchTargets(ThreadID tid, bool &status_change)
 
         bool branch_found = false;
         bool predict_taken = false;
+        unsigned bubbles = 0;
 
         // Scan through the instruction stream and search for branches.
         // The BTB contains only branches where taken at least once.
@@ -673,6 +761,10 @@ BAC::generateFetchTargets(ThreadID tid, bool &status_change)
             staticInst = bpu->BTBGetInst(tid, cur_pc.instAddr());
             assert(staticInst);
 
+            // Query the hit latency before predicting since the lookup
+            // moves the entry into the fastest BTB level.
+            bubbles = bpu->BTBHitLatency(tid, cur_pc.instAddr());
+
             // Now make the actual prediction. Note the BPU will advance
             // the PC to the next instruction.
             predict_taken = predict(tid, staticInst, curFT, *next_pc);
@@ -754,6 +846,15 @@ BAC::generateFetchTargets(ThreadID tid, bool &status_change)
             status_change = true;
             break;
         }
+
+        // A branch provided by a slower BTB level cannot redirect the
+        // search within this cycle. Stall for the remaining latency.
+        if (bubbles > 0) {
+            DPRINTF(BAC, "[tid:%i] BTB hit latency, %i bubble(s)\n",
+                    tid, bubbles);
+            btbBubbles[tid] = bubbles;
+            break;
+        }
     }
     stats.ftNumber.sample(num_ft);
 }
@@ -868,12 +969,11 @@ BAC::updatePreDecode(ThreadID tid, const InstSeqNum seqNum,
         // FDP we use "taken" history where not taken branches don't modify
         // the global history.
 
-        hist =
-            new BPredUnit::PredictorHistory(tid, seqNum, pc.instAddr(), inst);
+        hist = bpu->allocHistory(tid, seqNum, pc.instAddr(), inst);
         bpu->branchPlaceholder(tid, pc.instAddr(), inst->isUncondCtrl(),
                                hist->bpHistory);
 
-        set(hist->target, std::unique_ptr<PCStateBase>(pc.clone()));
+        set(hist->target, pc);
         inst->advancePC(*hist->target);
     }
 
@@ -983,6 +1083,8 @@ BAC::BACStats::BACStats(o3::CPU *cpu, BAC *bac)
       ADD_STAT(branchesNotLastuOp, statistics::units::Count::get(),
                "Number of branches that fetch encountered which are not the "
                "last uOp within a macrooperation. Jump to itself."),
+      ADD_STAT(btbBubbles, statistics::units::Cycle::get(),
+               "Number of cycles BAC stalled due to slow BTB hits"),
       ADD_STAT(branchMisspredict, statistics::units::Count::get(),
                "Number of mispredicted branches"),
       ADD_STAT(noBranchMisspredict, statistics::units::Count::get(),
@@ -184,6 +184,22 @@ class BAC
     /** Process all input signals and create the next fetch target. */
     void tick();
 
+    /**
+     * Would a tick leave the stage unchanged apart from its per-cycle
+     * statistics? True when every thread waits on a full, locked or
+     * invalid FTQ or on a stall, and no run-ahead depth update is due
+     * in the next cycle.
+     */
+    bool canSkipCycles();
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
+    /** The next cycle in which the FTQ adapts its run-ahead depth, or 0
+     * if the depth does not adapt. */
+    Cycles nextDepthUpdate() const;
+
   private:
     /** Reset this pipeline stage */
     void resetStage();
@@ -376,6 +392,10 @@ class BAC
     /** Tracks which stages are telling the ftq to stall. */
     Stalls stalls[MaxThreads];
 
+    /** Remaining bubble cycles before the next fetch target can be
+     * generated, caused by a hit in a slower level of the BTB. */
+    unsigned btbBubbles[MaxThreads];
+
     /** Enables the decoupled front-end */
     const bool decoupledFrontEnd;
 
@@ -441,6 +461,8 @@ class BAC
         statistics::Scalar predTakenBranches;
         /** Total number of fetched branches. */
         statistics::Scalar branchesNotLastuOp;
+        /** Total number of cycles lost to slow BTB hits. */
+        statistics::Scalar btbBubbles;
 
         /** Stat for total number of misspredicted instructions. */
         statistics::Scalar branchMisspredict;
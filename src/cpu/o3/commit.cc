@@ -116,7 +116,8 @@ Commit::Commit(CPU *_cpu, const BaseO3CPUParams &params)
       trapLatency(params.trapLatency),
       canHandleInterrupts(true),
       avoidQuiesceLiveLock(false),
-      stats(_cpu, this)
+      stats(_cpu, this),
+      cpiStack(&stats, _cpu, numThreads)
 {
     if (commitWidth > MaxWidth)
         fatal("commitWidth (%d) is larger than compiled limit (%d),\n"
@@ -127,6 +128,7 @@ Commit::Commit(CPU *_cpu, const BaseO3CPUParams &params)
     _nextStatus = Inactive;
 
     lvp = params.loadValuePredictor;
+    memRenamer = params.memoryRenamer;
 
     if (commitPolicy == CommitPolicy::RoundRobin) {
         //Set-Up Priority List
@@ -270,6 +272,12 @@ Commit::setIEWStage(IEW *iew_stage)
     iewStage = iew_stage;
 }
 
+void
+Commit::setFetchStage(Fetch *fetch_stage)
+{
+    fetchStage = fetch_stage;
+}
+
 void
 Commit::setActiveThreads(std::list<ThreadID> *at_ptr)
 {
@@ -519,6 +527,8 @@ Commit::squashAll(ThreadID tid)
     rob->squash(squashed_inst, tid);
     changedROBNumEntries[tid] = true;
 
+    cpiStack.squash(tid, CPIStack::Squash, squashed_inst);
+
     // Send back the sequence number of the squashed instruction.
     toIEW->commitInfo[tid].doneSeqNum = squashed_inst;
 
@@ -604,8 +614,10 @@ Commit::tick()
     wroteToTimeBuffer = false;
     _nextStatus = Inactive;
 
-    if (activeThreads->empty())
+    if (activeThreads->empty()) {
+        accountCycle();
         return;
+    }
 
     // Check if any of the threads are done squashing.  Change the
     // status if they are done.
@@ -664,9 +676,50 @@ Commit::tick()
         cpu->activityThisCycle();
     }
 
+    accountCycle();
+
     updateStatus();
 }
 
+bool
+Commit::canSkipCycles()
+{
+    if (interrupt != NoFault || (FullSystem && cpu->checkInterrupts(0))) {
+        return false;
+    }
+
+    // A stalled ROB head is notified to the CommitStall listeners every
+    // cycle, at that cycle's tick, so those cycles have to be ticked.
+    if (ppCommitStall->hasListeners()) {
+        return false;
+    }
+
+    for (ThreadID tid : *activeThreads) {
+        if ((commitStatus[tid] != Running && commitStatus[tid] != Idle) ||
+            trapSquash[tid] || tcSquash[tid] || changedROBNumEntries[tid]) {
+            return false;
+        }
+
+        // Nothing to retire, and an empty ROB has already been reported.
+        if (rob->isEmpty(tid) ? checkEmptyROB[tid] :
+            rob->readHeadInst(tid)->readyToCommit()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+Commit::skipCycles(Cycles cycles)
+{
+    for (ThreadID tid : *activeThreads) {
+        stats.status[commitStatus[tid]] += cycles;
+    }
+
+    stats.numCommittedDist.sample(0, cycles);
+    cpiStack.chargeStalled(cycles);
+}
+
 void
 Commit::handleInterrupt()
 {
@@ -822,6 +875,17 @@ Commit::commit()
             rob->squash(squashed_inst, tid);
             changedROBNumEntries[tid] = true;
 
+            if (fromIEW->mispredictInst[tid]) {
+                cpiStack.squash(tid, CPIStack::BranchMispredict,
+                                squashed_inst);
+            } else if (fromIEW->includeSquashInst[tid]) {
+                cpiStack.squash(tid, CPIStack::MemOrderViolation,
+                                squashed_inst);
+            } else {
+                cpiStack.squash(tid, CPIStack::ValueMispredict,
+                                squashed_inst);
+            }
+
             toIEW->commitInfo[tid].doneSeqNum = squashed_inst;
 
             toIEW->commitInfo[tid].squash = true;
@@ -987,6 +1051,10 @@ Commit::commitInsts()
 
             if (commit_success) {
                 ++num_committed;
+                if (head_inst->dcacheMiss) {
+                    cpiStack.dcacheMiss(tid, head_inst->seqNum);
+                }
+                cpiStack.retire(tid, head_inst->seqNum);
                 cpu->commitStats[tid]
                     ->committedInstType[head_inst->opClass()]++;
                 stats.committedInstType[tid][head_inst->opClass()]++;
@@ -995,16 +1063,19 @@ Commit::commitInsts()
                 // Load Value Prediction: train the predictor with the
                 // actual committed value and clean up history.
                 if (head_inst->isLoad() && lvp &&
-                    lvp->isEnabled() &&
-                    head_inst->numDestRegs() == 1) {
-                    PhysRegIdPtr destReg = head_inst->renamedDestIdx(0);
-                    if (destReg->classValue() == IntRegClass &&
-                        !destReg->isAlwaysReady()) {
-                        Addr pc = head_inst->pcState().instAddr();
-                        RegVal actualValue = cpu->getReg(destReg, tid);
-                        lvp->update(pc, actualValue);
-                        lvp->commitEntry(head_inst->seqNum, tid);
-                    }
+                    lvp->isEnabled() && lvp->numValueWords(head_inst)) {
+                    Addr pc = head_inst->pcState().instAddr();
+                    LVPValue actualValue;
+                    lvp->readDestRegs(head_inst, cpu, actualValue);
+                    lvp->update(head_inst->seqNum, tid, pc,
+                                head_inst->isDataIndependentTiming(),
+                                actualValue);
+                }
+
+                // Memory renaming: train store distances.
+                if (memRenamer && (head_inst->isMemRef() ||
+                                   head_inst->isAtomic())) {
+                    memRenamer->commit(head_inst, cpu);
                 }
 
                 // hardware transactional memory
@@ -1436,6 +1507,80 @@ Commit::updateComInstStats(const DynInstPtr &inst)
     }
 }
 
+CPIStack::Category
+Commit::cycleCategory(ThreadID tid)
+{
+    if (cpiStack.retired(tid))
+        return CPIStack::Base;
+
+    // Nothing to retire because the window is empty or being cleared:
+    // blame a squash being recovered from, or else the frontend.
+    if (rob->isEmpty(tid) || commitStatus[tid] == ROBSquashing ||
+        rob->readHeadInst(tid)->isSquashed()) {
+        CPIStack::Category cause = cpiStack.recovering(tid);
+        if (cause != CPIStack::NumCategories)
+            return cause;
+
+        switch (fetchStage->threadStatus(tid)) {
+          case Fetch::ItlbWait:
+          case Fetch::IcacheWaitResponse:
+          case Fetch::IcacheWaitRetry:
+            return CPIStack::ICacheMiss;
+          case Fetch::FtqWait:
+            return CPIStack::FTQEmpty;
+          default:
+            return CPIStack::Frontend;
+        }
+    }
+
+    // Otherwise the head of the ROB is holding up retirement.
+    const DynInstPtr &head_inst = rob->readHeadInst(tid);
+
+    if (commitStatus[tid] == TrapPending ||
+        (head_inst->isNonSpeculative() && !head_inst->isIssued())) {
+        return CPIStack::Serialize;
+    } else if (head_inst->readyToCommit()) {
+        // Completed too late in the cycle to retire: commit latency
+        return CPIStack::Base;
+    } else if (head_inst->replayDoneTick > curTick()) {
+        // Recovering from a value misprediction by selective replay
+        return CPIStack::ValueMispredict;
+    } else if (head_inst->isMemRef()) {
+        return head_inst->dcacheMiss ? CPIStack::DCacheMiss :
+                                       CPIStack::Memory;
+    } else if (rob->isFull(tid)) {
+        // The window filled up behind a long latency instruction
+        return CPIStack::ROBFull;
+    } else if (!head_inst->isIssued() && head_inst->readyToIssue()) {
+        return CPIStack::FUContention;
+    } else {
+        return CPIStack::Execute;
+    }
+}
+
+void
+Commit::accountCycle()
+{
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        bool active = std::find(activeThreads->begin(), activeThreads->end(),
+                                tid) != activeThreads->end();
+        if (!active) {
+            cpiStack.charge(tid, CPIStack::Idle);
+            continue;
+        }
+
+        const CPIStack::Category category = cycleCategory(tid);
+        if (category == CPIStack::Memory) {
+            cpiStack.chargeMemory(tid, rob->readHeadInst(tid)->seqNum);
+        } else {
+            if (category == CPIStack::DCacheMiss) {
+                cpiStack.dcacheMiss(tid, rob->readHeadInst(tid)->seqNum);
+            }
+            cpiStack.charge(tid, category);
+        }
+    }
+}
+
 ////////////////////////////////////////
 //                                    //
 //  SMT COMMIT POLICY MAINTAINED HERE //
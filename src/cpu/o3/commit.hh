@@ -47,6 +47,7 @@
 #include "cpu/exetrace.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/comm.hh"
+#include "cpu/o3/cpi_stack.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
@@ -64,6 +65,7 @@ struct BaseO3CPUParams;
 namespace o3
 {
 
+class Fetch;
 class ThreadState;
 
 /**
@@ -158,6 +160,14 @@ class Commit
     /** Sets the pointer to the IEW stage. */
     void setIEWStage(IEW *iew_stage);
 
+    /** Sets the pointer to the fetch stage. */
+    void setFetchStage(Fetch *fetch_stage);
+
+    /** The pointer to the fetch stage. Used only to tell apart frontend
+     * stalls in the CPI stack.
+     */
+    Fetch *fetchStage;
+
     /** The pointer to the IEW stage. Used solely to ensure that
      * various events (traps, interrupts, syscalls) do not occur until
      * all stores have written back.
@@ -206,6 +216,15 @@ class Commit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Would a tick leave commit unchanged apart from its per-cycle
+     * statistics? Never true while the CommitStall probe has
+     * listeners. */
+    bool canSkipCycles();
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -349,6 +368,9 @@ class Commit
     /** Load value predictor (nullptr if disabled). */
     LoadValuePredictor *lvp;
 
+    /** Memory renaming unit (nullptr if disabled). */
+    MemoryRenamer *memRenamer;
+
     /** Vector of all of the threads. */
     std::vector<ThreadState *> thread;
 
@@ -461,6 +483,12 @@ class Commit
     /** Updates commit stats based on this instruction. */
     void updateComInstStats(const DynInstPtr &inst);
 
+    /** Picks the CPI stack category of the current cycle of a thread. */
+    CPIStack::Category cycleCategory(ThreadID tid);
+
+    /** Charges the current cycle of every thread to the CPI stack. */
+    void accountCycle();
+
     // HTM
     int htmStarts[MaxThreads];
     int htmStops[MaxThreads];
@@ -499,6 +527,12 @@ class Commit
         /** Number of cycles where the commit bandwidth limit is reached. */
         statistics::Scalar commitEligibleSamples;
     } stats;
+
+  public:
+    /** Top-down cycle accounting, also charged by the CPU for the
+     * cycles it sleeps through.
+     */
+    CPIStack cpiStack;
 };
 
 } // namespace o3
@@ -88,6 +88,21 @@ CompSimplifier::trySimplify(const DynInstPtr &inst, CPU *cpu, RegVal &result)
     RegVal src0 = cpu->getReg(inst->renamedSrcIdx(intSrcIndices[0]), tid);
     RegVal src1 = cpu->getReg(inst->renamedSrcIdx(intSrcIndices[1]), tid);
 
+    // Under data-independent timing the FU latency must not depend on the
+    // operand values, so a trivial operand may not bypass the unit.
+    if (inst->isDataIndependentTiming()) {
+        bool trivial = op_class == IntMultOp ?
+            src0 == 0 || src1 == 0 || src0 == 1 || src1 == 1 :
+            (src0 == 0 && src1 != 0) || src1 == 1;
+        if (trivial) {
+            ++stats.ditSuppressed;
+            DPRINTF(CompSimp, "Not simplifying [sn:%llu] PC %s: "
+                    "data-independent timing\n",
+                    inst->seqNum, inst->pcState());
+        }
+        return false;
+    }
+
     if (op_class == IntMultOp) {
         if (src0 == 0 || src1 == 0) {
             result = 0;
@@ -157,7 +172,10 @@ CompSimplifier::CompSimplifierStats::CompSimplifierStats(CompSimplifier *cs)
       ADD_STAT(divOfZero, statistics::units::Count::get(),
                "Number of zero-divided-by-x simplifications"),
       ADD_STAT(divByOne, statistics::units::Count::get(),
-               "Number of divide-by-one simplifications")
+               "Number of divide-by-one simplifications"),
+      ADD_STAT(ditSuppressed, statistics::units::Count::get(),
+               "Number of simplifications suppressed by data-independent "
+               "timing")
 {
     coverage.precision(6);
 }
@@ -55,6 +55,9 @@ class CPU;
  * This is NOT speculative — source operands are definitively ready in the
  * register file, so results are guaranteed correct.
  *
+ * Instructions executing under data-independent timing (Arm PSTATE.DIT)
+ * are never simplified, as that would make their latency data dependent.
+ *
  * Integration points:
  *  - Check & store result in scheduleReadyInsts() (inst_queue.cc)
  *  - Write result in executeInsts() (iew.cc)
@@ -97,6 +100,7 @@ class CompSimplifier : public SimObject
         statistics::Scalar multByOne;
         statistics::Scalar divOfZero;
         statistics::Scalar divByOne;
+        statistics::Scalar ditSuppressed;
     } stats;
 };
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/o3/cpi_stack.hh"
+
+#include "base/cprintf.hh"
+#include "cpu/base.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+CPIStack::CPIStack(statistics::Group *parent, BaseCPU *cpu,
+                   ThreadID num_threads)
+    : statistics::Group(parent, "cpiStack"),
+      threads(num_threads)
+{
+    for (ThreadID tid = 0; tid < num_threads; tid++)
+        threadStats.emplace_back(new ThreadStats(this, cpu, tid));
+}
+
+void
+CPIStack::retire(ThreadID tid, InstSeqNum seq_num)
+{
+    ThreadInfo &thread = threads[tid];
+    thread.retired = true;
+    if (thread.cause != NumCategories && seq_num > thread.squashSeqNum)
+        thread.cause = NumCategories;
+}
+
+void
+CPIStack::squash(ThreadID tid, Category cause, InstSeqNum seq_num)
+{
+    ThreadInfo &thread = threads[tid];
+    // An older squash point wins, as it discards more of the window.
+    if (thread.cause == NumCategories || seq_num <= thread.squashSeqNum) {
+        thread.cause = cause;
+        thread.squashSeqNum = seq_num;
+    }
+}
+
+void
+CPIStack::charge(ThreadID tid, Category category)
+{
+    assert(category < NumCategories);
+    threadStats[tid]->cycles[category]++;
+    threads[tid].last = category;
+    threads[tid].retired = false;
+}
+
+void
+CPIStack::chargeMemory(ThreadID tid, InstSeqNum seq_num)
+{
+    ThreadInfo &thread = threads[tid];
+    if (thread.memSeqNum != seq_num) {
+        thread.memSeqNum = seq_num;
+        thread.memCycles = Cycles(0);
+    }
+    ++thread.memCycles;
+    charge(tid, Memory);
+}
+
+void
+CPIStack::dcacheMiss(ThreadID tid, InstSeqNum seq_num)
+{
+    ThreadInfo &thread = threads[tid];
+    if (thread.memSeqNum != seq_num || thread.memCycles == 0)
+        return;
+
+    threadStats[tid]->cycles[Memory] -= thread.memCycles;
+    threadStats[tid]->cycles[DCacheMiss] += thread.memCycles;
+    thread.memCycles = Cycles(0);
+    if (thread.last == Memory)
+        thread.last = DCacheMiss;
+}
+
+void
+CPIStack::chargeIdle(Cycles cycles)
+{
+    for (ThreadID tid = 0; tid < threads.size(); tid++) {
+        threadStats[tid]->cycles[Idle] += cycles;
+        threads[tid].last = Idle;
+    }
+}
+
+void
+CPIStack::chargeStalled(Cycles cycles)
+{
+    for (ThreadID tid = 0; tid < threads.size(); tid++) {
+        threadStats[tid]->cycles[threads[tid].last] += cycles;
+        if (threads[tid].last == Memory)
+            threads[tid].memCycles += cycles;
+    }
+}
+
+CPIStack::ThreadStats::ThreadStats(statistics::Group *parent, BaseCPU *cpu,
+                                   ThreadID tid)
+    : statistics::Group(parent, csprintf("thread%i", tid).c_str()),
+      ADD_STAT(cycles, statistics::units::Cycle::get(),
+               "Cycles charged to each top-down category"),
+      ADD_STAT(cpi, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "CPI contributed by each top-down category")
+{
+    cycles
+        .init(NumCategories)
+        .subname(Base, "base")
+        .subname(Idle, "idle")
+        .subname(ICacheMiss, "icacheMiss")
+        .subname(FTQEmpty, "ftqEmpty")
+        .subname(Frontend, "frontend")
+        .subname(BranchMispredict, "branchMispredict")
+        .subname(ValueMispredict, "valueMispredict")
+        .subname(MemOrderViolation, "memOrderViolation")
+        .subname(Squash, "squash")
+        .subname(DCacheMiss, "dcacheMiss")
+        .subname(Memory, "memory")
+        .subname(ROBFull, "robFull")
+        .subname(FUContention, "fuContention")
+        .subname(Execute, "execute")
+        .subname(Serialize, "serialize")
+        .flags(statistics::total | statistics::pdf);
+
+    cpi = cycles / cpu->commitStats[tid]->numInsts;
+    cpi.flags(statistics::total);
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_O3_CPI_STACK_HH__
+#define __CPU_O3_CPI_STACK_HH__
+
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+
+namespace o3
+{
+
+/**
+ * Top-down cycle accounting, attributed at commit. Every cycle each
+ * hardware thread is charged to exactly one category: cycles in which
+ * the thread retires an instruction are base cycles, and all others are
+ * blamed on whatever keeps its ROB head from retiring. Cycles spent
+ * refilling the pipeline after a squash are charged to the squash cause
+ * until an instruction younger than the squash point retires. Cycles
+ * the CPU spends descheduled are charged as well, so the categories of
+ * every thread add up to numCycles.
+ *
+ * Whether a load at the ROB head missed in the D-cache is only known
+ * once its response arrives. Until then its cycles are charged to
+ * Memory, and they are moved to DCacheMiss if the access turns out to
+ * have missed.
+ */
+class CPIStack : public statistics::Group
+{
+  public:
+    enum Category
+    {
+        Base,
+        Idle,
+        ICacheMiss,
+        FTQEmpty,
+        Frontend,
+        BranchMispredict,
+        ValueMispredict,
+        MemOrderViolation,
+        Squash,
+        DCacheMiss,
+        Memory,
+        ROBFull,
+        FUContention,
+        Execute,
+        Serialize,
+        NumCategories
+    };
+
+    CPIStack(statistics::Group *parent, BaseCPU *cpu, ThreadID num_threads);
+
+    /** Records that a thread retired an instruction this cycle. */
+    void retire(ThreadID tid, InstSeqNum seq_num);
+
+    /**
+     * Records a squash of everything younger than seq_num. The thread is
+     * recovering from it until a younger instruction retires.
+     */
+    void squash(ThreadID tid, Category cause, InstSeqNum seq_num);
+
+    /** Returns whether the thread retired an instruction this cycle. */
+    bool retired(ThreadID tid) const { return threads[tid].retired; }
+
+    /** Returns the pending squash cause, or NumCategories if none. */
+    Category recovering(ThreadID tid) const { return threads[tid].cause; }
+
+    /** Charges the current cycle of a thread and starts the next one. */
+    void charge(ThreadID tid, Category category);
+
+    /**
+     * Charges the current cycle of a thread to Memory on behalf of the
+     * memory access at its ROB head, whose D-cache outcome is not known
+     * yet.
+     */
+    void chargeMemory(ThreadID tid, InstSeqNum seq_num);
+
+    /**
+     * Records that the memory access of an instruction missed in the
+     * D-cache, moving the cycles it was charged to Memory to DCacheMiss.
+     */
+    void dcacheMiss(ThreadID tid, InstSeqNum seq_num);
+
+    /** Charges cycles the CPU slept through with nothing to do. */
+    void chargeIdle(Cycles cycles);
+
+    /**
+     * Charges cycles skipped while the CPU waited on a stall to each
+     * thread's last category, since the stall persisted through them.
+     */
+    void chargeStalled(Cycles cycles);
+
+  private:
+    struct ThreadStats : public statistics::Group
+    {
+        ThreadStats(statistics::Group *parent, BaseCPU *cpu, ThreadID tid);
+
+        /** Cycles charged to each category. */
+        statistics::Vector cycles;
+        /** Contribution of each category to the thread's CPI. */
+        statistics::Formula cpi;
+    };
+
+    struct ThreadInfo
+    {
+        /** An instruction retired in the current cycle. */
+        bool retired = false;
+        /** Category of the last charged cycle. */
+        Category last = Idle;
+        /** Cause of the squash being recovered from. */
+        Category cause = NumCategories;
+        /** Youngest instruction that survived that squash. */
+        InstSeqNum squashSeqNum = 0;
+        /** Memory access at the ROB head charged to Memory so far. */
+        InstSeqNum memSeqNum = 0;
+        /** Cycles charged to Memory for that access. */
+        Cycles memCycles = Cycles(0);
+    };
+
+    std::vector<ThreadInfo> threads;
+
+    std::vector<std::unique_ptr<ThreadStats>> threadStats;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_CPI_STACK_HH__
@@ -79,6 +79,9 @@ CPU::CPU(const BaseO3CPUParams &params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      instPoolStats(this),
+      instPool(params.dynInstPool ? new DynInstPool(&instPoolStats) :
+                                    nullptr),
       removeInstsThisCycle(false),
       bac(this, params),
       ftq(this, params),
@@ -113,6 +116,7 @@ CPU::CPU(const BaseO3CPUParams &params)
       globalFTSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
+      skipStalledCycles(params.skipStalledCycles),
       cpuStats(this)
 {
     fatal_if(FullSystem && params.numThreads > 1,
@@ -122,6 +126,11 @@ CPU::CPU(const BaseO3CPUParams &params)
             "More workload items (%d) than threads (%d) on CPU %s.",
             params.workload.size(), params.numThreads, name());
 
+    // Instructions still in the front end are in flight too, so this list
+    // can grow past the ROB size; it does so only up to its high-water
+    // mark.
+    instList.reserve(params.numROBEntries);
+
     if (!params.switched_out) {
         _status = Running;
     } else {
@@ -177,6 +186,7 @@ CPU::CPU(const BaseO3CPUParams &params)
     commit.setRenameQueue(&renameQueue);
 
     commit.setIEWStage(&iew);
+    commit.setFetchStage(&fetch);
     rename.setIEWStage(&iew);
     rename.setCommitStage(&commit);
 
@@ -322,6 +332,14 @@ CPU::CPU(const BaseO3CPUParams &params)
     }
 }
 
+CPU::~CPU()
+{
+    // DynInsts still referenced elsewhere keep the pool alive until they
+    // are freed.
+    if (instPool)
+        instPool->release();
+}
+
 void
 CPU::regProbePoints()
 {
@@ -351,7 +369,13 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(stallSkips, statistics::units::Count::get(),
+               "Number of times that the CPU unscheduled itself while only "
+               "the stalled front-end was active"),
+      ADD_STAT(skippedStallCycles, statistics::units::Cycle::get(),
+               "Total number of cycles that the CPU has skipped while the "
+               "front-end was stalled")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -362,6 +386,12 @@ CPU::CPUStats::CPUStats(CPU *cpu)
 
     quiesceCycles
         .prereq(quiesceCycles);
+
+    stallSkips
+        .prereq(stallSkips);
+
+    skippedStallCycles
+        .prereq(skippedStallCycles);
 }
 
 void
@@ -371,6 +401,8 @@ CPU::tick()
     assert(!switchedOut());
     assert(drainState() != DrainState::Drained);
 
+    endStallSkip();
+
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -412,6 +444,18 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (skipStalledCycles && frontEndStalled()) {
+            DPRINTF(O3CPU, "Front-end stalled, waiting for a wakeup!\n");
+            lastRunningCycle = curCycle();
+            skippingStall = true;
+            cpuStats.stallSkips++;
+
+            // The end of an FTQ depth epoch has to be ticked.
+            const Cycles depth_update = bac.nextDepthUpdate();
+            if (depth_update != 0) {
+                schedule(tickEvent,
+                         clockEdge(Cycles(depth_update - curCycle())));
+            }
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -564,6 +608,7 @@ CPU::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    endStallSkip();
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -585,6 +630,7 @@ CPU::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Halt Context called. Deallocating\n", tid);
     assert(!switchedOut());
 
+    endStallSkip();
     deactivateThread(tid);
     removeThread(tid);
 
@@ -1109,20 +1155,48 @@ CPU::getWritableArchReg(const RegId &reg, ThreadID tid)
     return regFile.getWritableReg(phys_reg);
 }
 
+PhysRegIdPtr
+CPU::archRegForWrite(const RegId &flat, ThreadID tid)
+{
+    PhysRegIdPtr phys_reg = commitRenameMap[tid].lookup(flat);
+    if (!flat.isRenameable() || freeList.numSharers(phys_reg) == 0)
+        return phys_reg;
+
+    panic_if(!freeList.hasFreeRegs(flat.classValue()),
+             "No free %s register to unshare arch reg %i.",
+             flat.className(), flat.index());
+
+    PhysRegIdPtr new_reg = freeList.getReg(flat.classValue());
+    DPRINTF(O3CPU, "Unsharing arch reg %i (%s) from phys reg %i, now "
+            "phys reg %i\n", flat.index(), flat.className(),
+            phys_reg->flatIndex(), new_reg->flatIndex());
+
+    // Younger in-flight renames of the register keep their mapping but
+    // now release the private register when they commit.
+    if (renameMap[tid].lookup(flat) == phys_reg)
+        renameMap[tid].setEntry(flat, new_reg);
+    else
+        rename.replacePrevReg(flat, phys_reg, new_reg, tid);
+
+    commitRenameMap[tid].setEntry(flat, new_reg);
+    scoreboard.setReg(new_reg);
+    freeList.addReg(phys_reg);
+
+    return new_reg;
+}
+
 void
 CPU::setArchReg(const RegId &reg, RegVal val, ThreadID tid)
 {
     const RegId flat = reg.flatten(*isa[tid]);
-    PhysRegIdPtr phys_reg = commitRenameMap[tid].lookup(flat);
-    regFile.setReg(phys_reg, val);
+    regFile.setReg(archRegForWrite(flat, tid), val);
 }
 
 void
 CPU::setArchReg(const RegId &reg, const void *val, ThreadID tid)
 {
     const RegId flat = reg.flatten(*isa[tid]);
-    PhysRegIdPtr phys_reg = commitRenameMap[tid].lookup(flat);
-    regFile.setReg(phys_reg, val);
+    regFile.setReg(archRegForWrite(flat, tid), val);
 }
 
 const PCStateBase &
@@ -1332,9 +1406,58 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::frontEndStalled()
+{
+    return activityRec.getActivityCount() == 1 &&
+           activityRec.getStageActive(FetchIdx) &&
+           drainState() != DrainState::Draining &&
+           fetch.stalledOnDecode() && bac.canSkipCycles() &&
+           decode.canSkipCycles() && rename.canSkipCycles() &&
+           iew.canSkipCycles() && commit.canSkipCycles();
+}
+
+void
+CPU::endStallSkip()
+{
+    if (!skippingStall) {
+        return;
+    }
+    skippingStall = false;
+
+    // The stages did not change in the skipped cycles, so account them
+    // as if each cycle had been ticked.
+    if (curCycle() > lastRunningCycle + 1) {
+        const Cycles cycles(curCycle() - lastRunningCycle - 1);
+        DPRINTF(O3CPU, "Accounting %d skipped stall cycles\n", cycles);
+
+        cpuStats.skippedStallCycles += cycles;
+        baseStats.numCycles += cycles;
+
+        bac.skipCycles(cycles);
+        fetch.skipCycles(cycles);
+        decode.skipCycles(cycles);
+        rename.skipCycles(cycles);
+        iew.skipCycles(cycles);
+        commit.skipCycles(cycles);
+    }
+}
+
 void
 CPU::wakeCPU()
 {
+    if (skippingStall) {
+        // The tick may already be scheduled for an FTQ depth update.
+        if (!tickEvent.scheduled()) {
+            DPRINTF(Activity, "Waking up CPU from a front-end stall\n");
+            schedule(tickEvent, clockEdge());
+        } else if (tickEvent.when() > clockEdge()) {
+            DPRINTF(Activity, "Waking up CPU from a front-end stall\n");
+            reschedule(tickEvent, clockEdge());
+        }
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1348,6 +1471,7 @@ CPU::wakeCPU()
         --cycles;
         cpuStats.idleCycles += cycles;
         baseStats.numCycles += cycles;
+        commit.cpiStack.chargeIdle(cycles);
     }
 
     schedule(tickEvent, clockEdge());
@@ -1356,6 +1480,12 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    // Commit has to see a posted interrupt.
+    if (skippingStall) {
+        wakeCPU();
+        return;
+    }
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
@@ -51,6 +51,7 @@
 #include <vector>
 
 #include "arch/generic/pcstate.hh"
+#include "base/pooled_list.hh"
 #include "base/statistics.hh"
 #include "cpu/activity.hh"
 #include "cpu/base.hh"
@@ -58,6 +59,7 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
@@ -175,6 +177,7 @@ class CPU : public BaseCPU
   public:
     /** Constructs a CPU with the given parameters. */
     CPU(const BaseO3CPUParams &params);
+    ~CPU();
 
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
@@ -343,6 +346,17 @@ class CPU : public BaseCPU
     void setArchReg(const RegId &reg, RegVal val, ThreadID tid);
     void setArchReg(const RegId &reg, const void *val, ThreadID tid);
 
+  private:
+    /**
+     * Look up the physical register of an architectural register that is
+     * about to be written. If an eliminated move shares it with another
+     * architectural register, the written register is first given a
+     * private physical register so the write cannot leak into the other.
+     */
+    PhysRegIdPtr archRegForWrite(const RegId &flat, ThreadID tid);
+
+  public:
+
     /** Sets the commit PC state of a specific thread. */
     void pcState(const PCStateBase &new_pc_state, ThreadID tid);
 
@@ -390,8 +404,16 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** Statistics of the DynInst pool. */
+    DynInstPool::PoolStats instPoolStats;
+
+    /** Slab pool for DynInst storage, nullptr if disabled. */
+    DynInstPool *instPool;
+
+    /** List of all the instructions in flight. Its nodes are recycled,
+     *  so it only allocates while growing past its high-water mark.
+     */
+    PooledList<DynInstPtr> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -521,6 +543,27 @@ class CPU : public BaseCPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+    /**
+     * Can the CPU stop ticking although the front-end is still active?
+     * This is the case when fetch is the only active stage, there is no
+     * pending time buffer activity, fetch is stalled on decode and no
+     * stage would change in a tick. Every event that could unblock the
+     * pipeline wakes the CPU, so skipping the intervening cycles does
+     * not change timing.
+     *
+     * This only covers a stalled fetch with a single hardware thread.
+     * Stalls in which another stage is active, e.g. a ROB head waiting
+     * on a cache miss with the rest of the pipeline backed up, are still
+     * ticked; that would need every stage to register the earliest cycle
+     * it can make progress. The CPU also ticks while the CommitStall
+     * probe has listeners.
+     */
+    bool frontEndStalled();
+
+    /** Stops skipping stalled cycles and accounts the skipped cycles in
+     * the statistics of every stage. */
+    void endStallSkip();
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -566,6 +609,12 @@ class CPU : public BaseCPU
     /** The cycle that the CPU was last running, used for statistics. */
     Cycles lastRunningCycle;
 
+    /** Deschedule the CPU while only a stalled front-end is active. */
+    const bool skipStalledCycles;
+
+    /** The CPU is descheduled because the front-end is stalled. */
+    bool skippingStall = false;
+
     /** The cycle that the CPU was last activated by a new thread*/
     Tick lastActivatedCycle;
 
@@ -612,6 +661,11 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for number of times the CPU descheduled itself because
+         * only a stalled front-end was active. */
+        statistics::Scalar stallSkips;
+        /** Stat for total number of cycles skipped that way. */
+        statistics::Scalar skippedStallCycles;
     } cpuStats;
 
   public:
@@ -588,6 +588,39 @@ Decode::tick()
     }
 }
 
+bool
+Decode::canSkipCycles() const
+{
+    for (ThreadID tid : *activeThreads) {
+        // Blocked waits for rename, Running and Idle for instructions.
+        if (decodeStatus[tid] == Blocked) {
+            if (!checkStall(tid)) {
+                return false;
+            }
+        } else if (decodeStatus[tid] == Running ||
+                   decodeStatus[tid] == Idle) {
+            if (checkStall(tid) || !insts[tid].empty()) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+Decode::skipCycles(Cycles cycles)
+{
+    for (ThreadID tid : *activeThreads) {
+        if (decodeStatus[tid] == Blocked) {
+            stats.status[Blocked] += cycles;
+        } else {
+            stats.status[Idle] += cycles;
+        }
+    }
+}
+
 void
 Decode::decode(bool &status_change, ThreadID tid)
 {
@@ -137,6 +137,14 @@ class Decode
      */
     void tick();
 
+    /** Would a tick leave decode unchanged apart from its per-cycle
+     * statistics? */
+    bool canSkipCycles() const;
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
@@ -99,6 +99,10 @@ class DependencyGraph
     void setInst(RegIndex idx, const DynInstPtr &new_inst)
     { dependGraph[idx].inst = new_inst; }
 
+    /** Returns the producing instruction of a given register, if any. */
+    const DynInstPtr &getInst(RegIndex idx) const
+    { return dependGraph[idx].inst; }
+
     /** Clears the producing instruction. */
     void clearInst(RegIndex idx)
     { dependGraph[idx].inst = NULL; }
@@ -119,6 +119,9 @@ DynInst::DynInst(const Arrays &arrays, const StaticInstPtr &_staticInst,
  * space for some structures the DynInst needs. We take into account both the
  * absolute size of these structures, and also what alignment they need.
  *
+ * The bytes come from the CPU's DynInstPool if it has one, which recycles
+ * the storage of DynInsts that have been freed, and from the heap otherwise.
+ *
  * Once we've gotten a buffer large enough to hold the DynInst itself and these
  * extra structures, we construct the extra bits using placement new. This
  * constructs the structures in place in the space we created for them.
@@ -168,7 +171,9 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    uint8_t *buf = (uint8_t *)(arrays.pool ?
+            arrays.pool->allocate(total_size) :
+            DynInstPool::allocateHeap(total_size));
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -189,11 +194,12 @@ DynInst::operator new(size_t count, Arrays &arrays)
 
 // Because of the custom "new" operator that allocates more bytes than the
 // size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// Adding a custom delete function is enough to shut down this false positive.
+// It also hands pooled storage back to its pool.
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    DynInstPool::deallocate(ptr);
 }
 
 DynInst::~DynInst()
@@ -361,6 +367,13 @@ DynInst::execute()
     return fault;
 }
 
+Fault
+DynInst::reexecute()
+{
+    std::queue<InstResult>().swap(instResult);
+    return execute();
+}
+
 Fault
 DynInst::initiateAcc()
 {
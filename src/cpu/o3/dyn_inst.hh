@@ -56,6 +56,7 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
@@ -92,6 +93,9 @@ class DynInst : public ExecContext, public RefCounted
         PhysRegIdPtr *prevDestIdx;
         PhysRegIdPtr *srcIdx;
         uint8_t *readySrcIdx;
+
+        /** Pool to allocate from, or nullptr for the heap. */
+        DynInstPool *pool = nullptr;
     };
 
     static void *operator new(size_t count, Arrays &arrays);
@@ -190,7 +194,11 @@ class DynInst : public ExecContext, public RefCounted
         NoCapableFU,           /// Processor does not have capability to
                                /// execute the instruction
         ValuePredicted,        /// Load has a value prediction
+        MemRenamed,            /// Load received its linked store's data
         CompSimplified,        /// Instruction was trivially simplified
+        Eliminated,            /// Move or zero idiom completed at rename
+        DataIndependentTiming, /// Renamed while DIT was set; its timing
+                               /// must not depend on operand values
         MaxFlags
     };
 
@@ -358,19 +366,32 @@ class DynInst : public ExecContext, public RefCounted
     ssize_t sqIdx = -1;
     typename LSQUnit::SQIterator sqIt;
 
+    /** The memory access missed in the D-cache. */
+    bool dcacheMiss = false;
 
-    /////////////////////// Load Value Prediction //////////////////////
-    /** Predicted value from the load value predictor. */
-    RegVal lvpPredictedValue = 0;
 
+    /////////////////////// Load Value Prediction //////////////////////
     /** Whether a value prediction was made for this load. */
     bool lvpPredictionMade = false;
 
+    /** Tick at which a selective replay of this instruction completes. */
+    Tick replayDoneTick = 0;
+
+    /**
+     * Re-executes an instruction after one of its source values was
+     * corrected, discarding the results recorded by the first execution.
+     */
+    Fault reexecute();
+
     /////////////////// Computation Simplification /////////////////////
     /** Was this instruction trivially simplified (FU bypassed)? */
     bool isCompSimplified() const { return instFlags[CompSimplified]; }
     void setCompSimplified() { instFlags[CompSimplified] = true; }
 
+    /** Was this move or zero idiom eliminated at rename? */
+    bool isEliminated() const { return instFlags[Eliminated]; }
+    void setEliminated() { instFlags[Eliminated] = true; }
+
     /////////////////////// TLB Miss //////////////////////
     /**
      * Saved memory request (needed when the DTB address translation is
@@ -394,6 +415,26 @@ class DynInst : public ExecContext, public RefCounted
     bool isValuePredicted() const { return instFlags[ValuePredicted]; }
     void setValuePredicted() { instFlags[ValuePredicted] = true; }
 
+    /** Was this load's value bypassed from a store by memory renaming? */
+    bool isMemRenamed() const { return instFlags[MemRenamed]; }
+    void setMemRenamed() { instFlags[MemRenamed] = true; }
+
+    /**
+     * Was this instruction renamed under data-independent timing? Any
+     * optimization whose latency or outcome depends on data values must
+     * be skipped for such instructions.
+     */
+    bool
+    isDataIndependentTiming() const
+    {
+        return instFlags[DataIndependentTiming];
+    }
+    void
+    setDataIndependentTiming()
+    {
+        instFlags[DataIndependentTiming] = true;
+    }
+
     /** Whether or not the memory operation is done. */
     bool memOpDone() const { return instFlags[MemOpDone]; }
     void memOpDone(bool f) { instFlags[MemOpDone] = f; }
@@ -793,8 +834,16 @@ class DynInst : public ExecContext, public RefCounted
     /** Clears this instruction as being ready to commit. */
     void clearCanCommit() { status.reset(CanCommit); }
 
-    /** Returns whether or not this instruction is ready to commit. */
-    bool readyToCommit() const { return status[CanCommit]; }
+    /**
+     * Returns whether or not this instruction is ready to commit. An
+     * instruction that is being selectively replayed is not ready until
+     * the replay completes.
+     */
+    bool
+    readyToCommit() const
+    {
+        return status[CanCommit] && curTick() >= replayDoneTick;
+    }
 
     void setAtCommit() { status.set(AtCommit); }
 
@@ -821,6 +870,7 @@ class DynInst : public ExecContext, public RefCounted
         assert(!iq);
         status.set(IqEntry);
         iq = _iq;
+        clusterIQ = _iq;
     }
 
     /** Clears this instruction as a entry the IQ. */
@@ -845,6 +895,16 @@ class DynInst : public ExecContext, public RefCounted
     /** Pointer to the IQ storing the instruction */
     IQUnit *iq = nullptr;
 
+    /** IQ the instruction was dispatched to. Unlike iq it is kept once
+     * the instruction leaves the IQ, so that its consumers can tell
+     * which cluster produced a value. */
+    IQUnit *clusterIQ = nullptr;
+
+    /** Cycle at which the last operand forwarded from another cluster
+     * or recomputed by a selective replay arrives; the instruction
+     * cannot issue before it. */
+    Cycles bypassReadyCycle = Cycles(0);
+
     //Load / Store Queue Functions
     //-----------------------
     /** Sets this instruction as a entry the LSQ. */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <algorithm>
+#include <new>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::DynInstPool(PoolStats *pool_stats)
+    : stats(pool_stats)
+{
+}
+
+DynInstPool::~DynInstPool()
+{
+    for (void *slab : slabs)
+        ::operator delete(slab);
+}
+
+void
+DynInstPool::release()
+{
+    stats = nullptr;
+    if (live == 0)
+        delete this;
+    else
+        orphaned = true;
+}
+
+void *
+DynInstPool::allocateHeap(size_t size)
+{
+    auto *hdr = (Header *)::operator new(HeaderSize + size);
+    hdr->pool = nullptr;
+    hdr->sizeClass = 0;
+    return (uint8_t *)hdr + HeaderSize;
+}
+
+void *
+DynInstPool::allocate(size_t size)
+{
+    const unsigned size_class = divCeil(HeaderSize + size, Granule);
+    if (size_class >= NumClasses) {
+        if (stats)
+            ++stats->fallbackAllocations;
+        return allocateHeap(size);
+    }
+
+    auto &free_list = freeLists[size_class];
+    if (free_list.empty()) {
+        refill(size_class);
+    } else if (stats) {
+        ++stats->recycled;
+    }
+
+    auto *hdr = (Header *)free_list.back();
+    free_list.pop_back();
+    hdr->pool = this;
+    hdr->sizeClass = size_class;
+
+    ++live;
+    if (stats) {
+        ++stats->allocations;
+        if (live > stats->highWaterMark.value())
+            stats->highWaterMark = live;
+    }
+
+    return (uint8_t *)hdr + HeaderSize;
+}
+
+void
+DynInstPool::refill(unsigned size_class)
+{
+    const size_t block = size_class * Granule;
+    const size_t num_blocks = std::max<size_t>(1, SlabBytes / block);
+    const size_t bytes = num_blocks * block;
+
+    auto *slab = (uint8_t *)::operator new(bytes);
+    slabs.push_back(slab);
+    if (stats)
+        stats->slabBytes += bytes;
+
+    // Hand out blocks in address order.
+    auto &free_list = freeLists[size_class];
+    for (size_t i = num_blocks; i-- > 0;)
+        free_list.push_back(slab + i * block);
+}
+
+void
+DynInstPool::deallocate(void *ptr)
+{
+    auto *hdr = (Header *)((uint8_t *)ptr - HeaderSize);
+    if (hdr->pool)
+        hdr->pool->recycle(hdr);
+    else
+        ::operator delete(hdr);
+}
+
+void
+DynInstPool::recycle(Header *hdr)
+{
+    freeLists[hdr->sizeClass].push_back(hdr);
+    --live;
+    if (orphaned && live == 0)
+        delete this;
+}
+
+DynInstPool::PoolStats::PoolStats(statistics::Group *parent)
+    : statistics::Group(parent, "dynInstPool"),
+      ADD_STAT(allocations, statistics::units::Count::get(),
+               "Number of DynInsts allocated from the slab pool"),
+      ADD_STAT(recycled, statistics::units::Count::get(),
+               "Number of pool allocations served by recycled storage"),
+      ADD_STAT(fallbackAllocations, statistics::units::Count::get(),
+               "Number of DynInsts too large for the pool, allocated from "
+               "the heap"),
+      ADD_STAT(highWaterMark, statistics::units::Count::get(),
+               "Largest number of pooled DynInsts alive at once"),
+      ADD_STAT(slabBytes, statistics::units::Byte::get(),
+               "Bytes of slab memory allocated by the pool")
+{
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Per-CPU slab pool for DynInst storage.
+ *
+ * A DynInst is allocated together with its trailing operand arrays, so
+ * its size varies with the number of operands. Requests are rounded up to
+ * a size class; each class keeps a free list of blocks carved out of
+ * large slabs, and a block goes back on its free list when the last
+ * reference to its DynInst is dropped. Requests larger than the biggest
+ * class fall back to the heap.
+ *
+ * Every block starts with a small header naming the pool it came from (or
+ * none for heap blocks), so deallocate() does not need to know the size
+ * or the CPU. The CPU releases its pool on destruction; a pool with
+ * blocks still in use lives on until the last one is returned.
+ */
+class DynInstPool
+{
+  public:
+    struct PoolStats : public statistics::Group
+    {
+        PoolStats(statistics::Group *parent);
+
+        /** Blocks handed out by the pool. */
+        statistics::Scalar allocations;
+        /** Blocks handed out from a free list rather than a new slab. */
+        statistics::Scalar recycled;
+        /** Requests too large for any size class. */
+        statistics::Scalar fallbackAllocations;
+        /** Largest number of blocks in use at once. */
+        statistics::Scalar highWaterMark;
+        /** Bytes of slab memory allocated. */
+        statistics::Scalar slabBytes;
+    };
+
+    DynInstPool(PoolStats *pool_stats);
+
+    /** Allocate a block of at least size bytes. */
+    void *allocate(size_t size);
+
+    /** Allocate a block straight from the heap, bypassing any pool. */
+    static void *allocateHeap(size_t size);
+
+    /** Return a block from allocate() or allocateHeap(). */
+    static void deallocate(void *ptr);
+
+    /** Called by the owning CPU instead of deleting the pool. */
+    void release();
+
+  private:
+    ~DynInstPool();
+
+    struct Header
+    {
+        /** Pool the block belongs to, nullptr for heap blocks. */
+        DynInstPool *pool;
+        unsigned sizeClass;
+    };
+
+    /** Header size, keeping the block suitably aligned. */
+    static constexpr size_t HeaderSize =
+        (sizeof(Header) + alignof(std::max_align_t) - 1) /
+        alignof(std::max_align_t) * alignof(std::max_align_t);
+    /** Size class granularity in bytes. */
+    static constexpr size_t Granule = 64;
+    /** Number of size classes; class i holds blocks of i granules. */
+    static constexpr size_t NumClasses = 65;
+    /** Nominal slab size in bytes. */
+    static constexpr size_t SlabBytes = 64 * 1024;
+
+    /** Carve a new slab into blocks of a size class. */
+    void refill(unsigned size_class);
+
+    /** Put a block back on its free list. */
+    void recycle(Header *hdr);
+
+    PoolStats *stats;
+
+    std::array<std::vector<void *>, NumClasses> freeLists;
+    std::vector<void *> slabs;
+
+    /** Blocks currently in use. */
+    size_t live = 0;
+    /** The owning CPU is gone; delete the pool once it drains. */
+    bool orphaned = false;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
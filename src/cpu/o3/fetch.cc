@@ -372,6 +372,11 @@ Fetch::processCacheCompletion(PacketPtr pkt)
     memcpy(fetchBuffer[tid], pkt->getConstPtr<uint8_t>(), fetchBufferSize);
     fetchBufferValid[tid] = true;
 
+    if (decoupledFrontEnd) {
+        ftq->recordFetchLatency(tid,
+                cpu->ticksToCycles(curTick() - lastIcacheStall[tid]));
+    }
+
     // Wake up the CPU (if it went to sleep and was waiting on
     // this completion event).
     cpu->wakeCPU();
@@ -783,6 +788,53 @@ Fetch::checkStall(ThreadID tid) const
     return ret_val;
 }
 
+bool
+Fetch::stalledOnDecode()
+{
+    // Even a single active thread draws from the RNG every cycle. Only
+    // skip those draws if a second thread can never make them matter.
+    if (numThreads != 1 || activeThreads->size() != 1) {
+        return false;
+    }
+
+    const ThreadID tid = activeThreads->front();
+
+    if (fetchStatus[tid] != Running || !stalls[tid].decode ||
+        fetchQueue[tid].size() < fetchQueueSize ||
+        issuePipelinedIfetch[tid] || cacheBlocked || wroteToTimeBuffer) {
+        return false;
+    }
+
+    // fetch() must take the same early exit every cycle: no FTQ wait or
+    // resteer, and no new I-cache access.
+    const PCStateBase &this_pc = *pc[tid];
+    if (decoupledFrontEnd && (!ftq->isHeadReady(tid) ||
+                              !ftq->readHead(tid)->inRange(
+                                  this_pc.instAddr()))) {
+        return false;
+    }
+
+    const Addr fetch_addr = (this_pc.instAddr() + fetchOffset[tid]) &
+                            decoder[tid]->pcMask();
+    return (fetchBufferValid[tid] &&
+            fetchBufferAlignPC(fetch_addr) == fetchBufferPC[tid]) ||
+           isRomMicroPC(this_pc.microPC()) || macroop[tid];
+}
+
+void
+Fetch::skipCycles(Cycles cycles)
+{
+    const ThreadID tid = activeThreads->front();
+
+    fetchStats.nisnDist.sample(0, cycles);
+    if (checkInterrupt(pc[tid]->instAddr()) && !delayedCommit[tid]) {
+        fetchStats.miscStallCycles += cycles;
+    } else {
+        fetchStats.status[Running] += cycles;
+        fetchStats.ftNumber.sample(0, cycles);
+    }
+}
+
 Fetch::FetchStatus
 Fetch::updateFetchStatus()
 {
@@ -1012,6 +1064,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     DynInst::Arrays arrays;
     arrays.numSrcs = staticInst->numSrcRegs();
     arrays.numDests = staticInst->numDestRegs();
+    arrays.pool = cpu->instPool;
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction = new (arrays) DynInst(
@@ -1415,6 +1468,7 @@ Fetch::recvReqRetry()
         assert(fetchStatus[retryTid] == IcacheWaitRetry);
 
         if (icachePort.sendTimingReq(retryPkt)) {
+            lastIcacheStall[retryTid] = curTick();
             fetchStatus[retryTid] = IcacheWaitResponse;
             // Notify Fetch Request probe when a retryPkt is successfully sent.
             // Note that notify must be called before retryPkt is set to NULL.
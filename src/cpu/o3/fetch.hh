@@ -231,6 +231,9 @@ class Fetch
     /** Sets pointer to branch address calculation stage and FTQ */
     void setBACandFTQPtr(BAC *bac_ptr, FTQ *ftq_ptr);
 
+    /** Returns the fetch status of a thread. */
+    ThreadStatus threadStatus(ThreadID tid) const { return fetchStatus[tid]; }
+
     /** Initialize stage. */
     void startupStage();
 
@@ -269,6 +272,19 @@ class Fetch
     /** Tells fetch to wake up from a quiesce instruction. */
     void wakeFromQuiesce();
 
+    /**
+     * Is fetch only spinning on a stalled decode stage? True when the
+     * single thread is running with a full fetch queue, decode is
+     * blocked and no I-cache access is pending or due, i.e. fetch cannot
+     * make progress until decode signals an unblock through the time
+     * buffer.
+     */
+    bool stalledOnDecode();
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because stalledOnDecode() was true. */
+    void skipCycles(Cycles cycles);
+
     /** For priority-based fetch policies, need to keep update priorityList */
     void deactivateThread(ThreadID tid);
   private:
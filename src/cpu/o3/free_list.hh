@@ -44,8 +44,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -137,6 +139,14 @@ class UnifiedFreeList
      */
     PhysRegFile *regFile;
 
+    /**
+     * Number of rename map entries, beyond the first, that map onto each
+     * physical register, indexed by flat register index. Registers are
+     * shared by eliminated moves; a shared register only goes back on
+     * its free list when the last of its mappings is released.
+     */
+    std::vector<uint16_t> sharers;
+
     /*
      * We give UnifiedRenameMap internal access so it can get at the
      * internal per-class free lists and associate those with its
@@ -169,13 +179,41 @@ class UnifiedFreeList
         std::for_each(first, last, [this](auto &reg) { addReg(&reg); });
     }
 
-    /** Adds a register back to the free list. */
+    /**
+     * Releases a mapping of a register. The register goes back on the
+     * free list unless other mappings still share it.
+     */
     void
     addReg(PhysRegIdPtr freed_reg)
     {
+        uint16_t &count = sharers[freed_reg->flatIndex()];
+        if (count > 0) {
+            --count;
+            DPRINTF(FreeList, "Released shared reg %i (%s), %d sharers "
+                    "left.\n", freed_reg->index(), freed_reg->className(),
+                    count);
+            return;
+        }
         freeLists[freed_reg->classValue()].addReg(freed_reg);
     }
 
+    /** Records one more mapping onto an allocated register. */
+    void
+    shareReg(PhysRegIdPtr reg)
+    {
+        uint16_t &count = sharers[reg->flatIndex()];
+        panic_if(count == UINT16_MAX, "Too many sharers of phys reg %i (%s)",
+                 reg->index(), reg->className());
+        ++count;
+    }
+
+    /** Returns the number of extra mappings onto a register. */
+    unsigned
+    numSharers(PhysRegIdPtr reg) const
+    {
+        return sharers[reg->flatIndex()];
+    }
+
     /** Checks if there are any free registers of type type. */
     bool
     hasFreeRegs(RegClassType type) const
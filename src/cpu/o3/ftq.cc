@@ -38,11 +38,15 @@
 
 #include "cpu/o3/ftq.hh"
 
+#include <algorithm>
+#include <cmath>
+
 #include "arch/generic/pcstate.hh"
 #include "base/logging.hh"
 #include "cpu/o3/cpu.hh"
 #include "debug/FTQ.hh"
 #include "params/BaseO3CPU.hh"
+#include "sim/cur_tick.hh"
 
 namespace gem5
 {
@@ -57,6 +61,9 @@ FetchTarget::FetchTarget(const ThreadID _tid, const PCStateBase &_start_pc,
       tid(_tid),
       is_branch(false),
       taken(false),
+      createTick(curTick()),
+      fetchTick(MaxTick),
+      prefetchTick(MaxTick),
       bpuHistory(nullptr)
 {
     set(startPC, _start_pc);
@@ -86,9 +93,19 @@ FetchTarget::toString()
 FTQ::FTQ(CPU *_cpu, const BaseO3CPUParams &params)
     : cpu(_cpu),
       numEntries(params.numFTQEntries),
+      adaptiveDepth(params.ftqAdaptiveDepth),
+      minDepth(params.ftqMinDepth),
+      depthEpoch(params.ftqDepthEpoch),
       stats(_cpu, params.numFTQEntries)
 {
+    fatal_if(adaptiveDepth && (minDepth == 0 || minDepth > numEntries),
+             "ftqMinDepth (%u) must be between 1 and numFTQEntries (%u).",
+             minDepth, numEntries);
+    fatal_if(adaptiveDepth && depthEpoch == 0,
+             "ftqDepthEpoch must be at least one cycle.");
+
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+        depth[tid] = numEntries;
         resetState(tid);
     }
 }
@@ -118,7 +135,7 @@ FTQ::regProbePoints()
 unsigned
 FTQ::numFreeEntries(ThreadID tid)
 {
-    return numEntries - ftq[tid].size();
+    return ftq[tid].size() < depth[tid] ? depth[tid] - ftq[tid].size() : 0;
 }
 
 unsigned
@@ -130,7 +147,7 @@ FTQ::size(ThreadID tid)
 bool
 FTQ::isFull(ThreadID tid)
 {
-    return ftq[tid].size() >= numEntries;
+    return ftq[tid].size() >= depth[tid];
 }
 
 bool
@@ -185,7 +202,7 @@ FTQ::forAllBackward(ThreadID tid, std::function<void(FetchTargetPtr &)> f)
 void
 FTQ::insert(ThreadID tid, FetchTargetPtr fetchTarget)
 {
-    assert(ftq[tid].size() < numEntries);
+    assert(ftq[tid].size() < depth[tid]);
     ftq[tid].push_back(fetchTarget);
     ppFTQInsert->notify(fetchTarget);
     stats.inserts++;
@@ -258,7 +275,13 @@ FTQ::popHead(ThreadID tid)
         ret_val = false;
     }
 
-    ppFTQRemove->notify(ftq[tid].front());
+    FetchTargetPtr &head = ftq[tid].front();
+    head->markFetched(curTick());
+    stats.createToFetch.sample(
+        cpu->ticksToCycles(head->fetched() - head->created()));
+    monitor[tid].pops++;
+
+    ppFTQRemove->notify(head);
     ftq[tid].pop_front();
     stats.removals++;
     return ret_val;
@@ -274,6 +297,76 @@ FTQ::printFTQ(ThreadID tid)
     }
 }
 
+void
+FTQ::recordFetchLatency(ThreadID tid, Cycles latency)
+{
+    stats.fetchLatency.sample(latency);
+    monitor[tid].latency += latency;
+    monitor[tid].accesses++;
+}
+
+void
+FTQ::updateDepth(ThreadID tid)
+{
+    if (!adaptiveDepth) {
+        return;
+    }
+
+    DepthMonitor &mon = monitor[tid];
+    if (ftq[tid].size() >= depth[tid]) {
+        mon.fullCycles++;
+    }
+
+    const Cycles now = cpu->curCycle();
+    if (now - mon.epochStart < depthEpoch) {
+        return;
+    }
+
+    if (mon.accesses && mon.pops) {
+        // Fetch targets fetch consumes while one I-cache access is in
+        // flight. The BAC has to run at least this far ahead to hide the
+        // access latency behind prefetches.
+        const double avg_latency = double(mon.latency) / mon.accesses;
+        const double pop_rate = double(mon.pops) / (now - mon.epochStart);
+        const unsigned target = std::clamp<unsigned>(
+            std::ceil(avg_latency * pop_rate), minDepth, numEntries);
+
+        // Only grow if the BAC was actually held back by the depth,
+        // otherwise more entries would never be used.
+        if (target > depth[tid] && mon.fullCycles) {
+            DPRINTF(FTQ, "[tid:%i] Grow run-ahead depth %u -> %u "
+                    "(lat:%.1f, FT/cycle:%.2f)\n", tid, depth[tid], target,
+                    avg_latency, pop_rate);
+            depth[tid] = target;
+            stats.depthIncreases++;
+        } else if (target < depth[tid]) {
+            DPRINTF(FTQ, "[tid:%i] Shrink run-ahead depth %u -> %u "
+                    "(lat:%.1f, FT/cycle:%.2f)\n", tid, depth[tid], target,
+                    avg_latency, pop_rate);
+            depth[tid] = target;
+            stats.depthDecreases++;
+        }
+    }
+    stats.depth.sample(depth[tid]);
+
+    mon = DepthMonitor();
+    mon.epochStart = now;
+}
+
+void
+FTQ::skipCycles(ThreadID tid, Cycles cycles)
+{
+    if (!adaptiveDepth) {
+        return;
+    }
+
+    assert(cpu->curCycle() <= depthEpochEnd(tid));
+
+    if (ftq[tid].size() >= depth[tid]) {
+        monitor[tid].fullCycles += cycles;
+    }
+}
+
 FTQ::FTQStats::FTQStats(o3::CPU *cpu, unsigned numFTQEntries)
     : statistics::Group(cpu, "ftq"),
       ADD_STAT(inserts, statistics::units::Count::get(),
@@ -284,14 +377,37 @@ FTQ::FTQStats::FTQStats(o3::CPU *cpu, unsigned numFTQEntries)
                "The number of FTQ squashes"),
       ADD_STAT(locks, statistics::units::Count::get(),
                "The number of times the FTQ got locked."),
+      ADD_STAT(depthIncreases, statistics::units::Count::get(),
+               "The number of times the adaptive run-ahead depth grew"),
+      ADD_STAT(depthDecreases, statistics::units::Count::get(),
+               "The number of times the adaptive run-ahead depth shrank"),
       ADD_STAT(occupancy, statistics::units::Count::get(),
-               "Distribution of the FTQ occupation.")
+               "Distribution of the FTQ occupation."),
+      ADD_STAT(depth, statistics::units::Count::get(),
+               "Distribution of the adaptive run-ahead depth per epoch"),
+      ADD_STAT(fetchLatency, statistics::units::Cycle::get(),
+               "Distribution of the I-cache access latency seen by fetch"),
+      ADD_STAT(createToFetch, statistics::units::Cycle::get(),
+               "Distribution of the cycles between creating a fetch target "
+               "and fetch consuming it")
 {
     occupancy
         .init(/* base value */ 0,
               /* last value */ numFTQEntries,
               /* bucket size */ 4)
         .flags(statistics::pdf);
+
+    depth
+        .init(0, numFTQEntries, 4)
+        .flags(statistics::pdf | statistics::nozero);
+
+    fetchLatency
+        .init(0, 256, 8)
+        .flags(statistics::pdf | statistics::nozero);
+
+    createToFetch
+        .init(0, 256, 8)
+        .flags(statistics::pdf | statistics::nozero);
 }
 
 } // namespace o3
@@ -39,6 +39,7 @@
 #ifndef __CPU_O3_FTQ_HH__
 #define __CPU_O3_FTQ_HH__
 
+#include <array>
 #include <list>
 #include <string>
 
@@ -108,6 +109,15 @@ class FetchTarget
     /** If the exit branch is predicted taken */
     bool taken;
 
+    /** Tick when the fetch target was created by the BAC stage. */
+    const Tick createTick;
+
+    /** Tick when fetch consumed the fetch target. */
+    Tick fetchTick;
+
+    /** Tick when the first prefetch for this fetch target was issued. */
+    Tick prefetchTick;
+
   public:
     /** Anchor point to attach a branch predictor history.
      * Will carry information while FT is waiting in th FTQ. */
@@ -210,6 +220,44 @@ class FetchTarget
         return taken;
     }
 
+    /** Tick when the fetch target was created. */
+    Tick
+    created() const
+    {
+        return createTick;
+    }
+
+    /** Tick when fetch consumed the fetch target, MaxTick if never. */
+    Tick
+    fetched() const
+    {
+        return fetchTick;
+    }
+
+    /** Tick when its first prefetch was issued, MaxTick if never. */
+    Tick
+    prefetched() const
+    {
+        return prefetchTick;
+    }
+
+    /** Record that fetch has consumed this fetch target. */
+    void
+    markFetched(Tick when)
+    {
+        fetchTick = when;
+    }
+
+    /** Record that a prefetch for this fetch target was issued. Only the
+     * first prefetch is kept. */
+    void
+    markPrefetched(Tick when)
+    {
+        if (prefetchTick == MaxTick) {
+            prefetchTick = when;
+        }
+    }
+
     /** Complete a fetch target with the exit instruction */
     void finalize(const PCStateBase &exit_pc, bool _is_branch, bool pred_taken,
                   const PCStateBase &pred_pc);
@@ -253,6 +301,34 @@ class FTQ
     /** Number of fetch targets in the FTQ. (per thread) */
     const unsigned numEntries;
 
+    /** Adapt the run-ahead depth to the I-cache latency seen by fetch. */
+    const bool adaptiveDepth;
+
+    /** Lower bound of the adaptive run-ahead depth. */
+    const unsigned minDepth;
+
+    /** Number of cycles between two depth adjustments. */
+    const Cycles depthEpoch;
+
+    /** Current run-ahead depth, i.e. the number of usable entries.
+     * Always numEntries unless the adaptive depth is enabled. */
+    std::array<unsigned, MaxThreads> depth;
+
+    /** Per-thread measurements of the current depth epoch. */
+    struct DepthMonitor
+    {
+        /** Cycle the epoch started. */
+        Cycles epochStart = Cycles(0);
+        /** Sum and count of the I-cache access latencies. */
+        Cycles latency = Cycles(0);
+        unsigned accesses = 0;
+        /** Fetch targets consumed by fetch. */
+        unsigned pops = 0;
+        /** Cycles in which the FTQ was filled up to its depth. */
+        unsigned fullCycles = 0;
+    };
+    std::array<DepthMonitor, MaxThreads> monitor;
+
     /** Probe points to attach the FDP prefetcher. */
     ProbePointArg<FetchTargetPtr> *ppFTQInsert;
     ProbePointArg<FetchTargetPtr> *ppFTQRemove;
@@ -336,6 +412,35 @@ class FTQ
     /** Print the all fetch targets in the FTQ for debugging. */
     void printFTQ(ThreadID tid);
 
+    /** Returns the current run-ahead depth of a thread. */
+    unsigned runAheadDepth(ThreadID tid) const { return depth[tid]; }
+
+    /** Records the latency of an I-cache access made by fetch. Used to
+     * size the adaptive run-ahead depth. */
+    void recordFetchLatency(ThreadID tid, Cycles latency);
+
+    /** Samples the FTQ occupancy and, at the end of an epoch, moves the
+     * run-ahead depth towards the number of fetch targets that fetch
+     * consumes during one I-cache access. Called once per cycle by BAC.
+     */
+    void updateDepth(ThreadID tid);
+
+    /** Cycle in which the current depth epoch of a thread ends, or 0 if
+     * the depth does not adapt. */
+    Cycles
+    depthEpochEnd(ThreadID tid) const
+    {
+        if (!adaptiveDepth) {
+            return Cycles(0);
+        }
+        return monitor[tid].epochStart + depthEpoch;
+    }
+
+    /** Samples the occupancy of cycles in which updateDepth() was not
+     * called because the CPU skipped them. Must not span an epoch end.
+     */
+    void skipCycles(ThreadID tid, Cycles cycles);
+
   private:
     struct FTQStats : public statistics::Group
     {
@@ -345,8 +450,13 @@ class FTQ
         statistics::Scalar removals;
         statistics::Scalar squashes;
         statistics::Scalar locks;
+        statistics::Scalar depthIncreases;
+        statistics::Scalar depthDecreases;
 
         statistics::Distribution occupancy;
+        statistics::Distribution depth;
+        statistics::Distribution fetchLatency;
+        statistics::Distribution createToFetch;
     } stats;
 };
 
@@ -40,9 +40,16 @@
 
 #include "cpu/o3/fu_pool.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "cpu/func_unit.hh"
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
 
 namespace gem5
 {
@@ -50,6 +57,116 @@ namespace gem5
 namespace o3
 {
 
+////////////////////////////////////////////////////////////////////////////
+//
+//  Value-dependent latency models
+//
+
+LeadingZeroLatency::LeadingZeroLatency(const Params &p)
+    : OpLatencyModel(p), operand(p.operand), relativeTo(p.relativeTo),
+      width(p.width), bitsPerCycle(p.bitsPerCycle), minLat(p.minLat)
+{
+    fatal_if(width == 0 || width > 64,
+             "%s: operand width must be between 1 and 64 bits", name());
+    fatal_if(bitsPerCycle == 0, "%s: bitsPerCycle must be non-zero",
+             name());
+}
+
+unsigned
+LeadingZeroLatency::significantBits(RegVal val) const
+{
+    val &= mask(width);
+    return val ? findMsbSet(val) + 1 : 0;
+}
+
+Cycles
+LeadingZeroLatency::latency(Cycles op_lat, const OpLatencySrc *srcs,
+                            int num_srcs) const
+{
+    if ((int)operand >= num_srcs || relativeTo >= num_srcs ||
+            !srcs[operand].valid ||
+            (relativeTo >= 0 && !srcs[relativeTo].valid)) {
+        return op_lat;
+    }
+
+    const unsigned bits = significantBits(srcs[operand].val);
+    unsigned work;
+    if (relativeTo < 0) {
+        work = width - bits;
+    } else {
+        const unsigned ref_bits = significantBits(srcs[relativeTo].val);
+        work = ref_bits >= bits ? ref_bits - bits + 1 : 0;
+    }
+
+    return std::min(op_lat, Cycles(minLat + divCeil(work, bitsPerCycle)));
+}
+
+ZeroOperandLatency::ZeroOperandLatency(const Params &p)
+    : OpLatencyModel(p), operands(p.operands), width(p.width),
+      zeroLat(p.zeroLat)
+{
+    fatal_if(width == 0 || width > 64,
+             "%s: operand width must be between 1 and 64 bits", name());
+}
+
+Cycles
+ZeroOperandLatency::latency(Cycles op_lat, const OpLatencySrc *srcs,
+                            int num_srcs) const
+{
+    auto is_zero = [&](unsigned i) {
+        return (int)i < num_srcs && srcs[i].valid &&
+            (srcs[i].val & mask(width)) == 0;
+    };
+
+    bool zero = false;
+    if (operands.empty()) {
+        for (int i = 0; i < num_srcs && !zero; i++)
+            zero = is_zero(i);
+    } else {
+        zero = std::any_of(operands.begin(), operands.end(), is_zero);
+    }
+
+    return zero ? std::min(op_lat, zeroLat) : op_lat;
+}
+
+DenormalLatency::DenormalLatency(const Params &p)
+    : OpLatencyModel(p), operands(p.operands), fpBits(p.fpBits),
+      penalty(p.penalty)
+{
+    fatal_if(fpBits != 16 && fpBits != 32 && fpBits != 64,
+             "%s: fpBits must be 16, 32 or 64", name());
+}
+
+bool
+DenormalLatency::isDenormal(RegVal val) const
+{
+    const unsigned mant_bits = fpBits == 16 ? 10 : fpBits == 32 ? 23 : 52;
+    const unsigned exp_bits = fpBits - mant_bits - 1;
+    return bits(val, mant_bits + exp_bits - 1, mant_bits) == 0 &&
+        bits(val, mant_bits - 1, 0) != 0;
+}
+
+Cycles
+DenormalLatency::latency(Cycles op_lat, const OpLatencySrc *srcs,
+                         int num_srcs) const
+{
+    auto is_denormal = [&](unsigned i) {
+        return (int)i < num_srcs && srcs[i].valid &&
+            isDenormal(srcs[i].val);
+    };
+
+    bool denormal = false;
+    if (operands.empty()) {
+        for (int i = 0; i < num_srcs && !denormal; i++)
+            denormal = is_denormal(i);
+    } else {
+        denormal = std::any_of(operands.begin(), operands.end(),
+                               is_denormal);
+    }
+
+    return denormal ? op_lat + penalty : op_lat;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //
 //  A pool of function units
@@ -83,7 +200,7 @@ FUPool::~FUPool()
 
 // Constructor
 FUPool::FUPool(const Params &p)
-    : SimObject(p)
+    : SimObject(p), stats(this)
 {
     numFU = 0;
 
@@ -91,6 +208,7 @@ FUPool::FUPool(const Params &p)
 
     maxOpLatencies.fill(Cycles(0));
     pipelined.fill(true);
+    valueLatModels.fill(nullptr);
 
     //
     //  Iterate through the list of FUDescData structures
@@ -121,8 +239,13 @@ FUPool::FUPool(const Params &p)
                 // indicate that this FU has the capability
                 fu->addCapability(j->opClass, j->opLat, j->pipelined);
 
-                if (j->opLat > maxOpLatencies[j->opClass])
+                if (j->opLat > maxOpLatencies[j->opClass]) {
                     maxOpLatencies[j->opClass] = j->opLat;
+                    valueLatModels[j->opClass] = j->valueLat;
+                } else if (j->opLat == maxOpLatencies[j->opClass] &&
+                           !valueLatModels[j->opClass]) {
+                    valueLatModels[j->opClass] = j->valueLat;
+                }
 
                 if (!j->pipelined)
                     pipelined[j->opClass] = false;
@@ -243,6 +366,78 @@ FUPool::dump()
     }
 }
 
+Cycles
+FUPool::getOpLatency(const DynInstPtr &inst)
+{
+    const OpClass op_class = inst->opClass();
+    const Cycles op_lat = maxOpLatencies[op_class];
+    const OpLatencyModel *model = valueLatModels[op_class];
+    if (!model)
+        return op_lat;
+
+    // Only the low 64 bits of each operand are handed to the model; for
+    // vector registers that is the lowest element(s), which covers scalar
+    // FP held in the vector register file.
+    // Operands are indexed by source register index, and those of classes
+    // without a value are marked invalid.
+    srcVals.assign(inst->numSrcRegs(), OpLatencySrc());
+    for (int i = 0; i < inst->numSrcRegs(); i++) {
+        PhysRegIdPtr reg = inst->renamedSrcIdx(i);
+        switch (reg->classValue()) {
+          case IntRegClass:
+          case FloatRegClass:
+          case VecElemClass:
+          case CCRegClass:
+            srcVals[i] = {inst->cpu->getReg(reg, inst->threadNumber), true};
+            break;
+          case VecRegClass:
+            {
+                const size_t reg_bytes = reg->regClass().regBytes();
+                regBuf.resize(std::max(regBuf.size(), reg_bytes));
+                inst->cpu->getReg(reg, regBuf.data(), inst->threadNumber);
+                RegVal val = 0;
+                std::memcpy(&val, regBuf.data(),
+                            std::min(sizeof(val), reg_bytes));
+                srcVals[i] = {val, true};
+            }
+            break;
+          default:
+            break;
+        }
+    }
+
+    Cycles lat = std::max(Cycles(1),
+            model->latency(op_lat, srcVals.data(), srcVals.size()));
+    if (lat == op_lat)
+        return op_lat;
+
+    if (inst->isDataIndependentTiming()) {
+        ++stats.ditSuppressed;
+        return op_lat;
+    }
+
+    if (lat < op_lat)
+        ++stats.valueLatShorter;
+    else
+        ++stats.valueLatLonger;
+
+    return lat;
+}
+
+FUPool::FUPoolStats::FUPoolStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(valueLatShorter, statistics::units::Count::get(),
+               "Number of issues shortened by a value-dependent latency "
+               "model"),
+      ADD_STAT(valueLatLonger, statistics::units::Count::get(),
+               "Number of issues lengthened by a value-dependent latency "
+               "model"),
+      ADD_STAT(ditSuppressed, statistics::units::Count::get(),
+               "Number of value-dependent latency adjustments suppressed "
+               "by data-independent timing")
+{
+}
+
 bool
 FUPool::isDrained() const
 {
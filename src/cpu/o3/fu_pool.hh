@@ -47,19 +47,84 @@
 #include <string>
 #include <vector>
 
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/func_unit.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/op_class.hh"
+#include "params/DenormalLatency.hh"
 #include "params/FUPool.hh"
+#include "params/LeadingZeroLatency.hh"
+#include "params/ZeroOperandLatency.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
 {
 
-class FUDesc;
-class FuncUnit;
-
 namespace o3
 {
 
+/**
+ * Latency set by the position of the leading one of a source operand,
+ * e.g. an early-out divider that retires a fixed number of quotient bits
+ * per cycle. The work is either the leading-zero count of one operand, or
+ * the difference in significant bits between two operands (the number of
+ * quotient bits of a division).
+ */
+class LeadingZeroLatency : public OpLatencyModel
+{
+  public:
+    PARAMS(LeadingZeroLatency);
+    LeadingZeroLatency(const Params &p);
+
+    Cycles latency(Cycles op_lat, const OpLatencySrc *srcs,
+                   int num_srcs) const override;
+
+  private:
+    /** Number of significant bits of a value within the operand width. */
+    unsigned significantBits(RegVal val) const;
+
+    const unsigned operand;
+    const int relativeTo;
+    const unsigned width;
+    const unsigned bitsPerCycle;
+    const Cycles minLat;
+};
+
+/** Short latency when a source operand is zero (zero-skipping units). */
+class ZeroOperandLatency : public OpLatencyModel
+{
+  public:
+    PARAMS(ZeroOperandLatency);
+    ZeroOperandLatency(const Params &p);
+
+    Cycles latency(Cycles op_lat, const OpLatencySrc *srcs,
+                   int num_srcs) const override;
+
+  private:
+    const std::vector<unsigned> operands;
+    const unsigned width;
+    const Cycles zeroLat;
+};
+
+/** Extra latency when a floating-point source operand is subnormal. */
+class DenormalLatency : public OpLatencyModel
+{
+  public:
+    PARAMS(DenormalLatency);
+    DenormalLatency(const Params &p);
+
+    Cycles latency(Cycles op_lat, const OpLatencySrc *srcs,
+                   int num_srcs) const override;
+
+  private:
+    bool isDenormal(RegVal val) const;
+
+    const std::vector<unsigned> operands;
+    const unsigned fpBits;
+    const Cycles penalty;
+};
+
 /**
  * Pool of FU's, specific to the new CPU model. The old FU pool had lists of
  * free units and busy units, and whenever a FU was needed it would iterate
@@ -79,6 +144,16 @@ class FUPool : public SimObject
     std::array<Cycles, Num_OpClasses> maxOpLatencies;
     /** Whether op is pipelined or not. */
     std::array<bool, Num_OpClasses> pipelined;
+    /**
+     * Value-dependent latency model, per op class, taken from the OpDesc
+     * that sets the op class's maximum latency.
+     */
+    std::array<OpLatencyModel *, Num_OpClasses> valueLatModels;
+
+    /** Source operands handed to a value-dependent model. */
+    std::vector<OpLatencySrc> srcVals;
+    /** Scratch buffer for reading vector source registers. */
+    std::vector<uint8_t> regBuf;
 
     /** Bitvector listing capabilities of this FU pool. */
     std::bitset<Num_OpClasses> capabilityList;
@@ -194,6 +269,15 @@ class FUPool : public SimObject
         return maxOpLatencies[capability];
     }
 
+    /**
+     * Returns the execution latency of an instruction about to issue. If
+     * its op class has a value-dependent latency model, the model adjusts
+     * the fixed latency based on the instruction's source operand values.
+     * Instructions under data-independent timing always get the fixed
+     * latency.
+     */
+    Cycles getOpLatency(const DynInstPtr &inst);
+
     /** Returns the issue latency of the given capability. */
     bool isPipelined(OpClass capability) {
         return pipelined[capability];
@@ -204,6 +288,19 @@ class FUPool : public SimObject
 
     /** Takes over from another CPU's thread. */
     void takeOverFrom() {};
+
+  private:
+    struct FUPoolStats : public statistics::Group
+    {
+        FUPoolStats(statistics::Group *parent);
+
+        /** Issues a value-dependent model made faster than opLat. */
+        statistics::Scalar valueLatShorter;
+        /** Issues a value-dependent model made slower than opLat. */
+        statistics::Scalar valueLatLonger;
+        /** Latency adjustments suppressed by data-independent timing. */
+        statistics::Scalar ditSuppressed;
+    } stats;
 };
 
 } // namespace o3
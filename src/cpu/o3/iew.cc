@@ -123,11 +123,13 @@ IEW::IEW(CPU *_cpu, const BaseO3CPUParams &params)
     }
 
     updateLSQNextCycle = false;
+    replayDoneTick = 0;
 
     skidBufferMax = (renameToIEWDelay + 1) * params.renameWidth;
 
     // Initialize load value predictor.
     lvp = params.loadValuePredictor;
+    memRenamer = params.memoryRenamer;
 }
 
 std::string
@@ -181,6 +183,16 @@ IEW::IEWStats::IEWStats(CPU *cpu)
                "Number of memory order violations"),
       ADD_STAT(valueMispredicts, statistics::units::Count::get(),
                "Number of load value mispredictions"),
+      ADD_STAT(valueMispredReplays, statistics::units::Count::get(),
+               "Number of load value mispredictions recovered by selective "
+               "replay"),
+      ADD_STAT(valueMispredSquashes, statistics::units::Count::get(),
+               "Number of load value mispredictions recovered by squashing"),
+      ADD_STAT(valueReplayedInsts, statistics::units::Count::get(),
+               "Number of instructions re-executed by selective replay"),
+      ADD_STAT(valueSquashedInsts, statistics::units::Count::get(),
+               "Number of instructions squashed by load value "
+               "mispredictions"),
       ADD_STAT(predictedTakenIncorrect, statistics::units::Count::get(),
                "Number of branches that were predicted taken incorrectly"),
       ADD_STAT(predictedNotTakenIncorrect, statistics::units::Count::get(),
@@ -476,6 +488,9 @@ IEW::squash(ThreadID tid)
     if (lvp) {
         lvp->squash(fromCommit->commitInfo[tid].doneSeqNum, tid);
     }
+    if (memRenamer) {
+        memRenamer->squash(fromCommit->commitInfo[tid].doneSeqNum, tid);
+    }
 
     emptyRenameInsts(tid);
 }
@@ -553,6 +568,85 @@ IEW::squashDueToValueMispredict(const DynInstPtr& inst, ThreadID tid)
     }
 }
 
+void
+IEW::recoverValueMispredict(const DynInstPtr &inst, ThreadID tid,
+                            bool replay)
+{
+    if (replay) {
+        Tick done_tick;
+        int replayed = instQueue.replayDependents(inst, done_tick);
+        if (replayed >= 0) {
+            DPRINTF(IEW, "[tid:%i] [sn:%llu] Replaying %d dependents of "
+                    "value mispredicted load.\n", tid, inst->seqNum,
+                    replayed);
+            replayDoneTick = std::max(replayDoneTick, done_tick);
+            ++iewStats.valueMispredReplays;
+            iewStats.valueReplayedInsts += replayed;
+            return;
+        }
+    }
+
+    // Everything younger than the load is thrown away.
+    for (auto it = cpu->instList.rbegin();
+         it != cpu->instList.rend() && (*it)->seqNum > inst->seqNum; ++it) {
+        if ((*it)->threadNumber == tid && !(*it)->isSquashed())
+            ++iewStats.valueSquashedInsts;
+    }
+    ++iewStats.valueMispredSquashes;
+
+    squashDueToValueMispredict(inst, tid);
+}
+
+void
+IEW::wakeValuePredicted(const DynInstPtr &inst)
+{
+    // Wake dependents in the IQ (sets internal scoreboard).
+    // The isValuePredicted && !isExecuted guard in
+    // wakeDependents skips the memDepUnit completion.
+    instQueue.wakeDependents(inst);
+
+    // Set the external scoreboard as ready.
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        if (!inst->renamedDestIdx(i)->isAlwaysReady())
+            scoreboard->setReg(inst->renamedDestIdx(i));
+    }
+}
+
+void
+IEW::bypassRenamedLoad(const DynInstPtr &load, RegVal value)
+{
+    // Only a load still waiting to issue benefits from the bypass.
+    if (load->isSquashed() || !load->isInIQ() || load->isIssued() ||
+        load->isValuePredicted() || load->strictlyOrdered())
+        return;
+
+    cpu->setReg(load->renamedDestIdx(0), value, load->threadNumber);
+    load->setValuePredicted();
+    load->setMemRenamed();
+    memRenamer->bypassed(load, value);
+
+    wakeValuePredicted(load);
+
+    DPRINTF(IEW, "[tid:%i] [sn:%llu] Memory renaming: bypassed %#x to "
+            "load PC %s\n", load->threadNumber, load->seqNum, value,
+            load->pcState());
+}
+
+void
+IEW::storeDataReady(const DynInstPtr &store, const uint8_t *data,
+                    unsigned size)
+{
+    if (!memRenamer || !memRenamer->isEnabled())
+        return;
+
+    std::vector<DynInstPtr> ready;
+    RegVal value = 0;
+    memRenamer->storeData(store, data, size,
+                          cpu->system->getGuestByteOrder(), ready, value);
+    for (auto &load : ready)
+        bypassRenamedLoad(load, value);
+}
+
 void
 IEW::block(ThreadID tid)
 {
@@ -972,8 +1066,9 @@ IEW::dispatchInsts(ThreadID tid)
             continue;
         }
 
-        // Check for full conditions.
-        if (instQueue.isFull(inst)) {
+        // Check for full conditions. Eliminated instructions do not
+        // need an IQ entry.
+        if (!inst->isEliminated() && instQueue.isFull(inst)) {
             // Check if no FU pool in the system can handle this
             // instruction's OpClass. If so, the instruction can never
             // be dispatched or executed, causing a permanent deadlock.
@@ -1101,6 +1196,18 @@ IEW::dispatchInsts(ThreadID tid)
             // Same as non-speculative stores.
             inst->setCanCommit();
             instQueue.insertBarrier(inst);
+            add_to_iq = false;
+        } else if (inst->isEliminated()) {
+            DPRINTF(IEW, "[tid:%i] Issue: Instruction eliminated at rename, "
+                    "skipping.\n", tid);
+
+            // The destination register was mapped or written at rename,
+            // so unlike a nop the instruction does not become its
+            // producer in the IQ.
+            inst->setIssued();
+            inst->setExecuted();
+            inst->setCanCommit();
+
             add_to_iq = false;
         } else if (inst->isNop()) {
             DPRINTF(IEW, "[tid:%i] Issue: Nop instruction encountered, "
@@ -1145,52 +1252,45 @@ IEW::dispatchInsts(ThreadID tid)
         // graph is set up), attempt to predict the load value and
         // speculatively wake dependent instructions.
         if (lvp && lvp->isEnabled() && inst->isLoad() &&
-            !inst->isSquashed() && !inst->strictlyOrdered() &&
-            inst->numDestRegs() == 1) {
-
-            PhysRegIdPtr destReg = inst->renamedDestIdx(0);
-
-            // Only predict for integer register destinations.
-            if (destReg->classValue() == IntRegClass &&
-                !destReg->isAlwaysReady()) {
-
-                RegVal predictedValue;
-                Addr loadPC = inst->pcState().instAddr();
-
-                if (lvp->predict(loadPC, tid, predictedValue)) {
-                    // Write predicted value to the destination register.
-                    cpu->setReg(destReg, predictedValue, tid);
-
-                    // Mark the instruction as having a value prediction.
-                    inst->setValuePredicted();
-                    inst->lvpPredictedValue = predictedValue;
-                    inst->lvpPredictionMade = true;
-
-                    // Wake dependents in the IQ (sets internal scoreboard).
-                    // The isValuePredicted && !isExecuted guard in
-                    // wakeDependents skips the memDepUnit completion.
-                    instQueue.wakeDependents(inst);
-
-                    // Set the external scoreboard as ready.
-                    scoreboard->setReg(destReg);
-
-                    // Record prediction history.
-                    LVPHistory entry;
-                    entry.seqNum = inst->seqNum;
-                    entry.pc = loadPC;
-                    entry.tid = tid;
-                    entry.predictedValue = predictedValue;
-                    entry.predicted = true;
-                    lvp->addHistory(entry);
-
-                    DPRINTF(IEW, "[tid:%i] [sn:%llu] LVP: Predicted load "
-                            "PC %s -> %#x\n",
-                            tid, inst->seqNum, inst->pcState(),
-                            predictedValue);
-                }
+            !inst->isSquashed() && !inst->strictlyOrdered()) {
+
+            // Every destination register (e.g. both halves of a load
+            // pair) must be predictable for the load to be predicted.
+            unsigned num_words = lvp->numValueWords(inst);
+
+            LVPValue predictedValue;
+            Addr loadPC = inst->pcState().instAddr();
+
+            if (num_words &&
+                lvp->predict(inst->seqNum, loadPC, tid, num_words,
+                             inst->isDataIndependentTiming(),
+                             predictedValue)) {
+                // Write predicted values to the destination registers.
+                lvp->writeDestRegs(inst, cpu, predictedValue);
+
+                // Mark the instruction as having a value prediction.
+                inst->setValuePredicted();
+                inst->lvpPredictionMade = true;
+
+                wakeValuePredicted(inst);
+
+                DPRINTF(IEW, "[tid:%i] [sn:%llu] LVP: Predicted load "
+                        "PC %s -> %#x (%d words)\n",
+                        tid, inst->seqNum, inst->pcState(),
+                        predictedValue.words[0], num_words);
             }
         }
 
+        // Memory renaming: bypass the data of the load's linked store
+        // if it has already been written to the store queue. Otherwise
+        // the load waits for it in storeDataReady().
+        RegVal bypass_value;
+        if (memRenamer && inst->isLoad() && add_to_iq &&
+            !inst->isSquashed() &&
+            memRenamer->dispatch(inst, bypass_value)) {
+            bypassRenamedLoad(inst, bypass_value);
+        }
+
         insts_to_dispatch.pop();
 
         toRename->iewInfo[tid].dispatched++;
@@ -1513,26 +1613,38 @@ IEW::writebackInsts()
             // Load Value Prediction: validate at writeback.
             // completeAcc() has already written the actual value to the
             // physical register (see LSQUnit::writeback).
+            // Every destination register is checked.
             if (lvp && inst->isLoad() && inst->lvpPredictionMade) {
-                PhysRegIdPtr destReg = inst->renamedDestIdx(0);
-                RegVal actualValue = cpu->getReg(destReg, tid);
+                LVPValue actualValue;
+                lvp->readDestRegs(inst, cpu, actualValue);
 
-                if (actualValue != inst->lvpPredictedValue) {
+                if (!lvp->validate(inst->seqNum, actualValue)) {
                     DPRINTF(IEW, "[tid:%i] [sn:%llu] LVP misprediction "
-                            "PC %s predicted=%#x actual=%#x\n",
+                            "PC %s actual=%#x (%d words)\n",
                             tid, inst->seqNum, inst->pcState(),
-                            inst->lvpPredictedValue, actualValue);
+                            actualValue.words[0], actualValue.numWords);
 
-                    lvp->validate(inst->seqNum, actualValue);
-                    squashDueToValueMispredict(inst, tid);
                     ++iewStats.valueMispredicts;
+                    recoverValueMispredict(inst, tid, lvp->selectiveReplay());
                 } else {
                     DPRINTF(IEW, "[tid:%i] [sn:%llu] LVP correct "
                             "PC %s value=%#x\n",
                             tid, inst->seqNum, inst->pcState(),
-                            actualValue);
+                            actualValue.words[0]);
+                }
+            }
 
-                    lvp->validate(inst->seqNum, actualValue);
+            // Memory renaming: check the bypassed store data against the
+            // value the load actually read.
+            if (memRenamer && inst->isMemRenamed()) {
+                RegVal actual = cpu->getReg(inst->renamedDestIdx(0), tid);
+                if (!memRenamer->validate(inst, actual)) {
+                    DPRINTF(IEW, "[tid:%i] [sn:%llu] Memory renaming "
+                            "misprediction PC %s actual=%#x\n",
+                            tid, inst->seqNum, inst->pcState(), actual);
+
+                    recoverValueMispredict(inst, tid,
+                                           memRenamer->selectiveReplay());
                 }
             }
 
@@ -1589,6 +1701,10 @@ IEW::tick()
 
         writebackInsts();
 
+        // Keep the CPU ticking until replayed instructions can commit.
+        if (curTick() < replayDoneTick)
+            cpu->activityThisCycle();
+
         // Have the instruction queue try to schedule any ready instructions.
         // (In actuality, this scheduling is for instructions that will
         // be executed next cycle.)
@@ -1681,6 +1797,44 @@ IEW::tick()
     }
 }
 
+bool
+IEW::canSkipCycles()
+{
+    // Nothing to execute, write back or broadcast.
+    if (_status != Inactive || exeStatus != Idle || updateLSQNextCycle ||
+        !instQueue.canSkipCycles()) {
+        return false;
+    }
+
+    for (ThreadID tid : *activeThreads) {
+        // Blocked waits for the IQ, Running and Idle for instructions.
+        if (dispatchStatus[tid] == Blocked) {
+            if (!checkStall(tid)) {
+                return false;
+            }
+        } else if (dispatchStatus[tid] == Running ||
+                   dispatchStatus[tid] == Idle) {
+            if (checkStall(tid) || !insts[tid].empty()) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+IEW::skipCycles(Cycles cycles)
+{
+    for (ThreadID tid : *activeThreads) {
+        iewStats.dispatchStatus[dispatchStatus[tid]] += cycles;
+    }
+
+    instQueue.skipCycles(cycles);
+    instQueue.iqIOStats.intInstQueueReads += cycles;
+}
+
 void
 IEW::updateExeInstStats(const DynInstPtr& inst)
 {
@@ -51,6 +51,7 @@
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/lsq.hh"
 #include "cpu/o3/lvp.hh"
+#include "cpu/o3/mem_rename.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/timebuf.hh"
 #include "debug/IEW.hh"
@@ -193,6 +194,13 @@ class IEW
     /** Sends an instruction to commit through the time buffer. */
     void instToCommit(const DynInstPtr &inst);
 
+    /**
+     * Passes the data a store wrote to the store queue to the memory
+     * renaming unit, and bypasses it to any loads linked to the store.
+     */
+    void storeDataReady(const DynInstPtr &store, const uint8_t *data,
+                        unsigned size);
+
     /** Inserts unused instructions of a thread into the skid buffer. */
     void skidInsert(ThreadID tid);
 
@@ -257,6 +265,26 @@ class IEW
      */
     void squashDueToValueMispredict(const DynInstPtr &inst, ThreadID tid);
 
+    /**
+     * Recovers from a load value misprediction, either by selectively
+     * replaying the load's dependents or, if that is disabled or not
+     * possible, by squashing all younger instructions.
+     */
+    void recoverValueMispredict(const DynInstPtr &inst, ThreadID tid,
+                                bool replay);
+
+    /**
+     * Wakes the dependents of a load whose destination registers hold a
+     * speculative value, before the load executes.
+     */
+    void wakeValuePredicted(const DynInstPtr &inst);
+
+    /**
+     * Writes a store's data to a linked load's destination register and
+     * wakes its dependents, if the load is still waiting in the IQ.
+     */
+    void bypassRenamedLoad(const DynInstPtr &load, RegVal value);
+
     /** Sets Dispatch to blocked, and signals back to other stages to block. */
     void block(ThreadID tid);
 
@@ -302,6 +330,14 @@ class IEW
      */
     void tick();
 
+    /** Would a tick leave IEW unchanged apart from its per-cycle
+     * statistics? */
+    bool canSkipCycles();
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(const DynInstPtr &inst);
@@ -370,6 +406,9 @@ class IEW
     /** Load value predictor (nullptr if disabled). */
     LoadValuePredictor *lvp;
 
+    /** Memory renaming unit (nullptr if disabled). */
+    MemoryRenamer *memRenamer;
+
     /** Vector of pointers to the functional unit pools. */
     std::vector<FUPool *> fuPools;
     /** Records if the LSQ needs to be updated on the next cycle, so that
@@ -386,6 +425,9 @@ class IEW
      */
     bool updatedQueues;
 
+    /** Tick at which the last outstanding value replay completes. */
+    Tick replayDoneTick;
+
     /** Commit to IEW delay. */
     Cycles commitToIEWDelay;
 
@@ -455,6 +497,14 @@ class IEW
         statistics::Scalar memOrderViolationEvents;
         /** Stat for total number of load value misprediction events. */
         statistics::Scalar valueMispredicts;
+        /** Stat for value mispredictions recovered by selective replay. */
+        statistics::Scalar valueMispredReplays;
+        /** Stat for value mispredictions recovered by squashing. */
+        statistics::Scalar valueMispredSquashes;
+        /** Stat for instructions re-executed by selective replay. */
+        statistics::Scalar valueReplayedInsts;
+        /** Stat for instructions squashed by value mispredictions. */
+        statistics::Scalar valueSquashedInsts;
         /** Stat for total number of incorrect predicted taken branches. */
         statistics::Scalar predictedTakenIncorrect;
         /** Stat for total number of incorrect predicted not taken branches. */
@@ -41,7 +41,9 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <algorithm>
 #include <limits>
+#include <unordered_map>
 #include <vector>
 
 #include "base/logging.hh"
@@ -72,7 +74,9 @@ IQUnit::IQUnit(const IQUnitParams &params)
       activeThreads(nullptr),
       _freeEntries(params.numEntries),
       _numEntries(params.numEntries),
-      _fuPool(params.fuPool)
+      _fuPool(params.fuPool),
+      _issueSelect(params.issuePolicy),
+      stats(this)
 {
     assert(_fuPool);
     // Figure out resource sharing policy
@@ -149,6 +153,7 @@ IQUnit::resetState()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         count[tid] = 0;
     }
+    _issueSelect.clear();
 }
 
 void
@@ -191,6 +196,45 @@ IQUnit::numFreeEntries(const DynInstPtr &inst) const
     }
 }
 
+void
+IQUnit::issue(int slot, Cycles now)
+{
+    const OpClass op_class = _issueSelect.inst(slot)->opClass();
+    const Cycles delay = now - _issueSelect.readyCycle(slot);
+
+    stats.issued[op_class]++;
+    stats.issueDelay[op_class] += delay;
+    stats.issueDelayDist.sample(delay);
+
+    _issueSelect.remove(slot);
+}
+
+IQUnit::IQUnitStats::IQUnitStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(issued, statistics::units::Count::get(),
+               "Number of instructions issued per op class"),
+      ADD_STAT(issueDelay, statistics::units::Cycle::get(),
+               "Total cycles from ready to issue per op class"),
+      ADD_STAT(avgIssueDelay, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average cycles from ready to issue per op class",
+               issueDelay / issued),
+      ADD_STAT(issueDelayDist, statistics::units::Cycle::get(),
+               "Distribution of the cycles from ready to issue")
+{
+    issued.init(enums::Num_OpClass).flags(statistics::total |
+                                          statistics::nozero);
+    issueDelay.init(enums::Num_OpClass).flags(statistics::total |
+                                              statistics::nozero);
+    avgIssueDelay.flags(statistics::total | statistics::nozero);
+    for (int i = 0; i < enums::Num_OpClass; i++) {
+        issued.subname(i, enums::OpClassStrings[i]);
+        issueDelay.subname(i, enums::OpClassStrings[i]);
+        avgIssueDelay.subname(i, enums::OpClassStrings[i]);
+    }
+    issueDelayDist.init(0, 31, 1).flags(statistics::pdf);
+}
+
 InstructionQueue::FUCompletion::FUCompletion(const DynInstPtr &_inst,
                                              FUPool *fu_pool, int fu_idx,
                                              InstructionQueue *iq_ptr)
@@ -226,6 +270,8 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       iqs(params.instQueues),
+      steeringPolicy(params.iqSteeringPolicy),
+      interClusterBypassLatency(params.interClusterBypassLatency),
       numThreads(params.numThreads),
       totalWidth(params.issueWidth),
       commitToIEWDelay(params.commitToIEWDelay),
@@ -251,6 +297,13 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
+    replayReadyTick.resize(numPhysRegs);
+
+    // Every instruction in the IQ is also in the ROB, so the ROB size
+    // bounds the instruction lists.
+    for (ThreadID tid = 0; tid < numThreads; tid++)
+        instList[tid].reserve(params.numROBEntries);
+    instsToExecute.reserve(totalWidth);
 
     //Initialize Mem Dependence Units
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
@@ -322,7 +375,14 @@ InstructionQueue::IQStats::IQStats(CPU *cpu, const unsigned &total_width)
                "FU busy rate (busy events/executed inst)"),
       ADD_STAT(loadDepWaitCycles, statistics::units::Cycle::get(),
                "Distribution of cycles a dependent instruction waits "
-               "in the IQ for a load value to resolve")
+               "in the IQ for a load value to resolve"),
+      ADD_STAT(interClusterWakeups, statistics::units::Count::get(),
+               "Number of dependents woken up by a producer in another IQ"),
+      ADD_STAT(dependenceSteered, statistics::units::Count::get(),
+               "Number of instructions steered to the IQ of a producer"),
+      ADD_STAT(replayDelayedInserts, statistics::units::Count::get(),
+               "Number of instructions inserted into the IQ that waited "
+               "for an operand recomputed by a selective replay")
 {
     instsAdded
         .prereq(instsAdded);
@@ -511,6 +571,8 @@ InstructionQueue::resetState()
         iq->resetState();
     }
 
+    bypassDelayed.clear();
+
     // Note that in actuality, the registers corresponding to the logical
     // registers start off as ready.  However this doesn't matter for the
     // IQ as the instruction should have been correctly told if those
@@ -518,20 +580,14 @@ InstructionQueue::resetState()
     // unready.
     for (int i = 0; i < numPhysRegs; ++i) {
         regScoreboard[i] = false;
+        replayReadyTick[i] = 0;
     }
 
     for (ThreadID tid = 0; tid < MaxThreads; ++tid) {
         squashedSeqNum[tid] = 0;
     }
 
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        while (!readyInsts[i].empty())
-            readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
-    }
     nonSpecInsts.clear();
-    listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -650,12 +706,12 @@ InstructionQueue::allFUPools()
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!bypassDelayed.empty()) {
         return true;
     }
 
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
+    for (auto iq : iqs) {
+        if (!iq->issueSelect().empty()) {
             return true;
         }
     }
@@ -666,6 +722,19 @@ InstructionQueue::hasReadyInsts()
 IQUnit *
 InstructionQueue::findIQ(const DynInstPtr &inst)
 {
+    switch (steeringPolicy) {
+      case IQSteeringPolicy::Dependence:
+        if (IQUnit *iq = producerIQ(inst)) {
+            ++iqStats.dependenceSteered;
+            return iq;
+        }
+        [[fallthrough]];
+      case IQSteeringPolicy::LoadBalance:
+        return leastLoadedIQ(inst);
+      default:
+        break;
+    }
+
     for (auto iq : iqs) {
         // If the IQ can store the selected instruction,
         // return the IQ as valid
@@ -676,6 +745,47 @@ InstructionQueue::findIQ(const DynInstPtr &inst)
     return nullptr;
 }
 
+IQUnit *
+InstructionQueue::leastLoadedIQ(const DynInstPtr &inst)
+{
+    IQUnit *best = nullptr;
+    unsigned best_free = 0;
+    for (auto iq : iqs) {
+        unsigned free_entries = iq->numFreeEntries(inst);
+        if (free_entries > best_free) {
+            best = iq;
+            best_free = free_entries;
+        }
+    }
+    return best;
+}
+
+IQUnit *
+InstructionQueue::producerIQ(const DynInstPtr &inst)
+{
+    // Follow the first operand still being produced; its producer's
+    // cluster is the one where the value becomes available first.
+    for (int src_reg_idx = 0; src_reg_idx < inst->numSrcRegs();
+         src_reg_idx++) {
+        if (inst->readySrcIdx(src_reg_idx)) {
+            continue;
+        }
+
+        PhysRegIdPtr src_reg = inst->renamedSrcIdx(src_reg_idx);
+        if (src_reg->isAlwaysReady() || regScoreboard[src_reg->flatIndex()]) {
+            continue;
+        }
+
+        const DynInstPtr &producer =
+            dependGraph.getInst(src_reg->flatIndex());
+        if (producer && producer->clusterIQ &&
+            producer->clusterIQ->numFreeEntries(inst) > 0) {
+            return producer->clusterIQ;
+        }
+    }
+    return nullptr;
+}
+
 void
 InstructionQueue::insert(const DynInstPtr &new_inst)
 {
@@ -704,6 +814,10 @@ InstructionQueue::insert(const DynInstPtr &new_inst)
     // dependencies.
     addToDependents(new_inst);
 
+    // Renamed consumers still in the skid buffer or on their way from
+    // rename when a replay started have not been seen by it.
+    waitForReplayedSrcs(new_inst);
+
     // Have this instruction set itself as the producer of its destination
     // register(s).
     addToProducers(new_inst);
@@ -783,57 +897,6 @@ InstructionQueue::getInstToExecute()
     return inst;
 }
 
-void
-InstructionQueue::addToOrderList(OpClass op_class)
-{
-    assert(!readyInsts[op_class].empty());
-
-    ListOrderEntry queue_entry;
-
-    queue_entry.queueType = op_class;
-
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
-
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
-
-        list_it++;
-    }
-
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
-}
-
-void
-InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
-{
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
-    }
-
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
-}
-
 void
 InstructionQueue::processFUCompletion(const DynInstPtr &inst, FUPool *fu_pool,
                                       int fu_idx)
@@ -878,24 +941,41 @@ InstructionQueue::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
-    // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
-    // This will avoid trying to schedule a certain op class if there are no
-    // FUs that handle it.
+    // While the issue bandwidth is not exceeded, ask the IQs for the
+    // instruction their issue policy selects next and consider the oldest
+    // offer first. Try to get a FU that can do what this op needs.
+    // If no FU is free, exclude the op class in that IQ for the rest of
+    // the cycle. This will avoid trying to schedule a certain op class
+    // if there are no FUs that handle it.
+    processBypassDelayed();
+
+    const Cycles now = cpu->curCycle();
+    for (auto iq : iqs) {
+        iq->issueSelect().beginCycle();
+    }
+
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth) {
+        IQUnit *iq = nullptr;
+        int slot = -1;
+        for (auto candidate_iq : iqs) {
+            IssueSelect &select = candidate_iq->issueSelect();
+            int candidate = select.select();
+            if (candidate >= 0 &&
+                (!iq || select.inst(candidate)->seqNum <
+                        iq->issueSelect().inst(slot)->seqNum)) {
+                iq = candidate_iq;
+                slot = candidate;
+            }
+        }
 
-        assert(!readyInsts[op_class].empty());
+        if (!iq) {
+            break;
+        }
 
-        DynInstPtr issuing_inst = readyInsts[op_class].top();
+        DynInstPtr issuing_inst = iq->issueSelect().inst(slot);
+        OpClass op_class = issuing_inst->opClass();
 
         if (issuing_inst->isFloating()) {
             iqIOStats.fpInstQueueReads++;
@@ -905,25 +985,23 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            iq->issueSelect().remove(slot);
 
             ++iqStats.squashedInstsIssued;
 
             continue;
         }
 
+        // A selective replay may have delayed an operand of an
+        // instruction that was already selectable.
+        if (issuing_inst->bypassReadyCycle > now) {
+            iq->issueSelect().remove(slot);
+            addToReadyList(issuing_inst);
+            continue;
+        }
+        assert(replayedSrcsReady(issuing_inst) <= curTick());
+
         ThreadID tid = issuing_inst->threadNumber;
 
         // Check for trivial computation simplification before FU allocation.
@@ -939,27 +1017,17 @@ InstructionQueue::scheduleReadyInsts()
             i2e_info->size++;
             instsToExecute.push_back(issuing_inst);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            iq->issue(slot, now);
 
             issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
             issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
             if (issuing_inst->firstIssue == -1)
                 issuing_inst->firstIssue = curTick();
 
             issuing_inst->clearInIQ();
 
-            listOrder.erase(order_it++);
             iqStats.issuedInstType[tid][op_class]++;
 
             continue;
@@ -968,8 +1036,7 @@ InstructionQueue::scheduleReadyInsts()
         int idx = FUPool::NoNeedFU;
         Cycles op_latency = Cycles(1);
 
-        IQUnit *iq = issuing_inst->iq;
-        assert(iq);
+        assert(issuing_inst->iq == iq);
         auto fu_pool = iq->fuPool();
         if (op_class != No_OpClass) {
             idx = fu_pool->getUnit(op_class);
@@ -981,7 +1048,7 @@ InstructionQueue::scheduleReadyInsts()
                 iqIOStats.intAluAccesses++;
             }
             if (idx > FUPool::NoFreeFU) {
-                op_latency = fu_pool->getOpLatency(op_class);
+                op_latency = fu_pool->getOpLatency(issuing_inst);
             }
         }
 
@@ -1032,21 +1099,12 @@ InstructionQueue::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            iq->issue(slot, now);
 
             issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
             issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
 
             if (issuing_inst->firstIssue == -1)
                 issuing_inst->firstIssue = curTick();
@@ -1059,13 +1117,12 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.issuedInstType[tid][op_class]++;
         } else {
             assert(idx == FUPool::NoFreeFU);
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            iq->issueSelect().exclude(op_class);
         }
     }
 
@@ -1083,6 +1140,19 @@ InstructionQueue::scheduleReadyInsts()
     }
 }
 
+bool
+InstructionQueue::canSkipCycles()
+{
+    return !hasReadyInsts() && retryMemInsts.empty() &&
+           deferredMemInsts.empty();
+}
+
+void
+InstructionQueue::skipCycles(Cycles cycles)
+{
+    iqStats.numIssuedDist.sample(0, cycles);
+}
+
 void
 InstructionQueue::scheduleNonSpec(const InstSeqNum &inst)
 {
@@ -1214,6 +1284,16 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
             // graph entries would need to hold the src_reg_idx.
             dep_inst->markSrcRegReady();
 
+            // Results crossing clusters pay the bypass latency before
+            // the consumer may be selected.
+            if (completed_inst->clusterIQ &&
+                dep_inst->clusterIQ != completed_inst->clusterIQ) {
+                ++iqStats.interClusterWakeups;
+                dep_inst->bypassReadyCycle = std::max(
+                    dep_inst->bypassReadyCycle,
+                    cpu->curCycle() + interClusterBypassLatency);
+            }
+
             // Sample how long this dependent waited for a load value.
             if (completed_inst->isLoad() &&
                 dep_inst->iqInsertTick != (Tick)-1) {
@@ -1243,6 +1323,125 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
     return dependents;
 }
 
+Cycles
+InstructionQueue::replayLatency(const DynInstPtr &inst)
+{
+    OpClass op_class = inst->opClass();
+    if (op_class == No_OpClass)
+        return Cycles(1);
+
+    for (auto iq : iqs) {
+        if (iq->fuPool()->isCapable(op_class))
+            return std::max(Cycles(1), iq->fuPool()->getOpLatency(op_class));
+    }
+    return Cycles(1);
+}
+
+int
+InstructionQueue::replayDependents(const DynInstPtr &load, Tick &done_tick)
+{
+    ThreadID tid = load->threadNumber;
+
+    // Tick at which the corrected value of each poisoned register (by
+    // flat index) is available. The load's own registers already hold
+    // the correct value.
+    std::unordered_map<RegIndex, Tick> poisoned;
+    for (int i = 0; i < load->numDestRegs(); i++) {
+        PhysRegIdPtr reg = load->renamedDestIdx(i);
+        if (!reg->isAlwaysReady())
+            poisoned[reg->flatIndex()] = curTick();
+    }
+
+    ListIt it = std::find_if(instList[tid].begin(), instList[tid].end(),
+        [&load](const DynInstPtr &inst)
+        { return inst->seqNum > load->seqNum; });
+
+    // Walk the younger instructions in program order, so producers are
+    // always visited before their consumers, and collect the ones that
+    // consumed a wrong value. Nothing is modified until all of them are
+    // known to be replayable.
+    std::vector<std::pair<DynInstPtr, Tick>> to_replay;
+    for (; it != instList[tid].end(); ++it) {
+        const DynInstPtr &inst = *it;
+        if (inst->isSquashed())
+            continue;
+
+        bool dependent = false;
+        Tick src_ready = curTick();
+        for (int i = 0; i < inst->numSrcRegs(); i++) {
+            PhysRegIdPtr reg = inst->renamedSrcIdx(i);
+            if (reg->isAlwaysReady())
+                continue;
+            auto p = poisoned.find(reg->flatIndex());
+            if (p != poisoned.end()) {
+                dependent = true;
+                src_ready = std::max(src_ready, p->second);
+            }
+        }
+
+        if (!dependent)
+            continue;
+
+        // A memory reference that has issued may have used a wrong
+        // address or store data, and an executed control instruction may
+        // have redirected fetch; neither is recovered by re-execution.
+        if ((inst->isMemRef() && inst->isIssued()) ||
+            (inst->isControl() && inst->isExecuted()) ||
+            (inst->isExecuted() && (inst->isNonSpeculative() ||
+                                    inst->getFault() != NoFault))) {
+            DPRINTF(IQ, "[sn:%llu] cannot be replayed, squashing after "
+                    "[sn:%llu]\n", inst->seqNum, load->seqNum);
+            return -1;
+        }
+
+        // Not yet issued: it will read the corrected values itself, but
+        // must not issue before the replays producing them complete.
+        if (!inst->isIssued()) {
+            delayIssueUntil(inst, src_ready);
+            continue;
+        }
+
+        // Issued but not executed yet, it executes with the corrected
+        // values; only its completion is delayed.
+        Tick done = src_ready + cpu->cyclesToTicks(replayLatency(inst));
+        for (int i = 0; i < inst->numDestRegs(); i++) {
+            PhysRegIdPtr reg = inst->renamedDestIdx(i);
+            if (!reg->isAlwaysReady())
+                poisoned[reg->flatIndex()] = done;
+        }
+        to_replay.emplace_back(inst, done);
+    }
+
+    // Instructions not in the IQ yet wait for these registers when they
+    // are inserted.
+    for (auto &[reg, ready] : poisoned)
+        replayReadyTick[reg] = std::max(replayReadyTick[reg], ready);
+
+    int replayed = 0;
+    done_tick = curTick();
+    for (auto &[inst, done] : to_replay) {
+        inst->replayDoneTick = std::max(inst->replayDoneTick, done);
+        done_tick = std::max(done_tick, done);
+        if (!inst->isExecuted())
+            continue;
+
+        DPRINTF(IQ, "Replaying [sn:%llu] PC %s, dependent of mispredicted "
+                "load [sn:%llu], done at tick %llu\n", inst->seqNum,
+                inst->pcState(), load->seqNum, done);
+        ++replayed;
+        if (inst->reexecute() != NoFault) {
+            // The fault stays with the instruction and is taken at
+            // commit, which squashes everything younger.
+            DPRINTF(IQ, "Replay of [sn:%llu] faulted\n", inst->seqNum);
+            break;
+        }
+        if (!inst->readPredicate())
+            inst->forwardOldRegs();
+    }
+
+    return replayed;
+}
+
 void
 InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
@@ -1250,17 +1449,7 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 
     assert(op_class < Num_OpClasses);
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    addToReadyList(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1516,13 +1705,6 @@ InstructionQueue::doSquash(ThreadID tid)
     }
 }
 
-bool
-InstructionQueue::PqCompare::operator()(
-        const DynInstPtr &lhs, const DynInstPtr &rhs) const
-{
-    return lhs->seqNum > rhs->seqNum;
-}
-
 bool
 InstructionQueue::addToDependents(const DynInstPtr &new_inst)
 {
@@ -1570,6 +1752,40 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
     return return_val;
 }
 
+Tick
+InstructionQueue::replayedSrcsReady(const DynInstPtr &inst)
+{
+    Tick ready = 0;
+    for (int i = 0; i < inst->numSrcRegs(); i++) {
+        PhysRegIdPtr reg = inst->renamedSrcIdx(i);
+        if (!reg->isAlwaysReady())
+            ready = std::max(ready, replayReadyTick[reg->flatIndex()]);
+    }
+    return ready;
+}
+
+void
+InstructionQueue::waitForReplayedSrcs(const DynInstPtr &inst)
+{
+    Tick ready = replayedSrcsReady(inst);
+    if (ready > curTick()) {
+        DPRINTF(IQ, "Instruction [sn:%llu] waits for a replayed operand "
+                "until tick %llu.\n", inst->seqNum, ready);
+        delayIssueUntil(inst, ready);
+        ++iqStats.replayDelayedInserts;
+    }
+}
+
+void
+InstructionQueue::delayIssueUntil(const DynInstPtr &inst, Tick ready)
+{
+    if (ready <= curTick())
+        return;
+
+    Cycles cycle = cpu->curCycle() + cpu->ticksToCycles(ready - curTick());
+    inst->bypassReadyCycle = std::max(inst->bypassReadyCycle, cycle);
+}
+
 void
 InstructionQueue::addToProducers(const DynInstPtr &new_inst)
 {
@@ -1602,6 +1818,9 @@ InstructionQueue::addToProducers(const DynInstPtr &new_inst)
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
+
+        // The register holds a new value, not a replayed one.
+        replayReadyTick[dest_reg->flatIndex()] = 0;
     }
 }
 
@@ -1632,29 +1851,75 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+        addToReadyList(inst);
+    }
+}
+
+void
+InstructionQueue::addToReadyList(const DynInstPtr &inst)
+{
+    IQUnit *iq = inst->iq;
+    assert(iq);
+
+    if (inst->bypassReadyCycle > cpu->curCycle()) {
+        DPRINTF(IQ, "Instruction [sn:%llu] waits for a forwarded or "
+                "replayed operand until cycle %llu.\n", inst->seqNum,
+                (uint64_t)inst->bypassReadyCycle);
+        bypassDelayed.push_back(inst);
+        return;
+    }
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
+    // An instruction is on the critical path if others wait for it.
+    bool critical = false;
+    for (int dest_reg_idx = 0; dest_reg_idx < inst->numDestRegs();
+         dest_reg_idx++) {
+        PhysRegIdPtr dest_reg = inst->renamedDestIdx(dest_reg_idx);
+        if (!dest_reg->isAlwaysReady() &&
+            !dependGraph.empty(dest_reg->flatIndex())) {
+            critical = true;
+            break;
+        }
+    }
+
+    iq->issueSelect().insert(inst, critical, cpu->curCycle());
+}
+
+void
+InstructionQueue::processBypassDelayed()
+{
+    const Cycles now = cpu->curCycle();
+    std::vector<DynInstPtr> waiting;
+    std::vector<DynInstPtr> arrived;
+    for (const auto &inst : bypassDelayed) {
+        if (inst->isSquashed()) {
+            continue;
+        }
+        if (inst->bypassReadyCycle <= now) {
+            arrived.push_back(inst);
+        } else {
+            waiting.push_back(inst);
         }
     }
+    bypassDelayed.swap(waiting);
+
+    for (const auto &inst : arrived) {
+        addToReadyList(inst);
+    }
 }
 
 void
 InstructionQueue::dumpLists()
 {
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+    for (auto iq : iqs) {
+        cprintf("%s ready list size: %i\n", iq->name(),
+                iq->issueSelect().size());
 
         cprintf("\n");
     }
 
+    cprintf("Inter-cluster bypass wait list size: %i\n",
+            bypassDelayed.size());
+
     cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
 
     NonSpecMapIt non_spec_it = nonSpecInsts.begin();
@@ -1670,18 +1935,12 @@ InstructionQueue::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
-    cprintf("List order: ");
+    cprintf("Ready instructions: ");
 
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
+    for (auto iq : iqs) {
+        iq->issueSelect().forEach([](const DynInstPtr &inst) {
+            cprintf("OpClass:%i [sn:%llu] ", inst->opClass(), inst->seqNum);
+        });
     }
 
     cprintf("\n");
@@ -44,20 +44,23 @@
 
 #include <list>
 #include <map>
-#include <queue>
 #include <vector>
 
+#include "base/pooled_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/issue_select.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQSteeringPolicy.hh"
+#include "enums/IssuePolicy.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -133,6 +136,17 @@ class IQUnit : public SimObject
         return _fuPool;
     }
 
+    /** The select logic holding the ready instructions of this IQ. */
+    IssueSelect &
+    issueSelect()
+    {
+        return _issueSelect;
+    }
+
+    /** Removes an issued instruction from the select logic and records
+     * its issue delay. */
+    void issue(int slot, Cycles now);
+
   private:
     /** IQ sharing policy for SMT. */
     SMTQueuePolicy iqPolicy;
@@ -157,6 +171,23 @@ class IQUnit : public SimObject
 
     /** Function unit pool. */
     FUPool *_fuPool;
+
+    /** Select logic of the ready instructions. */
+    IssueSelect _issueSelect;
+
+    struct IQUnitStats : public statistics::Group
+    {
+        IQUnitStats(statistics::Group *parent);
+
+        /** Number of instructions issued per op class. */
+        statistics::Vector issued;
+        /** Total cycles from ready to issue per op class. */
+        statistics::Vector issueDelay;
+        /** Average cycles from ready to issue per op class. */
+        statistics::Formula avgIssueDelay;
+        /** Distribution of the cycles from ready to issue. */
+        statistics::Distribution issueDelayDist;
+    } stats;
 };
 
 /**
@@ -271,7 +302,8 @@ class InstructionQueue
     /** Returns if there are any ready instructions in the IQ. */
     bool hasReadyInsts();
 
-    /** Find a compatible IQ (e.g. to insert the instruction) */
+    /** Find a compatible IQ (e.g. to insert the instruction) following
+     * the steering policy. */
     IQUnit *findIQ(const DynInstPtr &inst);
 
     /** Inserts a new instruction into the IQ. */
@@ -315,11 +347,18 @@ class InstructionQueue
                              int fu_idx);
 
     /**
-     * Schedules ready instructions, adding the ready ones (oldest first) to
-     * the queue to execute.
+     * Schedules ready instructions, adding the ones selected by the issue
+     * policies of the IQs to the queue to execute.
      */
     void scheduleReadyInsts();
 
+    /** Would scheduleReadyInsts() find nothing to do? */
+    bool canSkipCycles();
+
+    /** Accounts the statistics of cycles in which the CPU skipped
+     * scheduleReadyInsts() because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
     /** Schedules a single specific non-speculative instruction. */
     void scheduleNonSpec(const InstSeqNum &inst);
 
@@ -332,6 +371,23 @@ class InstructionQueue
     /** Wakes all dependents of a completed instruction. */
     int wakeDependents(const DynInstPtr &completed_inst);
 
+    /**
+     * Selectively replays the instructions that consumed the mispredicted
+     * value of a load, directly or transitively. Dependents that already
+     * executed are re-executed in program order; those that have not yet
+     * executed will read the corrected values. Replays are timed along the
+     * dependence chain and hold the replayed instructions at commit, and
+     * dependents that have not issued yet wait for the replayed values,
+     * including those inserted into the IQ after the replay started.
+     * A replay that faults leaves the fault to commit and ends the replay.
+     * @param load The load whose value was mispredicted.
+     * @param done_tick Output: tick at which the last replay completes.
+     * @return The number of re-executed instructions, or -1 if a dependent
+     * (an issued memory reference or an executed control instruction)
+     * cannot be replayed and the younger instructions must be squashed.
+     */
+    int replayDependents(const DynInstPtr &load, Tick &done_tick);
+
     /** Adds a ready memory instruction to the ready list. */
     void addReadyMemInst(const DynInstPtr &ready_inst);
 
@@ -397,6 +453,18 @@ class InstructionQueue
     /** List of Instruction Queues */
     std::vector<IQUnit *> iqs;
 
+    /** Policy steering dispatched instructions to one of the IQs. */
+    IQSteeringPolicy steeringPolicy;
+
+    /** Extra wakeup latency between a producer and a consumer
+     * dispatched to different IQs. */
+    const Cycles interClusterBypassLatency;
+
+    /** Ready instructions waiting for an operand forwarded from
+     * another cluster or recomputed by a selective replay before they
+     * can be selected. */
+    std::vector<DynInstPtr> bypassDelayed;
+
     /** The memory dependence unit, which tracks/predicts memory dependences
      *  between instructions.
      */
@@ -417,44 +485,27 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  The lists below recycle their nodes; the per-thread instruction
+     *  lists are preallocated to the ROB size.
+     */
+    PooledList<DynInstPtr> instList[MaxThreads];
 
     /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    PooledList<DynInstPtr> instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
      */
-    std::list<DynInstPtr> deferredMemInsts;
+    PooledList<DynInstPtr> deferredMemInsts;
 
     /** List of instructions that have been cache blocked. */
-    std::list<DynInstPtr> blockedMemInsts;
+    PooledList<DynInstPtr> blockedMemInsts;
 
     /** List of instructions that were cache blocked, but a retry has been seen
      * since, so they can now be retried. May fail again go on the blocked list.
      */
-    std::list<DynInstPtr> retryMemInsts;
-
-    /**
-     * Struct for comparing entries to be added to the priority queue.
-     * This gives reverse ordering to the instructions in terms of
-     * sequence numbers: the instructions with smaller sequence
-     * numbers (and hence are older) will be at the top of the
-     * priority queue.
-     */
-    struct PqCompare
-    {
-        bool operator()(const DynInstPtr &lhs, const DynInstPtr &rhs) const;
-    };
-
-    typedef std::priority_queue<
-        DynInstPtr, std::vector<DynInstPtr>, PqCompare> ReadyInstQueue;
-
-    /** List of ready instructions, per op class.  They are separated by op
-     *  class to allow for easy mapping to FUs.
-     */
-    ReadyInstQueue readyInsts[Num_OpClasses];
+    PooledList<DynInstPtr> retryMemInsts;
 
     /** List of non-speculative instructions that will be scheduled
      *  once the IQ gets a signal from commit.  While it's redundant to
@@ -467,41 +518,6 @@ class InstructionQueue
 
     typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry
-    {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
-
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
-     */
-    std::list<ListOrderEntry> listOrder;
-
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
-
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
-
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
-     */
-    ListOrderIt readyIt[Num_OpClasses];
-
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
-
-    /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
-     */
-    void moveToYoungerInst(ListOrderIt age_order_it);
-
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
@@ -536,15 +552,47 @@ class InstructionQueue
      */
     std::vector<bool> regScoreboard;
 
+    /** Tick at which a selective replay finishes recomputing each
+     * physical register, 0 if the register is not being replayed. */
+    std::vector<Tick> replayReadyTick;
+
     /** Adds an instruction to the dependency graph, as a consumer. */
     bool addToDependents(const DynInstPtr &new_inst);
 
+    /** Returns the tick at which the replays recomputing the source
+     * registers of an instruction complete. */
+    Tick replayedSrcsReady(const DynInstPtr &inst);
+
+    /** Keeps an instruction from issuing until the replays recomputing
+     * its source registers complete. */
+    void waitForReplayedSrcs(const DynInstPtr &inst);
+
+    /** Keeps an instruction from issuing before the given tick. */
+    void delayIssueUntil(const DynInstPtr &inst, Tick ready);
+
     /** Adds an instruction to the dependency graph, as a producer. */
     void addToProducers(const DynInstPtr &new_inst);
 
     /** Moves an instruction to the ready queue if it is ready. */
     void addIfReady(const DynInstPtr &inst);
 
+    /** Hands a ready instruction to the select logic of its IQ. */
+    void addToReadyList(const DynInstPtr &inst);
+
+    /** Hands the instructions whose delayed operands have arrived to
+     * the select logic. */
+    void processBypassDelayed();
+
+    /** Returns the least occupied IQ able to hold the instruction. */
+    IQUnit *leastLoadedIQ(const DynInstPtr &inst);
+
+    /** Returns the IQ of the producer of an outstanding operand of the
+     * instruction, if it can hold the instruction. */
+    IQUnit *producerIQ(const DynInstPtr &inst);
+
+    /** Execution latency charged to an instruction when replayed. */
+    Cycles replayLatency(const DynInstPtr &inst);
+
     /** Debugging function to dump all the list sizes, as well as print
      *  out the list of nonspeculative instructions.  Should not be used
      *  in any other capacity, but it has no harmful sideaffects.
@@ -621,6 +669,14 @@ class InstructionQueue
         /** Distribution of cycles a dependent instruction waits in the
          *  IQ for a load value to resolve. */
         statistics::Distribution loadDepWaitCycles;
+
+        /** Number of wakeups crossing from one IQ cluster to another. */
+        statistics::Scalar interClusterWakeups;
+        /** Number of instructions steered to the IQ of a producer. */
+        statistics::Scalar dependenceSteered;
+        /** Number of instructions inserted into the IQ that waited for
+         * an operand being recomputed by a selective replay. */
+        statistics::Scalar replayDelayedInserts;
     } iqStats;
 
    public:
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/o3/issue_select.hh"
+
+#include <cassert>
+
+#include "base/logging.hh"
+#include "cpu/o3/dyn_inst.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+IssueSelect::IssueSelect(IssuePolicy _policy)
+    : policy(_policy), words(0), numReady(0),
+      rng(Random::genRandom())
+{
+    grow();
+}
+
+void
+IssueSelect::clear()
+{
+    for (unsigned w = 0; w < words; w++) {
+        for (uint64_t bits = ready[w]; bits; bits &= bits - 1) {
+            insts[w * 64 + findLsbSet(bits)] = nullptr;
+        }
+        ready[w] = 0;
+        excluded[w] = 0;
+        priority[w] = 0;
+    }
+    numReady = 0;
+}
+
+void
+IssueSelect::grow()
+{
+    const unsigned old_words = words;
+    const unsigned slots = (words + 1) * 64;
+
+    Mask new_older(slots * (words + 1), 0);
+    for (unsigned s = 0; s < old_words * 64; s++) {
+        for (unsigned w = 0; w < old_words; w++) {
+            new_older[s * (words + 1) + w] = older[s * old_words + w];
+        }
+    }
+    older.swap(new_older);
+    words++;
+
+    insts.resize(slots);
+    seqNums.resize(slots, 0);
+    opClasses.resize(slots, No_OpClass);
+    readyCycles.resize(slots, Cycles(0));
+    ready.resize(words, 0);
+    excluded.resize(words, 0);
+    priority.resize(words, 0);
+    candidates.resize(words, 0);
+    preferred.resize(words, 0);
+}
+
+void
+IssueSelect::insert(const DynInstPtr &inst, bool critical, Cycles now)
+{
+    // Find a free slot
+    unsigned w = 0;
+    while (w < words && ready[w] == ~0ULL) {
+        w++;
+    }
+    if (w == words) {
+        grow();
+    }
+    const unsigned slot = w * 64 + findLsbSet(~ready[w]);
+    const uint64_t bit = 1ULL << (slot % 64);
+
+    insts[slot] = inst;
+    seqNums[slot] = inst->seqNum;
+    opClasses[slot] = inst->opClass();
+    readyCycles[slot] = now;
+
+    // Update the age matrix: the row of the new slot gets all older ready
+    // instructions, and the new slot becomes older than the younger ones.
+    uint64_t *row = &older[slot * words];
+    for (unsigned i = 0; i < words; i++) {
+        row[i] = 0;
+        for (uint64_t bits = ready[i]; bits; bits &= bits - 1) {
+            const unsigned other = i * 64 + findLsbSet(bits);
+            uint64_t &other_word = older[other * words + w];
+            if (seqNums[other] < inst->seqNum) {
+                row[i] |= 1ULL << (other % 64);
+                other_word &= ~bit;
+            } else {
+                other_word |= bit;
+            }
+        }
+    }
+
+    bool prio = false;
+    switch (policy) {
+      case IssuePolicy::LoadFirst:
+        prio = inst->isLoad();
+        break;
+      case IssuePolicy::CriticalPath:
+        prio = critical;
+        break;
+      default:
+        break;
+    }
+
+    ready[w] |= bit;
+    excluded[w] &= ~bit;
+    priority[w] = prio ? (priority[w] | bit) : (priority[w] & ~bit);
+    numReady++;
+}
+
+void
+IssueSelect::beginCycle()
+{
+    for (unsigned w = 0; w < words; w++) {
+        excluded[w] = 0;
+    }
+}
+
+void
+IssueSelect::remove(int slot)
+{
+    const unsigned w = slot / 64;
+    const uint64_t bit = 1ULL << (slot % 64);
+    assert(ready[w] & bit);
+
+    ready[w] &= ~bit;
+    excluded[w] &= ~bit;
+    priority[w] &= ~bit;
+    insts[slot] = nullptr;
+    numReady--;
+}
+
+void
+IssueSelect::exclude(OpClass op_class)
+{
+    for (unsigned w = 0; w < words; w++) {
+        for (uint64_t bits = ready[w] & ~excluded[w]; bits;
+             bits &= bits - 1) {
+            const unsigned slot = w * 64 + findLsbSet(bits);
+            if (opClasses[slot] == op_class) {
+                excluded[w] |= 1ULL << (slot % 64);
+            }
+        }
+    }
+}
+
+bool
+IssueSelect::combine(Mask &dst, const Mask &a, const Mask &b,
+                     const Mask *c) const
+{
+    uint64_t any = 0;
+    for (unsigned w = 0; w < words; w++) {
+        dst[w] = a[w] & b[w] & (c ? ~(*c)[w] : ~0ULL);
+        any |= dst[w];
+    }
+    return any != 0;
+}
+
+int
+IssueSelect::oldest(const Mask &mask) const
+{
+    for (unsigned w = 0; w < words; w++) {
+        for (uint64_t bits = mask[w]; bits; bits &= bits - 1) {
+            const unsigned slot = w * 64 + findLsbSet(bits);
+            const uint64_t *row = &older[slot * words];
+            uint64_t conflict = 0;
+            for (unsigned i = 0; i < words; i++) {
+                conflict |= row[i] & mask[i];
+            }
+            if (!conflict) {
+                return slot;
+            }
+        }
+    }
+    panic("No oldest instruction found in the issue select age matrix");
+}
+
+int
+IssueSelect::random(const Mask &mask)
+{
+    unsigned count = 0;
+    for (unsigned w = 0; w < words; w++) {
+        count += popCount(mask[w]);
+    }
+
+    unsigned n = rng->random<unsigned>(0, count - 1);
+    for (unsigned w = 0; w < words; w++) {
+        const unsigned in_word = popCount(mask[w]);
+        if (n >= in_word) {
+            n -= in_word;
+            continue;
+        }
+        uint64_t bits = mask[w];
+        for (; n > 0; n--) {
+            bits &= bits - 1;
+        }
+        return w * 64 + findLsbSet(bits);
+    }
+    panic("No instruction found in the issue select mask");
+}
+
+int
+IssueSelect::select()
+{
+    if (!combine(candidates, ready, ready, &excluded)) {
+        return -1;
+    }
+
+    switch (policy) {
+      case IssuePolicy::Random:
+        return random(candidates);
+      case IssuePolicy::LoadFirst:
+      case IssuePolicy::CriticalPath:
+        if (combine(preferred, candidates, priority, nullptr)) {
+            return oldest(preferred);
+        }
+        return oldest(candidates);
+      default:
+        return oldest(candidates);
+    }
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_O3_ISSUE_SELECT_HH__
+#define __CPU_O3_ISSUE_SELECT_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/random.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/op_class.hh"
+#include "enums/IssuePolicy.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Select logic of an IQ unit. Ready instructions are kept in slots and
+ * the scheduling state is held in bit vectors over the slots: the ready
+ * set, the set of slots excluded for the rest of the cycle (their FU is
+ * busy), a priority set, and an age matrix where row s has the bits of
+ * all slots holding older instructions. The oldest instruction of a set
+ * is the one whose row does not intersect the set, which replaces the
+ * walk over the age ordered list of ready queues.
+ *
+ * The issue policy decides which ready instruction is offered next:
+ * - OldestFirst: the oldest ready instruction.
+ * - LoadFirst: the oldest ready load, otherwise the oldest instruction.
+ * - CriticalPath: the oldest ready instruction with dependents waiting
+ *   in the IQ, otherwise the oldest instruction.
+ * - Random: a random ready instruction.
+ */
+class IssueSelect
+{
+  public:
+    IssueSelect(IssuePolicy policy);
+
+    /** Removes all instructions. */
+    void clear();
+
+    /**
+     * Adds an instruction that is ready to issue.
+     * @param inst The ready instruction.
+     * @param critical Whether other instructions wait for its result.
+     * @param now The current cycle, used for the issue delay.
+     */
+    void insert(const DynInstPtr &inst, bool critical, Cycles now);
+
+    /** Returns if no instruction is ready. */
+    bool empty() const { return numReady == 0; }
+
+    /** Returns the number of ready instructions. */
+    unsigned size() const { return numReady; }
+
+    /** Makes all ready instructions selectable again. Called at the
+     * start of every issue cycle. */
+    void beginCycle();
+
+    /**
+     * Returns the slot of the instruction the policy offers next or -1
+     * if no selectable instruction is left in this cycle.
+     */
+    int select();
+
+    /** Removes the instruction of a slot (issued or squashed). */
+    void remove(int slot);
+
+    /** Excludes all instructions of an op class for the rest of the
+     * cycle. */
+    void exclude(OpClass op_class);
+
+    const DynInstPtr &inst(int slot) const { return insts[slot]; }
+    Cycles readyCycle(int slot) const { return readyCycles[slot]; }
+
+    /** Calls a function for every ready instruction. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (unsigned w = 0; w < words; w++) {
+            for (uint64_t bits = ready[w]; bits; bits &= bits - 1) {
+                f(insts[w * 64 + findLsbSet(bits)]);
+            }
+        }
+    }
+
+  private:
+    typedef std::vector<uint64_t> Mask;
+
+    /** Grows the capacity by 64 slots. */
+    void grow();
+
+    /** Returns the oldest slot of a non-empty mask. */
+    int oldest(const Mask &mask) const;
+
+    /** Returns a random slot of a non-empty mask. */
+    int random(const Mask &mask);
+
+    /** Sets dst to (a & b & ~c), c being optional, and returns whether
+     * the result is not empty. */
+    bool combine(Mask &dst, const Mask &a, const Mask &b,
+                 const Mask *c) const;
+
+    const IssuePolicy policy;
+
+    /** Number of 64-bit words per bit vector. */
+    unsigned words;
+
+    unsigned numReady;
+
+    std::vector<DynInstPtr> insts;
+    std::vector<InstSeqNum> seqNums;
+    std::vector<OpClass> opClasses;
+    std::vector<Cycles> readyCycles;
+
+    Mask ready;
+    Mask excluded;
+    Mask priority;
+
+    /** Row-major age matrix with `words` words per slot. */
+    Mask older;
+
+    /** Scratch masks of select(). */
+    Mask candidates;
+    Mask preferred;
+
+    Random::RandomPtr rng;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_ISSUE_SELECT_HH__
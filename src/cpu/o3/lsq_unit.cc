@@ -42,6 +42,7 @@
 #include "cpu/o3/lsq_unit.hh"
 
 #include "arch/generic/debugfaults.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "cpu/checker/cpu.hh"
 #include "cpu/o3/dyn_inst.hh"
@@ -216,6 +217,9 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params,
     depCheckShift = params.LSQDepCheckShift;
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
+    useAddrIndex = params.LSQAddrIndex;
+    loadIndex = AddrRangeIndex(floorLog2(cpu->cacheLineSize()));
+    storeIndex = AddrRangeIndex(floorLog2(cpu->cacheLineSize()));
 
     resetState();
 }
@@ -231,6 +235,8 @@ LSQUnit::resetState()
     htmStarts = htmStops = 0;
 
     storeWBIt = storeQueue.begin();
+    loadIndex.clear();
+    storeIndex.clear();
 
     retryPkt = NULL;
     memDepViolator = NULL;
@@ -529,6 +535,27 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
+    // With the address index only the younger loads in the same
+    // dependence check blocks are visited, still in program order.
+    auto hit = indexHits.cbegin();
+    auto next_load = [&]() {
+        if (!useAddrIndex) {
+            ++loadIt;
+        } else if (hit == indexHits.cend()) {
+            loadIt = loadQueue.end();
+        } else {
+            loadIt = loadQueue.getIterator(*hit++);
+        }
+    };
+    if (useAddrIndex) {
+        loadIndex.lookup(inst_eff_addr1 << depCheckShift,
+                (inst_eff_addr2 - inst_eff_addr1 + 1) << depCheckShift,
+                indexHits);
+        hit = std::lower_bound(indexHits.cbegin(), indexHits.cend(),
+                               loadIt._idx);
+        next_load();
+    }
+
     /** @todo in theory you only need to check an instruction that has executed
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
@@ -537,7 +564,7 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
     while (loadIt != loadQueue.end()) {
         DynInstPtr ld_inst = loadIt->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
+            next_load();
             continue;
         }
 
@@ -594,7 +621,7 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
             }
         }
 
-        ++loadIt;
+        next_load();
     }
     return NoFault;
 }
@@ -755,6 +782,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    loadIndex.erase(loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 
@@ -979,6 +1007,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         loadQueue.back().instruction()->setSquashed();
         loadQueue.back().clear();
 
+        loadIndex.erase(loadQueue.tail());
         loadQueue.pop_back();
         ++stats.squashedLoads;
     }
@@ -1052,6 +1081,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // place to really handle request deletes.
         storeQueue.back().clear();
 
+        storeIndex.erase(storeQueue.tail());
         storeQueue.pop_back();
         ++stats.squashedStores;
     }
@@ -1175,6 +1205,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeIndex.erase(storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1345,6 +1376,10 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     load_entry.setRequest(request);
     assert(load_inst);
 
+    if (useAddrIndex) {
+        loadIndex.insert(load_idx, load_inst->effAddr, load_inst->effSize);
+    }
+
     assert(!load_inst->isExecuted());
 
     // Make sure this isn't a strictly ordered load
@@ -1408,10 +1443,29 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+
+    // With the address index only the stores sharing a cache line with
+    // the load are visited, youngest first. A zero-sized load matches by
+    // address bounds alone, so it keeps the full scan.
+    const bool indexed = useAddrIndex && request->mainReq()->getSize();
+    auto hit = indexHits.crend();
+    if (indexed) {
+        storeIndex.lookup(request->mainReq()->getVaddr(),
+                          request->mainReq()->getSize(), indexHits);
+        hit = std::make_reverse_iterator(std::lower_bound(
+                    indexHits.cbegin(), indexHits.cend(), store_it._idx));
+    }
+
     // End once we've reached the top of the LSQ
     while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
         // Move the index to one younger
-        store_it--;
+        if (!indexed) {
+            store_it--;
+        } else if (hit != indexHits.crend() && *hit >= storeWBIt._idx) {
+            store_it = storeQueue.getIterator(*hit++);
+        } else {
+            break;
+        }
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -1644,6 +1698,10 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    if (useAddrIndex) {
+        storeIndex.insert(store_idx,
+                storeQueue[store_idx].instruction()->effAddr, size);
+    }
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -1652,8 +1710,13 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     // copy data into the storeQueue only if the store request has valid data
     if (!(request->req()->getFlags() & Request::CACHE_BLOCK_ZERO) &&
         !request->req()->isCacheMaintenance() &&
-        !request->req()->isAtomic())
+        !request->req()->isAtomic()) {
         memcpy(storeQueue[store_idx].data(), data, size);
+        if (!store_no_data) {
+            iewStage->storeDataReady(storeQueue[store_idx].instruction(),
+                                     data, size);
+        }
+    }
 
     // This function only writes the data to the store queue, so no fault
     // can happen here.
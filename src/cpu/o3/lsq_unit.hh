@@ -47,9 +47,11 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
+#include "base/addr_range_index.hh"
 #include "base/circular_queue.hh"
 #include "cpu/base.hh"
 #include "cpu/inst_seq.hh"
@@ -474,6 +476,18 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /** Search the LSQ through address indices instead of linear scans. */
+    bool useAddrIndex;
+
+    /** Loads with a valid effective address, keyed by LQ index. */
+    AddrRangeIndex loadIndex;
+
+    /** Stores with data in the SQ, keyed by SQ index. */
+    AddrRangeIndex storeIndex;
+
+    /** Scratch buffer for index lookups. */
+    std::vector<AddrRangeIndex::Key> indexHits;
+
     /** The number of store instructions in the SQ waiting to writeback. */
     int storesToWB;
 
@@ -27,11 +27,14 @@
 
 #include "cpu/o3/lvp.hh"
 
-#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
 #include "debug/LVP.hh"
 
 namespace gem5
@@ -40,60 +43,496 @@ namespace gem5
 namespace o3
 {
 
+LVPComponent::LVPComponent(statistics::Group *parent, const char *name,
+                           unsigned table_size, unsigned conf_bits,
+                           unsigned conf_threshold)
+    : tableSize(table_size),
+      indexMask(table_size - 1),
+      confidenceBits(conf_bits),
+      confidenceThreshold(conf_threshold),
+      stats(parent, name)
+{
+}
+
+void
+LVPComponent::recordOutcome(bool predicted, bool correct)
+{
+    ++stats.lookups;
+    if (!predicted)
+        return;
+
+    ++stats.predictions;
+    if (correct)
+        ++stats.predCorrect;
+    else
+        ++stats.predIncorrect;
+}
+
+LVPComponent::ComponentStats::ComponentStats(statistics::Group *parent,
+                                             const char *name)
+    : statistics::Group(parent, name),
+      ADD_STAT(lookups, statistics::units::Count::get(),
+               "Number of committed loads looked up by this component"),
+      ADD_STAT(predictions, statistics::units::Count::get(),
+               "Number of committed loads this component was confident on"),
+      ADD_STAT(predCorrect, statistics::units::Count::get(),
+               "Number of correct confident predictions"),
+      ADD_STAT(predIncorrect, statistics::units::Count::get(),
+               "Number of incorrect confident predictions"),
+      ADD_STAT(accuracy, statistics::units::Ratio::get(),
+               "Fraction of confident predictions that were correct",
+               predCorrect / predictions),
+      ADD_STAT(coverage, statistics::units::Ratio::get(),
+               "Fraction of committed loads that were predicted",
+               predictions / lookups)
+{
+    accuracy.precision(6);
+    coverage.precision(6);
+}
+
+LastValueComponent::LastValueComponent(statistics::Group *parent,
+                                       unsigned table_size,
+                                       unsigned conf_bits,
+                                       unsigned conf_threshold)
+    : LVPComponent(parent, "lastValue", table_size, conf_bits,
+                   conf_threshold),
+      table(table_size, Entry(conf_bits))
+{
+}
+
+bool
+LastValueComponent::lookup(Addr pc, unsigned inflight, RegVal &value)
+{
+    const Entry &entry = table[getIndex(pc)];
+    if (!entry.valid || entry.tag != pc)
+        return false;
+
+    value = entry.value;
+    return entry.confidence >= confidenceThreshold;
+}
+
+void
+LastValueComponent::train(Addr pc, RegVal value)
+{
+    Entry &entry = table[getIndex(pc)];
+
+    if (entry.valid && entry.tag == pc) {
+        if (entry.value == value) {
+            // Same value — increase confidence.
+            entry.confidence++;
+            DPRINTF(LVP, "LastValue [PC:%#x] same value %#x, "
+                    "confidence -> %d\n",
+                    pc, value, (unsigned)entry.confidence);
+        } else {
+            // Different value — reset confidence and store new value.
+            entry.value = value;
+            entry.confidence.reset();
+            DPRINTF(LVP, "LastValue [PC:%#x] new value %#x, "
+                    "confidence reset\n", pc, value);
+        }
+    } else {
+        // New entry or tag mismatch — install new entry.
+        entry.valid = true;
+        entry.tag = pc;
+        entry.value = value;
+        entry.confidence.reset();
+        DPRINTF(LVP, "LastValue install [PC:%#x] value %#x\n", pc, value);
+    }
+}
+
+StrideComponent::StrideComponent(statistics::Group *parent,
+                                 unsigned table_size, unsigned conf_bits,
+                                 unsigned conf_threshold, bool two_delta)
+    : LVPComponent(parent, two_delta ? "twoDeltaStride" : "stride",
+                   table_size, conf_bits, conf_threshold),
+      twoDelta(two_delta),
+      table(table_size, Entry(conf_bits))
+{
+}
+
+bool
+StrideComponent::lookup(Addr pc, unsigned inflight, RegVal &value)
+{
+    const Entry &entry = table[getIndex(pc)];
+    if (!entry.valid || entry.tag != pc)
+        return false;
+
+    // Skip over the instances that are older than this one but have not
+    // trained the entry yet.
+    value = entry.lastValue + entry.stride * (inflight + 1);
+    return entry.confidence >= confidenceThreshold;
+}
+
+void
+StrideComponent::train(Addr pc, RegVal value)
+{
+    Entry &entry = table[getIndex(pc)];
+
+    if (!entry.valid || entry.tag != pc) {
+        entry.valid = true;
+        entry.tag = pc;
+        entry.lastValue = value;
+        entry.stride = 0;
+        entry.lastStride = 0;
+        entry.confidence.reset();
+        DPRINTF(LVP, "Stride install [PC:%#x] value %#x\n", pc, value);
+        return;
+    }
+
+    const RegVal new_stride = value - entry.lastValue;
+
+    if (new_stride == entry.stride) {
+        entry.confidence++;
+    } else {
+        entry.confidence.reset();
+        if (!twoDelta || new_stride == entry.lastStride)
+            entry.stride = new_stride;
+    }
+
+    DPRINTF(LVP, "Stride [PC:%#x] value %#x stride %#x, confidence -> %d\n",
+            pc, value, entry.stride, (unsigned)entry.confidence);
+
+    entry.lastStride = new_stride;
+    entry.lastValue = value;
+}
+
+ContextComponent::ContextComponent(statistics::Group *parent,
+                                   unsigned table_size, unsigned conf_bits,
+                                   unsigned conf_threshold, unsigned order,
+                                   unsigned vpt_size, unsigned max_walk)
+    : LVPComponent(parent, "context", table_size, conf_bits,
+                   conf_threshold),
+      order(order),
+      vptMask(vpt_size - 1),
+      maxWalk(max_walk),
+      vht(table_size),
+      vpt(vpt_size, VPTEntry(conf_bits))
+{
+    fatal_if(order == 0, "LVP context order must be at least 1");
+    fatal_if(!isPowerOf2(vpt_size),
+             "LVP context table size must be a power of 2, got %d",
+             vpt_size);
+}
+
+unsigned
+ContextComponent::hashContext(Addr pc,
+                              const std::vector<RegVal> &values) const
+{
+    uint64_t hash = pc >> 2;
+    for (RegVal v : values) {
+        // Fold each value down before mixing so that high-order bits
+        // still influence the index.
+        uint64_t folded = v ^ (v >> 16) ^ (v >> 32) ^ (v >> 48);
+        hash = (hash << 5) ^ (hash >> 59) ^ folded;
+    }
+    return hash & vptMask;
+}
+
+bool
+ContextComponent::lookup(Addr pc, unsigned inflight, RegVal &value)
+{
+    const HistoryEntry &entry = vht[getIndex(pc)];
+    if (!entry.valid || entry.tag != pc || entry.values.size() < order ||
+        inflight >= maxWalk) {
+        return false;
+    }
+
+    std::vector<RegVal> context = entry.values;
+    const VPTEntry *vpt_entry = nullptr;
+    for (unsigned step = 0; step <= inflight; step++) {
+        vpt_entry = &vpt[hashContext(pc, context)];
+        if (!vpt_entry->valid)
+            return false;
+        context.pop_back();
+        context.insert(context.begin(), vpt_entry->value);
+    }
+
+    value = vpt_entry->value;
+    return vpt_entry->confidence >= confidenceThreshold;
+}
+
+void
+ContextComponent::train(Addr pc, RegVal value)
+{
+    HistoryEntry &entry = vht[getIndex(pc)];
+
+    if (!entry.valid || entry.tag != pc) {
+        entry.valid = true;
+        entry.tag = pc;
+        entry.values.clear();
+    }
+
+    if (entry.values.size() == order) {
+        VPTEntry &vpt_entry = vpt[hashContext(pc, entry.values)];
+        if (vpt_entry.valid && vpt_entry.value == value) {
+            vpt_entry.confidence++;
+        } else {
+            vpt_entry.valid = true;
+            vpt_entry.value = value;
+            vpt_entry.confidence.reset();
+        }
+        DPRINTF(LVP, "Context [PC:%#x] value %#x, confidence -> %d\n",
+                pc, value, (unsigned)vpt_entry.confidence);
+        entry.values.pop_back();
+    }
+
+    entry.values.insert(entry.values.begin(), value);
+}
+
 LoadValuePredictor::LoadValuePredictor(const Params &p)
     : SimObject(p),
-      tableSize(p.tableSize),
-      indexMask(p.tableSize - 1),
-      confidenceThreshold(p.confidenceThreshold),
-      confidenceBits(p.confidenceBits),
       enabled(p.enabled),
+      replay(p.selectiveReplay),
+      predictFloatVec(p.predictFloatVec),
+      vecBytes(p.vecPredictBytes),
+      unpredictable(p.tableSize, MaxAddr),
+      primary(static_cast<int>(p.mode)),
       stats(this)
 {
-    fatal_if(!isPowerOf2(tableSize),
-             "LVP table size must be a power of 2, got %d", tableSize);
+    fatal_if(!isPowerOf2(p.tableSize),
+             "LVP table size must be a power of 2, got %d", p.tableSize);
+    fatal_if(vecBytes == 0 || vecBytes % sizeof(RegVal) != 0,
+             "LVP vector prediction bytes must be a non-zero multiple of "
+             "%d, got %d", sizeof(RegVal), vecBytes);
+    fatal_if(p.confidenceThreshold > (1U << p.confidenceBits) - 1,
+             "LVP confidence threshold %d is unreachable with %d bits",
+             p.confidenceThreshold, p.confidenceBits);
+
+    for (int i = 0; i < NumLVPComponents; i++) {
+        if (i != primary && !p.evaluateAll)
+            continue;
 
-    table.resize(tableSize);
+        switch (static_cast<LVPMode>(i)) {
+          case LVPMode::LastValue:
+            components[i] = std::make_unique<LastValueComponent>(
+                this, p.tableSize, p.confidenceBits,
+                p.confidenceThreshold);
+            break;
+          case LVPMode::Stride:
+          case LVPMode::TwoDeltaStride:
+            components[i] = std::make_unique<StrideComponent>(
+                this, p.tableSize, p.confidenceBits,
+                p.confidenceThreshold, i == (int)LVPMode::TwoDeltaStride);
+            break;
+          case LVPMode::Context:
+            components[i] = std::make_unique<ContextComponent>(
+                this, p.tableSize, p.confidenceBits,
+                p.confidenceThreshold, p.contextOrder, p.contextTableSize,
+                p.contextMaxWalk);
+            break;
+          default:
+            panic("Unknown LVP mode %d", i);
+        }
+    }
 }
 
 unsigned
-LoadValuePredictor::getIndex(Addr pc) const
+LoadValuePredictor::vecPredictBytes(PhysRegIdPtr reg) const
 {
-    // Shift right by 2 to skip the lowest bits (instruction alignment).
-    return (pc >> 2) & indexMask;
+    return std::min<unsigned>(vecBytes, reg->regClass().regBytes());
 }
 
-Addr
-LoadValuePredictor::getTag(Addr pc) const
+unsigned
+LoadValuePredictor::numValueWords(const DynInstPtr &inst) const
 {
-    return pc;
+    unsigned num_words = 0;
+
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        PhysRegIdPtr reg = inst->renamedDestIdx(i);
+
+        // Fixed-mapping registers (e.g. the zero register) never need a
+        // value and are not tracked by the IQ.
+        if (reg->isAlwaysReady())
+            continue;
+
+        // Pinned registers are written by several instructions; waking
+        // their dependents early is not safe.
+        if (reg->getNumPinnedWrites() != 0)
+            return 0;
+
+        switch (reg->classValue()) {
+          case IntRegClass:
+          case CCRegClass:
+            num_words++;
+            break;
+          case FloatRegClass:
+          case VecElemClass:
+            if (!predictFloatVec)
+                return 0;
+            num_words++;
+            break;
+          case VecRegClass:
+            if (!predictFloatVec)
+                return 0;
+            num_words += divCeil(vecPredictBytes(reg), sizeof(RegVal));
+            break;
+          default:
+            return 0;
+        }
+    }
+
+    return num_words <= MaxLVPWords ? num_words : 0;
+}
+
+void
+LoadValuePredictor::readDestRegs(const DynInstPtr &inst, CPU *cpu,
+                                 LVPValue &value)
+{
+    ThreadID tid = inst->threadNumber;
+    value.numWords = 0;
+
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        PhysRegIdPtr reg = inst->renamedDestIdx(i);
+        if (reg->isAlwaysReady())
+            continue;
+
+        if (reg->classValue() != VecRegClass) {
+            assert(value.numWords < MaxLVPWords);
+            value.words[value.numWords++] = cpu->getReg(reg, tid);
+            continue;
+        }
+
+        const size_t reg_bytes = reg->regClass().regBytes();
+        const unsigned pred_bytes = vecPredictBytes(reg);
+        regBuf.resize(std::max(regBuf.size(), reg_bytes));
+        cpu->getReg(reg, regBuf.data(), tid);
+
+        // Only the low-order bytes are predicted; the rest are assumed to
+        // be zero, as left by scalar FP and NEON loads.
+        if (std::any_of(regBuf.begin() + pred_bytes,
+                        regBuf.begin() + reg_bytes,
+                        [](uint8_t b) { return b != 0; })) {
+            value.numWords = 0;
+            return;
+        }
+
+        for (unsigned off = 0; off < pred_bytes; off += sizeof(RegVal)) {
+            assert(value.numWords < MaxLVPWords);
+            RegVal word = 0;
+            std::memcpy(&word, regBuf.data() + off,
+                        std::min<size_t>(sizeof(RegVal), pred_bytes - off));
+            value.words[value.numWords++] = word;
+        }
+    }
+}
+
+void
+LoadValuePredictor::writeDestRegs(const DynInstPtr &inst, CPU *cpu,
+                                  const LVPValue &value)
+{
+    ThreadID tid = inst->threadNumber;
+    unsigned word = 0;
+    unsigned num_regs = 0;
+    bool float_vec = false;
+
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        PhysRegIdPtr reg = inst->renamedDestIdx(i);
+        if (reg->isAlwaysReady())
+            continue;
+
+        num_regs++;
+
+        if (reg->classValue() != VecRegClass) {
+            float_vec |= reg->classValue() == FloatRegClass ||
+                reg->classValue() == VecElemClass;
+            assert(word < value.numWords);
+            cpu->setReg(reg, value.words[word++], tid);
+            continue;
+        }
+
+        float_vec = true;
+
+        const size_t reg_bytes = reg->regClass().regBytes();
+        const unsigned pred_bytes = vecPredictBytes(reg);
+        regBuf.resize(std::max(regBuf.size(), reg_bytes));
+        std::fill(regBuf.begin(), regBuf.begin() + reg_bytes, 0);
+
+        for (unsigned off = 0; off < pred_bytes; off += sizeof(RegVal)) {
+            assert(word < value.numWords);
+            std::memcpy(regBuf.data() + off, &value.words[word++],
+                        std::min<size_t>(sizeof(RegVal), pred_bytes - off));
+        }
+
+        cpu->setReg(reg, regBuf.data(), tid);
+    }
+
+    if (num_regs > 1)
+        ++stats.predMultiDest;
+    if (float_vec)
+        ++stats.predFloatVec;
 }
 
 bool
-LoadValuePredictor::predict(Addr pc, ThreadID tid, RegVal &value)
+LoadValuePredictor::predict(InstSeqNum seqNum, Addr pc, ThreadID tid,
+                            unsigned num_words, bool dit,
+                            LVPValue &value)
 {
     if (!enabled)
         return false;
 
-    unsigned idx = getIndex(pc);
-    LVPEntry &entry = table[idx];
+    assert(num_words > 0 && num_words <= MaxLVPWords);
+
+    auto it = inflight[tid].find(pc);
+    unsigned num_inflight = it == inflight[tid].end() ? 0 : it->second;
+
+    LVPHistory entry;
+    entry.seqNum = seqNum;
+    entry.pc = pc;
+    entry.tid = tid;
+
+    const bool blocked = unpredictable[(pc >> 2) & (unpredictable.size() - 1)]
+        == pc;
+
+    for (int i = 0; i < NumLVPComponents; i++) {
+        if (!components[i])
+            continue;
+
+        LVPValue &comp_value = entry.compValue[i];
+        bool confident = !blocked;
+        comp_value.numWords = num_words;
+        for (unsigned w = 0; w < num_words; w++) {
+            confident &= components[i]->lookup(
+                wordKey(pc, w), num_inflight, comp_value.words[w]);
+        }
+        entry.compPredicted[i] = confident;
+    }
 
-    if (entry.valid && entry.tag == getTag(pc) &&
-        entry.confidence >= confidenceThreshold) {
-        value = entry.value;
+    entry.predicted = entry.compPredicted[primary];
+    entry.predictedValue = entry.compValue[primary];
+
+    // Under data-independent timing the entry still tracks the load as
+    // in flight, but the prediction must not change when its dependents
+    // can issue.
+    const bool suppressed = entry.predicted && dit;
+    if (suppressed)
+        entry.predicted = false;
+
+    history[tid].push_back(entry);
+    inflight[tid][pc]++;
+
+    if (suppressed) {
+        ++stats.ditSuppressed;
+        DPRINTF(LVP, "Suppressed prediction for [sn:%llu] [PC:%#x]: "
+                "data-independent timing\n", seqNum, pc);
+        return false;
+    }
+
+    if (entry.predicted) {
+        value = entry.predictedValue;
         ++stats.predictions;
-        DPRINTF(LVP, "Predict [PC:%#x] -> value %#x (confidence %d)\n",
-                pc, value, (unsigned)entry.confidence);
+        DPRINTF(LVP, "Predict [sn:%llu] [PC:%#x] -> value %#x, %d words "
+                "(%d in flight)\n", seqNum, pc, value.words[0], num_words,
+                num_inflight);
         return true;
     }
 
     ++stats.predNotConfident;
-    DPRINTF(LVP, "No prediction for [PC:%#x] (valid=%d, conf=%d)\n",
-            pc, entry.valid, entry.valid ? (unsigned)entry.confidence : 0);
+    DPRINTF(LVP, "No prediction for [sn:%llu] [PC:%#x]\n", seqNum, pc);
     return false;
 }
 
 bool
-LoadValuePredictor::validate(InstSeqNum seqNum, RegVal actualValue)
+LoadValuePredictor::validate(InstSeqNum seqNum, const LVPValue &actualValue)
 {
     // Find the history entry for this instruction.
     for (auto &threadHist : history) {
@@ -104,13 +543,15 @@ LoadValuePredictor::validate(InstSeqNum seqNum, RegVal actualValue)
                     ++stats.predCorrect;
                     DPRINTF(LVP, "Validated correct [sn:%llu] "
                             "predicted=%#x actual=%#x\n",
-                            seqNum, h.predictedValue, actualValue);
+                            seqNum, h.predictedValue.words[0],
+                            actualValue.words[0]);
                 } else {
                     ++stats.predIncorrect;
                     ++stats.squashes;
                     DPRINTF(LVP, "Validated INCORRECT [sn:%llu] "
-                            "predicted=%#x actual=%#x\n",
-                            seqNum, h.predictedValue, actualValue);
+                            "predicted=%#x actual=%#x (%d words)\n",
+                            seqNum, h.predictedValue.words[0],
+                            actualValue.words[0], actualValue.numWords);
                 }
                 return correct;
             }
@@ -128,53 +569,63 @@ LoadValuePredictor::squash(InstSeqNum squashedSeqNum, ThreadID tid)
     while (!hist.empty() && hist.back().seqNum > squashedSeqNum) {
         DPRINTF(LVP, "Squashing history [sn:%llu] [PC:%#x]\n",
                 hist.back().seqNum, hist.back().pc);
+        auto it = inflight[tid].find(hist.back().pc);
+        assert(it != inflight[tid].end());
+        if (--it->second == 0)
+            inflight[tid].erase(it);
         hist.pop_back();
     }
 }
 
 void
-LoadValuePredictor::commitEntry(InstSeqNum seqNum, ThreadID tid)
+LoadValuePredictor::retireHistory(ThreadID tid)
 {
     auto &hist = history[tid];
-    // History entries should be committed in order (oldest first).
-    if (!hist.empty() && hist.front().seqNum == seqNum) {
-        hist.pop_front();
-    }
+    auto it = inflight[tid].find(hist.front().pc);
+    assert(it != inflight[tid].end());
+    if (--it->second == 0)
+        inflight[tid].erase(it);
+    hist.pop_front();
 }
 
 void
-LoadValuePredictor::update(Addr pc, RegVal value)
+LoadValuePredictor::update(InstSeqNum seqNum, ThreadID tid, Addr pc,
+                           bool dit, const LVPValue &value)
 {
-    unsigned idx = getIndex(pc);
-    LVPEntry &entry = table[idx];
+    auto &hist = history[tid];
 
-    if (entry.valid && entry.tag == getTag(pc)) {
-        if (entry.value == value) {
-            // Same value — increase confidence.
-            entry.confidence++;
-            DPRINTF(LVP, "Update [PC:%#x] same value %#x, confidence -> %d\n",
-                    pc, value, (unsigned)entry.confidence);
-        } else {
-            // Different value — reset confidence and store new value.
-            entry.value = value;
-            entry.confidence.reset();
-            DPRINTF(LVP, "Update [PC:%#x] new value %#x, confidence reset\n",
-                    pc, value);
+    // History entries are retired in order (oldest first). Anything older
+    // than this load never committed as a predictable load.
+    while (!hist.empty() && hist.front().seqNum < seqNum)
+        retireHistory(tid);
+
+    if (!hist.empty() && hist.front().seqNum == seqNum) {
+        const LVPHistory &h = hist.front();
+        for (int i = 0; i < NumLVPComponents; i++) {
+            if (components[i]) {
+                components[i]->recordOutcome(h.compPredicted[i],
+                                             h.compValue[i] == value);
+            }
         }
-    } else {
-        // New entry or tag mismatch — install new entry.
-        entry.valid = true;
-        entry.tag = getTag(pc);
-        entry.value = value;
-        entry.confidence.reset();
-        DPRINTF(LVP, "Install [PC:%#x] value %#x\n", pc, value);
+        retireHistory(tid);
     }
-}
 
-void
-LoadValuePredictor::addHistory(const LVPHistory &entry)
-{
-    history[entry.tid].push_back(entry);
+    if (dit)
+        return;
+
+    if (value.numWords == 0) {
+        ++stats.unrepresentable;
+        unpredictable[(pc >> 2) & (unpredictable.size() - 1)] = pc;
+        DPRINTF(LVP, "Blocking [PC:%#x]: value not representable\n", pc);
+        return;
+    }
+
+    for (auto &component : components) {
+        if (!component)
+            continue;
+        for (unsigned w = 0; w < value.numWords; w++)
+            component->train(wordKey(pc, w), value.words[w]);
+    }
 }
 
 LoadValuePredictor::LVPStats::LVPStats(LoadValuePredictor *lvp)
@@ -187,8 +638,20 @@ LoadValuePredictor::LVPStats::LVPStats(LoadValuePredictor *lvp)
                "Number of incorrect load value predictions (mispredictions)"),
       ADD_STAT(predNotConfident, statistics::units::Count::get(),
                "Number of loads not predicted due to low confidence"),
+      ADD_STAT(predMultiDest, statistics::units::Count::get(),
+               "Number of predictions covering several destination "
+               "registers"),
+      ADD_STAT(predFloatVec, statistics::units::Count::get(),
+               "Number of predictions covering FP/vector registers"),
+      ADD_STAT(unrepresentable, statistics::units::Count::get(),
+               "Number of committed loads whose value the predictor "
+               "cannot represent"),
+      ADD_STAT(ditSuppressed, statistics::units::Count::get(),
+               "Number of confident predictions suppressed by "
+               "data-independent timing"),
       ADD_STAT(squashes, statistics::units::Count::get(),
-               "Number of pipeline squashes due to value misprediction"),
+               "Number of value mispredictions requiring recovery "
+               "(squash or selective replay)"),
       ADD_STAT(accuracy, statistics::units::Ratio::get(),
                "Load value prediction accuracy",
                predCorrect / predictions),
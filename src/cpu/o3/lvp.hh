@@ -28,14 +28,22 @@
 #ifndef __CPU_O3_LVP_HH__
 #define __CPU_O3_LVP_HH__
 
+#include <algorithm>
+#include <array>
 #include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/sat_counter.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/reg_class.hh"
+#include "enums/LVPMode.hh"
 #include "params/LoadValuePredictor.hh"
 #include "sim/sim_object.hh"
 
@@ -45,15 +53,35 @@ namespace gem5
 namespace o3
 {
 
-/** Entry in the LVP prediction table, indexed by load PC. */
-struct LVPEntry
+class CPU;
+
+/** Number of selectable predictor components (one per LVPMode). */
+static constexpr int NumLVPComponents =
+    static_cast<int>(LVPMode::Num_LVPMode);
+
+/** Maximum number of 64-bit words covered by a single load prediction. */
+static constexpr int MaxLVPWords = 8;
+
+/**
+ * Contents of all destination registers of a load, packed as 64-bit words
+ * in destination register order. Scalar registers take one word; vector
+ * registers take their predicted low-order bytes. A value with no words
+ * stands for register contents the predictor cannot represent.
+ */
+struct LVPValue
 {
-    Addr tag = 0;
-    RegVal value = 0;
-    SatCounter8 confidence;
-    bool valid = false;
+    std::array<RegVal, MaxLVPWords> words{};
+    unsigned numWords = 0;
+
+    bool
+    operator==(const LVPValue &other) const
+    {
+        return numWords == other.numWords &&
+            std::equal(words.begin(), words.begin() + numWords,
+                       other.words.begin());
+    }
 
-    LVPEntry() : confidence(3, 0) {}
+    bool operator!=(const LVPValue &other) const { return !(*this == other); }
 };
 
 /** History entry tracking an in-flight value prediction. */
@@ -62,17 +90,195 @@ struct LVPHistory
     InstSeqNum seqNum = 0;
     Addr pc = 0;
     ThreadID tid = 0;
-    RegVal predictedValue = 0;
+    LVPValue predictedValue;
     bool predicted = false;
+
+    /** Value looked up by each instantiated component. */
+    std::array<LVPValue, NumLVPComponents> compValue{};
+    /** Whether each component was confident in its value. */
+    std::array<bool, NumLVPComponents> compPredicted{};
+};
+
+/**
+ * A single value prediction scheme. Components are looked up at dispatch
+ * and trained in program order at commit. Since training only sees
+ * committed values, lookups are told how many older instances of the same
+ * load are still in flight so that they can extrapolate past them.
+ */
+class LVPComponent
+{
+  public:
+    LVPComponent(statistics::Group *parent, const char *name,
+                 unsigned table_size, unsigned conf_bits,
+                 unsigned conf_threshold);
+
+    virtual ~LVPComponent() = default;
+
+    /**
+     * Predict the value of a load.
+     * @param pc The load instruction's PC.
+     * @param inflight Number of older uncommitted instances of this load.
+     * @param value Output: the predicted value.
+     * @return true if the component is confident in the prediction.
+     */
+    virtual bool lookup(Addr pc, unsigned inflight, RegVal &value) = 0;
+
+    /** Train the component with a committed load value. */
+    virtual void train(Addr pc, RegVal value) = 0;
+
+    /** Account the outcome of a lookup for a committed load. */
+    void recordOutcome(bool predicted, bool correct);
+
+  protected:
+    /** Compute table index from PC. */
+    unsigned getIndex(Addr pc) const { return (pc >> 2) & indexMask; }
+
+    /** Number of entries in the per-PC table. */
+    const unsigned tableSize;
+
+    /** Mask for indexing into the per-PC table. */
+    const unsigned indexMask;
+
+    /** Number of bits for the confidence counters. */
+    const unsigned confidenceBits;
+
+    /** Minimum confidence to issue a prediction. */
+    const unsigned confidenceThreshold;
+
+    struct ComponentStats : public statistics::Group
+    {
+        ComponentStats(statistics::Group *parent, const char *name);
+
+        statistics::Scalar lookups;
+        statistics::Scalar predictions;
+        statistics::Scalar predCorrect;
+        statistics::Scalar predIncorrect;
+        statistics::Formula accuracy;
+        statistics::Formula coverage;
+    } stats;
+};
+
+/** Predicts the last committed value of the load. */
+class LastValueComponent : public LVPComponent
+{
+  public:
+    LastValueComponent(statistics::Group *parent, unsigned table_size,
+                       unsigned conf_bits, unsigned conf_threshold);
+
+    bool lookup(Addr pc, unsigned inflight, RegVal &value) override;
+    void train(Addr pc, RegVal value) override;
+
+  private:
+    struct Entry
+    {
+        Addr tag = 0;
+        RegVal value = 0;
+        SatCounter8 confidence;
+        bool valid = false;
+
+        Entry(unsigned bits) : confidence(bits, 0) {}
+    };
+
+    std::vector<Entry> table;
+};
+
+/**
+ * Predicts last value + stride. In two-delta mode the stride used for
+ * predictions is only replaced once the same new stride has been observed
+ * twice in a row, which filters out one-off irregularities such as loop
+ * exits.
+ */
+class StrideComponent : public LVPComponent
+{
+  public:
+    StrideComponent(statistics::Group *parent, unsigned table_size,
+                    unsigned conf_bits, unsigned conf_threshold,
+                    bool two_delta);
+
+    bool lookup(Addr pc, unsigned inflight, RegVal &value) override;
+    void train(Addr pc, RegVal value) override;
+
+  private:
+    struct Entry
+    {
+        Addr tag = 0;
+        RegVal lastValue = 0;
+        /** Stride used for predictions. */
+        RegVal stride = 0;
+        /** Most recently observed stride (two-delta only). */
+        RegVal lastStride = 0;
+        SatCounter8 confidence;
+        bool valid = false;
+
+        Entry(unsigned bits) : confidence(bits, 0) {}
+    };
+
+    const bool twoDelta;
+
+    std::vector<Entry> table;
+};
+
+/**
+ * Finite context method predictor. A per-PC value history table records
+ * the last contextOrder committed values of each load; their hash indexes
+ * a shared value prediction table that holds the value that followed that
+ * context last time. In-flight instances are covered by walking the value
+ * prediction table forward, feeding each predicted value back into the
+ * context, up to maxWalk steps.
+ */
+class ContextComponent : public LVPComponent
+{
+  public:
+    ContextComponent(statistics::Group *parent, unsigned table_size,
+                     unsigned conf_bits, unsigned conf_threshold,
+                     unsigned order, unsigned vpt_size, unsigned max_walk);
+
+    bool lookup(Addr pc, unsigned inflight, RegVal &value) override;
+    void train(Addr pc, RegVal value) override;
+
+  private:
+    struct HistoryEntry
+    {
+        Addr tag = 0;
+        /** Most recent values, newest first. */
+        std::vector<RegVal> values;
+        bool valid = false;
+    };
+
+    struct VPTEntry
+    {
+        RegVal value = 0;
+        SatCounter8 confidence;
+        bool valid = false;
+
+        VPTEntry(unsigned bits) : confidence(bits, 0) {}
+    };
+
+    /** Hash a load PC and value context into a VPT index. */
+    unsigned hashContext(Addr pc, const std::vector<RegVal> &values) const;
+
+    const unsigned order;
+    const unsigned vptMask;
+    const unsigned maxWalk;
+
+    std::vector<HistoryEntry> vht;
+    std::vector<VPTEntry> vpt;
 };
 
 /**
  * Load Value Predictor.
  *
- * Implements a last-value predictor that predicts load results based on
- * the load's PC. Each table entry stores the last committed value and a
- * saturating confidence counter. Predictions are only made when confidence
- * meets a configurable threshold.
+ * Predicts load results with one of several selectable schemes (last
+ * value, stride, two-delta stride or finite context method). The selected
+ * component drives value speculation; when evaluateAll is set the other
+ * components are looked up and trained alongside it so that each reports
+ * its own coverage and accuracy for the same run.
+ *
+ * A prediction covers every destination register of the load (e.g. both
+ * registers of a load pair, or the base register of a writeback load) and
+ * may target FP/vector registers. Each 64-bit word of the packed value is
+ * predicted by its own component entry, keyed by the load PC and the word
+ * position; the load is only predicted if all words are confident.
  *
  * Integration points:
  *  - Predict at dispatch (IEW::dispatchInsts)
@@ -87,21 +293,41 @@ class LoadValuePredictor : public SimObject
     LoadValuePredictor(const Params &p);
 
     /**
-     * Look up the prediction table for a load PC.
+     * Number of value words needed to predict a load's destination
+     * registers.
+     * @return 0 if any destination register cannot be predicted.
+     */
+    unsigned numValueWords(const DynInstPtr &inst) const;
+
+    /** Pack the current contents of a load's destination registers. */
+    void readDestRegs(const DynInstPtr &inst, CPU *cpu, LVPValue &value);
+
+    /** Write a predicted value to a load's destination registers. */
+    void writeDestRegs(const DynInstPtr &inst, CPU *cpu,
+                       const LVPValue &value);
+
+    /**
+     * Look up the predictor for a load and record an in-flight history
+     * entry for it, whether or not a confident prediction is made.
+     * @param seqNum The load's sequence number.
      * @param pc The load instruction's PC.
      * @param tid Thread ID.
+     * @param num_words Number of value words (see numValueWords()).
+     * @param dit The load executes under data-independent timing; a
+     *            confident prediction is counted but not used.
      * @param value Output: the predicted value if confident.
      * @return true if a confident prediction was made.
      */
-    bool predict(Addr pc, ThreadID tid, RegVal &value);
+    bool predict(InstSeqNum seqNum, Addr pc, ThreadID tid,
+                 unsigned num_words, bool dit, LVPValue &value);
 
     /**
      * Validate an in-flight prediction against the actual load value.
      * @param seqNum The instruction's sequence number.
-     * @param actualValue The actual value from the memory system.
+     * @param actualValue The actual value of all destination registers.
      * @return true if the prediction was correct.
      */
-    bool validate(InstSeqNum seqNum, RegVal actualValue);
+    bool validate(InstSeqNum seqNum, const LVPValue &actualValue);
 
     /**
      * Remove history entries for squashed instructions.
@@ -112,54 +338,70 @@ class LoadValuePredictor : public SimObject
     void squash(InstSeqNum squashedSeqNum, ThreadID tid);
 
     /**
-     * Remove a committed history entry.
-     * @param seqNum The committed instruction's sequence number.
+     * Train the predictor with an actual committed load value and retire
+     * the load's history entry. A value the predictor cannot represent
+     * stops the load from being predicted again. Values loaded under
+     * data-independent timing are never trained on, so they cannot be
+     * predicted for later loads either.
+     * @param seqNum The committed load's sequence number.
      * @param tid Thread ID.
-     */
-    void commitEntry(InstSeqNum seqNum, ThreadID tid);
-
-    /**
-     * Update the prediction table with an actual committed load value.
-     * Called at commit time to train the predictor.
      * @param pc The load instruction's PC.
+     * @param dit The load executed under data-independent timing.
      * @param value The actual committed value.
      */
-    void update(Addr pc, RegVal value);
-
-    /** Add a history entry for an in-flight prediction. */
-    void addHistory(const LVPHistory &entry);
+    void update(InstSeqNum seqNum, ThreadID tid, Addr pc, bool dit,
+                const LVPValue &value);
 
     /** Check if the predictor is enabled. */
     bool isEnabled() const { return enabled; }
 
+    /** Whether mispredictions are recovered by selective replay. */
+    bool selectiveReplay() const { return replay; }
+
   private:
-    /** Compute table index from PC. */
-    unsigned getIndex(Addr pc) const;
+    /** Drop the oldest history entry of a thread. */
+    void retireHistory(ThreadID tid);
 
-    /** Compute tag from PC. */
-    Addr getTag(Addr pc) const;
+    /** Component table key for one word of a load's value. */
+    static Addr
+    wordKey(Addr pc, unsigned word)
+    {
+        return word == 0 ? pc : pc ^ (word * 0x9e3779b97f4a7c15ULL);
+    }
 
-    /** The prediction table. */
-    std::vector<LVPEntry> table;
+    /** Number of low-order bytes predicted per vector register. */
+    unsigned vecPredictBytes(PhysRegIdPtr reg) const;
 
-    /** Number of entries in the table. */
-    unsigned tableSize;
+    /** Whether the predictor is enabled. */
+    bool enabled;
 
-    /** Mask for indexing into the table. */
-    unsigned indexMask;
+    /** Whether mispredictions are recovered by selective replay. */
+    const bool replay;
 
-    /** Minimum confidence to issue a prediction. */
-    unsigned confidenceThreshold;
+    /** Whether FP and vector destination registers are predicted. */
+    const bool predictFloatVec;
 
-    /** Number of bits for the confidence counter. */
-    unsigned confidenceBits;
+    /** Bytes predicted for each vector destination register. */
+    const unsigned vecBytes;
 
-    /** Whether the predictor is enabled. */
-    bool enabled;
+    /** Loads whose values could not be represented, indexed by PC. */
+    std::vector<Addr> unpredictable;
+
+    /** Scratch buffer for vector register contents. */
+    std::vector<uint8_t> regBuf;
 
-    /** Per-thread history of in-flight predictions. */
+    /** Component driving value speculation. */
+    const int primary;
+
+    /** Instantiated components, indexed by LVPMode. */
+    std::array<std::unique_ptr<LVPComponent>, NumLVPComponents> components;
+
+    /** Per-thread history of in-flight lookups. */
     std::deque<LVPHistory> history[MaxThreads];
 
+    /** Per-thread count of in-flight lookups by load PC. */
+    std::unordered_map<Addr, unsigned> inflight[MaxThreads];
+
     struct LVPStats : public statistics::Group
     {
         LVPStats(LoadValuePredictor *lvp);
@@ -168,6 +410,10 @@ class LoadValuePredictor : public SimObject
         statistics::Scalar predCorrect;
         statistics::Scalar predIncorrect;
         statistics::Scalar predNotConfident;
+        statistics::Scalar predMultiDest;
+        statistics::Scalar predFloatVec;
+        statistics::Scalar unrepresentable;
+        statistics::Scalar ditSuppressed;
         statistics::Scalar squashes;
         statistics::Formula accuracy;
         statistics::Formula coverage;
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/o3/mem_rename.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
+#include "debug/MemRename.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+namespace
+{
+
+/** Whether an instruction counts as a store for store distances. */
+bool
+countsAsStore(const DynInstPtr &inst)
+{
+    return inst->isStore() || inst->isAtomic();
+}
+
+} // anonymous namespace
+
+MemoryRenamer::MemoryRenamer(const Params &p)
+    : SimObject(p),
+      enabled(p.enabled),
+      replay(p.selectiveReplay),
+      maxDistance(p.maxDistance),
+      confidenceThreshold(p.confidenceThreshold),
+      distanceMask(p.tableSize - 1),
+      storeMask(p.storeTableSize - 1),
+      distanceTable(p.tableSize, DistanceEntry(p.confidenceBits)),
+      storeTable(p.storeTableSize),
+      stats(this)
+{
+    fatal_if(!isPowerOf2(p.tableSize),
+             "Memory renaming table size must be a power of 2, got %d",
+             p.tableSize);
+    fatal_if(!isPowerOf2(p.storeTableSize),
+             "Memory renaming store table size must be a power of 2, "
+             "got %d", p.storeTableSize);
+    fatal_if(p.confidenceThreshold > (1U << p.confidenceBits) - 1,
+             "Memory renaming confidence threshold %d is unreachable with "
+             "%d bits", p.confidenceThreshold, p.confidenceBits);
+    fatal_if(maxDistance == 0, "Memory renaming needs a non-zero maximum "
+             "store distance");
+}
+
+bool
+MemoryRenamer::renameable(const DynInstPtr &inst)
+{
+    if (inst->numDestRegs() != 1)
+        return false;
+
+    PhysRegIdPtr dest = inst->renamedDestIdx(0);
+    return dest->classValue() == IntRegClass && !dest->isAlwaysReady();
+}
+
+MemoryRenamer::InflightStore *
+MemoryRenamer::findStore(ThreadID tid, InstSeqNum seq_num)
+{
+    auto &stores = inflight[tid];
+    auto it = std::lower_bound(stores.begin(), stores.end(), seq_num,
+        [](const InflightStore &store, InstSeqNum seq) {
+            return store.seqNum < seq;
+        });
+    if (it == stores.end() || it->seqNum != seq_num)
+        return nullptr;
+    return &*it;
+}
+
+void
+MemoryRenamer::rename(const DynInstPtr &inst)
+{
+    if (!enabled)
+        return;
+
+    ThreadID tid = inst->threadNumber;
+
+    if (countsAsStore(inst)) {
+        inflight[tid].push_back(
+            {inst->seqNum, inst->isDataIndependentTiming()});
+        return;
+    }
+
+    if (!inst->isLoad() || !renameable(inst))
+        return;
+
+    Addr pc = inst->pcState().instAddr();
+    DistanceEntry &entry = distanceEntry(pc);
+    if (!entry.valid || entry.tag != pc)
+        return;
+
+    if (entry.confidence < confidenceThreshold) {
+        ++stats.notConfident;
+        return;
+    }
+
+    auto &stores = inflight[tid];
+    if (entry.distance > stores.size()) {
+        // The producer has already committed.
+        ++stats.noStore;
+        return;
+    }
+
+    const InflightStore &store = stores[stores.size() - entry.distance];
+    if (inst->isDataIndependentTiming() || store.dit) {
+        ++stats.ditSuppressed;
+        return;
+    }
+
+    links[tid][inst->seqNum] = Link{store.seqNum};
+    ++stats.linked;
+
+    DPRINTF(MemRename, "[tid:%i] [sn:%llu] Linked load PC %s to store "
+            "[sn:%llu] at distance %d\n", tid, inst->seqNum,
+            inst->pcState(), store.seqNum, entry.distance);
+}
+
+void
+MemoryRenamer::storeData(const DynInstPtr &store, const uint8_t *data,
+                         unsigned size, ByteOrder order,
+                         std::vector<DynInstPtr> &ready, RegVal &value)
+{
+    if (!enabled)
+        return;
+
+    InflightStore *entry = findStore(store->threadNumber, store->seqNum);
+    if (!entry || entry->dit)
+        return;
+
+    if (size == 0 || size > sizeof(RegVal)) {
+        entry->dataValid = false;
+        return;
+    }
+
+    RegVal data_value = 0;
+    for (unsigned i = 0; i < size; i++) {
+        unsigned shift = order == ByteOrder::little ? i : size - 1 - i;
+        data_value |= RegVal(data[i]) << (8 * shift);
+    }
+
+    entry->value = data_value;
+    entry->dataValid = true;
+
+    ready.insert(ready.end(), entry->waiting.begin(), entry->waiting.end());
+    entry->waiting.clear();
+    value = data_value;
+
+    DPRINTF(MemRename, "[tid:%i] [sn:%llu] Store data %#x, %d waiting "
+            "loads\n", store->threadNumber, store->seqNum, data_value,
+            ready.size());
+}
+
+bool
+MemoryRenamer::dispatch(const DynInstPtr &load, RegVal &value)
+{
+    ThreadID tid = load->threadNumber;
+    auto it = links[tid].find(load->seqNum);
+    if (it == links[tid].end())
+        return false;
+
+    InflightStore *store = findStore(tid, it->second.storeSeqNum);
+    if (!store) {
+        // The store committed while the load was waiting to dispatch;
+        // the load reads its data from the cache as usual.
+        links[tid].erase(it);
+        return false;
+    }
+
+    if (store->dataValid) {
+        value = store->value;
+        return true;
+    }
+
+    store->waiting.push_back(load);
+    return false;
+}
+
+void
+MemoryRenamer::bypassed(const DynInstPtr &load, RegVal value)
+{
+    auto it = links[load->threadNumber].find(load->seqNum);
+    assert(it != links[load->threadNumber].end());
+
+    it->second.bypassed = true;
+    it->second.value = value;
+    ++stats.bypassed;
+}
+
+bool
+MemoryRenamer::validate(const DynInstPtr &load, RegVal actual)
+{
+    auto it = links[load->threadNumber].find(load->seqNum);
+    if (it == links[load->threadNumber].end() || !it->second.bypassed)
+        return true;
+
+    if (it->second.value == actual) {
+        ++stats.correct;
+        return true;
+    }
+
+    ++stats.incorrect;
+
+    Addr pc = load->pcState().instAddr();
+    DistanceEntry &entry = distanceEntry(pc);
+    if (entry.valid && entry.tag == pc)
+        entry.confidence.reset();
+
+    DPRINTF(MemRename, "[tid:%i] [sn:%llu] Wrong link for load PC %s: "
+            "bypassed %#x, actual %#x\n", load->threadNumber, load->seqNum,
+            load->pcState(), it->second.value, actual);
+    return false;
+}
+
+void
+MemoryRenamer::squash(InstSeqNum squashed_seq_num, ThreadID tid)
+{
+    if (!enabled)
+        return;
+
+    auto &stores = inflight[tid];
+    while (!stores.empty() && stores.back().seqNum > squashed_seq_num)
+        stores.pop_back();
+
+    for (auto &store : stores) {
+        auto &waiting = store.waiting;
+        waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+            [squashed_seq_num](const DynInstPtr &load) {
+                return load->seqNum > squashed_seq_num;
+            }), waiting.end());
+    }
+
+    for (auto it = links[tid].begin(); it != links[tid].end(); ) {
+        if (it->first > squashed_seq_num)
+            it = links[tid].erase(it);
+        else
+            ++it;
+    }
+}
+
+void
+MemoryRenamer::commit(const DynInstPtr &inst, CPU *cpu)
+{
+    if (!enabled)
+        return;
+
+    ThreadID tid = inst->threadNumber;
+
+    if (countsAsStore(inst)) {
+        auto &stores = inflight[tid];
+        bool data_valid = false;
+        RegVal value = 0;
+        while (!stores.empty() && stores.front().seqNum <= inst->seqNum) {
+            if (stores.front().seqNum == inst->seqNum) {
+                data_valid = stores.front().dataValid;
+                value = stores.front().value;
+            }
+            stores.pop_front();
+        }
+
+        uint64_t store_num = committedStores[tid]++;
+        if (!inst->effAddrValid())
+            return;
+
+        CommittedStore &entry = committedStore(inst->effAddr);
+        entry.addr = inst->effAddr;
+        entry.size = inst->effSize;
+        entry.tid = tid;
+        entry.storeNum = store_num;
+        entry.dataValid = data_valid;
+        entry.value = value;
+        entry.valid = true;
+        return;
+    }
+
+    if (!inst->isLoad())
+        return;
+
+    links[tid].erase(inst->seqNum);
+
+    if (!renameable(inst) || !inst->effAddrValid() ||
+        inst->isDataIndependentTiming())
+        return;
+
+    Addr pc = inst->pcState().instAddr();
+    RegVal value = cpu->getReg(inst->renamedDestIdx(0), tid);
+
+    // The load was produced by a committed store if it read exactly the
+    // bytes that store wrote and got the store's value unchanged (no
+    // sign extension or partial overwrite in between).
+    const CommittedStore &store = committedStore(inst->effAddr);
+    uint64_t distance = committedStores[tid] - store.storeNum;
+    bool produced = store.valid && store.tid == tid &&
+        store.addr == inst->effAddr && store.size == inst->effSize &&
+        store.dataValid && store.value == value && distance <= maxDistance;
+
+    DistanceEntry &entry = distanceEntry(pc);
+    if (produced) {
+        if (entry.valid && entry.tag == pc && entry.distance == distance) {
+            entry.confidence++;
+        } else {
+            entry.tag = pc;
+            entry.distance = distance;
+            entry.confidence.reset();
+            entry.valid = true;
+        }
+        ++stats.trained;
+    } else if (entry.valid && entry.tag == pc) {
+        entry.confidence.reset();
+    }
+}
+
+MemoryRenamer::MemoryRenamerStats::MemoryRenamerStats(MemoryRenamer *mr)
+    : statistics::Group(mr),
+      ADD_STAT(linked, statistics::units::Count::get(),
+               "Number of loads linked to an in-flight store at rename"),
+      ADD_STAT(notConfident, statistics::units::Count::get(),
+               "Number of loads not linked due to low confidence"),
+      ADD_STAT(noStore, statistics::units::Count::get(),
+               "Number of confident loads whose store had already "
+               "committed"),
+      ADD_STAT(ditSuppressed, statistics::units::Count::get(),
+               "Number of links suppressed by data-independent timing"),
+      ADD_STAT(bypassed, statistics::units::Count::get(),
+               "Number of linked loads that received the store data "
+               "before issuing"),
+      ADD_STAT(correct, statistics::units::Count::get(),
+               "Number of bypassed loads whose value was correct"),
+      ADD_STAT(incorrect, statistics::units::Count::get(),
+               "Number of bypassed loads whose value was wrong"),
+      ADD_STAT(trained, statistics::units::Count::get(),
+               "Number of committed loads produced by a recent store"),
+      ADD_STAT(accuracy, statistics::units::Ratio::get(),
+               "Memory renaming accuracy",
+               correct / (correct + incorrect)),
+      ADD_STAT(coverage, statistics::units::Ratio::get(),
+               "Fraction of linked loads that were bypassed",
+               bypassed / linked)
+{
+    accuracy.precision(6);
+    coverage.precision(6);
+}
+
+} // namespace o3
+} // namespace gem5
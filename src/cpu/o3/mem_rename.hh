@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_O3_MEM_RENAME_HH__
+#define __CPU_O3_MEM_RENAME_HH__
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/limits.hh"
+#include "enums/ByteOrder.hh"
+#include "params/MemoryRenamer.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+class CPU;
+
+/**
+ * Memory renaming unit.
+ *
+ * A store-distance predictor links a load to the in-flight store that
+ * produced its value, so that the load's result is available as soon as
+ * the store's data is, without waiting for the load to issue and search
+ * the store queue. The distance is the number of stores between the load
+ * and its producer; it is learned at commit by matching each committed
+ * load against a small table of the most recently committed stores.
+ *
+ * The link is made at rename. Once the linked store has written its data
+ * to the store queue and the load sits in the IQ, the data is written to
+ * the load's destination register and its dependents are woken through
+ * the value prediction path. The load still executes; its real value is
+ * checked at writeback and a mismatch is recovered like a load value
+ * misprediction.
+ *
+ * Only loads with a single integer destination register and stores of up
+ * to 8 bytes are renamed. Neither is linked when renamed under
+ * data-independent timing.
+ *
+ * Integration points:
+ *  - Link at rename (Rename::renameInsts)
+ *  - Capture store data (LSQUnit::write)
+ *  - Bypass at dispatch or store data (IEW)
+ *  - Validate at writeback (IEW::writebackInsts)
+ *  - Train at commit (Commit::commitInsts)
+ */
+class MemoryRenamer : public SimObject
+{
+  public:
+    PARAMS(MemoryRenamer);
+
+    MemoryRenamer(const Params &p);
+
+    /** Check if memory renaming is enabled. */
+    bool isEnabled() const { return enabled; }
+
+    /** Whether mispredictions are recovered by selective replay. */
+    bool selectiveReplay() const { return replay; }
+
+    /**
+     * Record a renamed store, or link a renamed load to an in-flight
+     * store if its predicted store distance is confident.
+     */
+    void rename(const DynInstPtr &inst);
+
+    /**
+     * Record the data a store wrote to the store queue.
+     * @param store The store instruction.
+     * @param data The store data in memory order.
+     * @param size Number of bytes stored.
+     * @param order Guest byte order.
+     * @param ready Output: dispatched loads linked to the store that can
+     *              now be bypassed.
+     * @param value Output: value to bypass to the loads in ready.
+     */
+    void storeData(const DynInstPtr &store, const uint8_t *data,
+                   unsigned size, ByteOrder order,
+                   std::vector<DynInstPtr> &ready, RegVal &value);
+
+    /**
+     * Look up a dispatched load's link. If the linked store's data is
+     * already known it can be bypassed straight away; otherwise the load
+     * waits for storeData().
+     * @param value Output: value to bypass.
+     * @return true if the value can be bypassed now.
+     */
+    bool dispatch(const DynInstPtr &load, RegVal &value);
+
+    /** Note that a bypassed value was written to a load's destination. */
+    void bypassed(const DynInstPtr &load, RegVal value);
+
+    /**
+     * Check a bypassed load against its actual value. A wrong link
+     * clears the confidence of the load's distance.
+     * @return true if the bypassed value was correct.
+     */
+    bool validate(const DynInstPtr &load, RegVal actual);
+
+    /** Drop stores and links younger than the squash point. */
+    void squash(InstSeqNum squashed_seq_num, ThreadID tid);
+
+    /**
+     * Retire a committed store or load. Stores are recorded in the
+     * committed store table; loads train their store distance.
+     */
+    void commit(const DynInstPtr &inst, CPU *cpu);
+
+    /**
+     * Whether a load could be renamed: it must have a single integer
+     * destination register.
+     */
+    static bool renameable(const DynInstPtr &inst);
+
+  private:
+    /** A renamed store that has not committed yet. */
+    struct InflightStore
+    {
+        InstSeqNum seqNum;
+        bool dit;
+        bool dataValid = false;
+        RegVal value = 0;
+        /** Dispatched loads waiting for the data. */
+        std::vector<DynInstPtr> waiting;
+    };
+
+    /** Link of an in-flight load to its predicted producer. */
+    struct Link
+    {
+        InstSeqNum storeSeqNum;
+        bool bypassed = false;
+        RegVal value = 0;
+    };
+
+    /** Store distance predictor entry, indexed by load PC. */
+    struct DistanceEntry
+    {
+        Addr tag = 0;
+        unsigned distance = 0;
+        SatCounter8 confidence;
+        bool valid = false;
+
+        DistanceEntry(unsigned bits) : confidence(bits, 0) {}
+    };
+
+    /** Recently committed store, indexed by address. */
+    struct CommittedStore
+    {
+        Addr addr = 0;
+        unsigned size = 0;
+        ThreadID tid = 0;
+        /** Committed store count of the thread when it committed. */
+        uint64_t storeNum = 0;
+        bool dataValid = false;
+        RegVal value = 0;
+        bool valid = false;
+    };
+
+    /** Find an in-flight store of a thread by sequence number. */
+    InflightStore *findStore(ThreadID tid, InstSeqNum seq_num);
+
+    DistanceEntry &
+    distanceEntry(Addr pc)
+    {
+        return distanceTable[(pc >> 2) & distanceMask];
+    }
+
+    CommittedStore &
+    committedStore(Addr addr)
+    {
+        return storeTable[(addr >> 2) & storeMask];
+    }
+
+    /** Whether memory renaming is enabled. */
+    const bool enabled;
+
+    /** Whether mispredictions are recovered by selective replay. */
+    const bool replay;
+
+    /** Largest store distance that is predicted. */
+    const unsigned maxDistance;
+
+    /** Minimum confidence to link a load. */
+    const unsigned confidenceThreshold;
+
+    const unsigned distanceMask;
+    const unsigned storeMask;
+
+    std::vector<DistanceEntry> distanceTable;
+    std::vector<CommittedStore> storeTable;
+
+    /** Per-thread renamed stores, oldest first. */
+    std::deque<InflightStore> inflight[MaxThreads];
+
+    /** Per-thread links of in-flight loads, by load sequence number. */
+    std::unordered_map<InstSeqNum, Link> links[MaxThreads];
+
+    /** Per-thread number of committed stores. */
+    uint64_t committedStores[MaxThreads] = {};
+
+    struct MemoryRenamerStats : public statistics::Group
+    {
+        MemoryRenamerStats(MemoryRenamer *mr);
+
+        statistics::Scalar linked;
+        statistics::Scalar notConfident;
+        statistics::Scalar noStore;
+        statistics::Scalar ditSuppressed;
+        statistics::Scalar bypassed;
+        statistics::Scalar correct;
+        statistics::Scalar incorrect;
+        statistics::Scalar trained;
+        statistics::Formula accuracy;
+        statistics::Formula coverage;
+    } stats;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_MEM_RENAME_HH__
@@ -0,0 +1,23 @@
+from m5.params import *
+from m5.objects.Probe import *
+
+
+class PipeTrace(ProbeListenerObject):
+    type = "PipeTrace"
+    cxx_class = "gem5::o3::PipeTrace"
+    cxx_header = "cpu/o3/probe/pipe_trace.hh"
+
+    # The trace is created in the output directory, prefixed by the name
+    # of this object. util/decode_pipe_trace.py turns it into O3PipeView
+    # or Konata text.
+    traceFile = Param.String(
+        "pipetrace.pb.gz", "Protobuf trace file name for pipeline timelines"
+    )
+    # Interval sampling: an instruction is recorded when its fetch tick
+    # falls in the first sampleLength ticks of a sampleInterval window.
+    sampleInterval = Param.Latency(
+        "0", "Sampling window period, zero records every instruction"
+    )
+    sampleLength = Param.Latency(
+        "0", "Part of each sampling window that is recorded"
+    )
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/o3/probe/pipe_trace.hh"
+
+#include "base/callback.hh"
+#include "base/output.hh"
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+PipeTrace::PipeTrace(const PipeTraceParams &params)
+    : ProbeListenerObject(params),
+      cpu(dynamic_cast<CPU *>(params.manager)),
+      traceStream(nullptr),
+      sampleInterval(params.sampleInterval),
+      sampleLength(params.sampleLength),
+      stats(this)
+{
+    fatal_if(!cpu, "Manager of %s is not of type O3CPU and thus does not "
+             "support pipeline tracing.\n", name());
+    fatal_if(params.traceFile == "", "Assign the pipeline trace file path "
+             "to traceFile");
+    fatal_if(sampleInterval && (!sampleLength ||
+                                sampleLength > sampleInterval),
+             "%s: sampleLength must be non-zero and at most "
+             "sampleInterval.\n", name());
+
+    traceStream = new ProtoOutputStream(
+        simout.resolve(name() + "." + params.traceFile));
+
+    ProtoMessage::PipeTraceHeader header;
+    header.set_obj_id(name());
+    header.set_tick_freq(sim_clock::Frequency);
+    header.set_clock_period(cpu->clockPeriod());
+    traceStream->write(header);
+
+    registerExitCallback([this]() { flushTrace(); });
+}
+
+void
+PipeTrace::regProbeListeners()
+{
+    connectListener<ProbeListenerArg<PipeTrace, DynInstConstPtr>>(
+        this, "Commit", &PipeTrace::traceCommit);
+    connectListener<ProbeListenerArg<PipeTrace, DynInstConstPtr>>(
+        this, "Squash", &PipeTrace::traceSquash);
+}
+
+void
+PipeTrace::traceCommit(const DynInstConstPtr &inst)
+{
+    record(inst, false);
+}
+
+void
+PipeTrace::traceSquash(const DynInstConstPtr &inst)
+{
+    record(inst, true);
+}
+
+bool
+PipeTrace::sampled(Tick fetch_tick) const
+{
+    return !sampleInterval || fetch_tick % sampleInterval < sampleLength;
+}
+
+void
+PipeTrace::record(const DynInstConstPtr &inst, bool squashed)
+{
+    // fetchTick is left at -1 for instructions fetched before the CPU
+    // started keeping time, there is nothing to place them against.
+    if (!traceStream || inst->fetchTick == (Tick)-1)
+        return;
+
+    if (!sampled(inst->fetchTick)) {
+        stats.unsampled++;
+        return;
+    }
+
+    const PCStateBase &pc = inst->pcState();
+
+    ProtoMessage::PipeTraceRecord rec;
+    rec.set_seq_num(inst->seqNum);
+    rec.set_pc(pc.instAddr());
+    rec.set_upc(pc.microPC());
+    rec.set_tid(inst->threadNumber);
+    rec.set_fetch_tick(inst->fetchTick);
+
+    // Stage deltas are -1 until the stage is reached.
+    if (inst->decodeTick != -1)
+        rec.set_decode(inst->decodeTick);
+    if (inst->renameTick != -1)
+        rec.set_rename(inst->renameTick);
+    if (inst->dispatchTick != -1)
+        rec.set_dispatch(inst->dispatchTick);
+    if (inst->issueTick != -1)
+        rec.set_issue(inst->issueTick);
+    if (inst->completeTick != -1)
+        rec.set_complete(inst->completeTick);
+    if (!squashed && inst->commitTick != -1)
+        rec.set_commit(inst->commitTick);
+    if (squashed)
+        rec.set_squashed(true);
+
+    uint32_t flags = 0;
+    if (inst->isValuePredicted())
+        flags |= ProtoMessage::PipeTraceRecord::ValuePredicted;
+    if (inst->isCompSimplified())
+        flags |= ProtoMessage::PipeTraceRecord::CompSimplified;
+    if (inst->isMemRenamed())
+        flags |= ProtoMessage::PipeTraceRecord::MemRenamed;
+    if (inst->isEliminated())
+        flags |= ProtoMessage::PipeTraceRecord::Eliminated;
+    if (flags)
+        rec.set_flags(flags);
+
+    if (knownInsts.emplace(pc.instAddr(), pc.microPC()).second)
+        rec.set_disasm(inst->staticInst->disassemble(pc.instAddr()));
+
+    traceStream->write(rec);
+
+    if (squashed)
+        stats.squashed++;
+    else
+        stats.committed++;
+}
+
+void
+PipeTrace::flushTrace()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+PipeTrace::PipeTraceStats::PipeTraceStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(committed, statistics::units::Count::get(),
+               "Number of committed instructions recorded"),
+      ADD_STAT(squashed, statistics::units::Count::get(),
+               "Number of squashed instructions recorded"),
+      ADD_STAT(unsampled, statistics::units::Count::get(),
+               "Number of instructions skipped by interval sampling")
+{
+}
+
+} // namespace o3
+} // namespace gem5
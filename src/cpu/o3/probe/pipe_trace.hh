@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file This file declares a probe listener that records the per-stage
+ * timing of every instruction leaving the O3 ROB into a protobuf stream.
+ * Compared with the O3PipeView debug output the trace is compact, can be
+ * sampled over intervals, and does not need a TRACING_ON build.
+ */
+
+#ifndef __CPU_O3_PROBE_PIPE_TRACE_HH__
+#define __CPU_O3_PROBE_PIPE_TRACE_HH__
+
+#include <set>
+#include <utility>
+
+#include "base/statistics.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "params/PipeTrace.hh"
+#include "proto/pipe_trace.pb.h"
+#include "proto/protoio.hh"
+#include "sim/probe/probe_listener_object.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+class CPU;
+
+class PipeTrace : public ProbeListenerObject
+{
+  public:
+    PipeTrace(const PipeTraceParams &params);
+
+    /** Register the probe listeners. */
+    void regProbeListeners() override;
+
+  private:
+    /** Record an instruction committed from the ROB head. */
+    void traceCommit(const DynInstConstPtr &inst);
+
+    /** Record a squashed instruction removed from the ROB. */
+    void traceSquash(const DynInstConstPtr &inst);
+
+    /** Write one record unless the instruction is outside the sample. */
+    void record(const DynInstConstPtr &inst, bool squashed);
+
+    /** Whether an instruction fetched at a tick falls in the sample. */
+    bool sampled(Tick fetch_tick) const;
+
+    /** Close the output stream at simulation exit. */
+    void flushTrace();
+
+    /** Pointer to the O3CPU that owns the probe points. */
+    CPU *cpu;
+
+    /** Protobuf output stream for the trace, null once closed. */
+    ProtoOutputStream *traceStream;
+
+    /** Sampling window period in ticks, zero to record everything. */
+    const Tick sampleInterval;
+
+    /** Number of ticks recorded at the start of each window. */
+    const Tick sampleLength;
+
+    /** Static instructions whose disassembly has already been written. */
+    std::set<std::pair<Addr, MicroPC>> knownInsts;
+
+    struct PipeTraceStats : public statistics::Group
+    {
+        PipeTraceStats(statistics::Group *parent);
+
+        /** Committed instructions written to the trace. */
+        statistics::Scalar committed;
+        /** Squashed instructions written to the trace. */
+        statistics::Scalar squashed;
+        /** Instructions dropped by interval sampling. */
+        statistics::Scalar unsampled;
+    } stats;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_PROBE_PIPE_TRACE_HH__
@@ -81,11 +81,14 @@ std::string Rename::RenameStats::statusDefinitions[ThreadStatusMax] = {
 
 Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
     : cpu(_cpu),
+      memRenamer(params.memoryRenamer),
       iewToRenameDelay(params.iewToRenameDelay),
       decodeToRenameDelay(params.decodeToRenameDelay),
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
       numThreads(params.numThreads),
+      moveElimination(params.moveElimination),
+      zeroIdiomElimination(params.zeroIdiomElimination),
       stats(_cpu)
 {
     if (renameWidth > MaxWidth)
@@ -160,7 +163,13 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
       ADD_STAT(intReturned, statistics::units::Count::get(),
                "count of registers freed and written back to integer free list"),
       ADD_STAT(fpReturned, statistics::units::Count::get(),
-               "count of registers freed and written back to floating point free list")
+               "count of registers freed and written back to floating point free list"),
+      ADD_STAT(ditInsts, statistics::units::Count::get(),
+               "count of insts renamed under data-independent timing"),
+      ADD_STAT(movesEliminated, statistics::units::Count::get(),
+               "count of register moves eliminated at rename"),
+      ADD_STAT(zeroIdiomsEliminated, statistics::units::Count::get(),
+               "count of zero idioms eliminated at rename")
 
 {
     status.init(ThreadStatusMax).flags(statistics::pdf | statistics::nozero);
@@ -194,6 +203,9 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
 
     intReturned.prereq(intReturned);
     fpReturned.prereq(fpReturned);
+    ditInsts.prereq(ditInsts);
+    movesEliminated.prereq(movesEliminated);
+    zeroIdiomsEliminated.prereq(zeroIdiomsEliminated);
 }
 
 void
@@ -476,6 +488,43 @@ Rename::tick()
 
 }
 
+bool
+Rename::canSkipCycles()
+{
+    for (ThreadID tid : *activeThreads) {
+        if (!freeingInProgress[tid].empty()) {
+            return false;
+        }
+
+        // Blocked waits for resources, Running and Idle for instructions.
+        if (renameStatus[tid] == Blocked) {
+            if (!checkStall(tid)) {
+                return false;
+            }
+        } else if (renameStatus[tid] == Running ||
+                   renameStatus[tid] == Idle) {
+            if (checkStall(tid) || !insts[tid].empty()) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+Rename::skipCycles(Cycles cycles)
+{
+    for (ThreadID tid : *activeThreads) {
+        if (renameStatus[tid] == Blocked) {
+            stats.status[Blocked] += cycles;
+        } else {
+            stats.status[Idle] += cycles;
+        }
+    }
+}
+
 void
 Rename::rename(bool &status_change, ThreadID tid)
 {
@@ -599,6 +648,10 @@ Rename::renameInsts(ThreadID tid)
     InstQueue &insts_to_rename = renameStatus[tid] == Unblocking ?
         skidBuffer[tid] : insts[tid];
 
+    // Writes to the DIT control are serialize-after, so every instruction
+    // renamed here executes under the architecturally committed setting.
+    const bool dit = cpu->tcBase(tid)->getIsaPtr()->dataIndependentTiming();
+
     DPRINTF(Rename,
             "[tid:%i] "
             "%i available instructions to send iew.\n",
@@ -743,7 +796,16 @@ Rename::renameInsts(ThreadID tid)
 
         renameSrcRegs(inst, inst->threadNumber);
 
-        renameDestRegs(inst, inst->threadNumber);
+        if (!eliminate(inst, inst->threadNumber))
+            renameDestRegs(inst, inst->threadNumber);
+
+        if (dit) {
+            inst->setDataIndependentTiming();
+            ++stats.ditInsts;
+        }
+
+        if (memRenamer && (inst->isMemRef() || inst->isAtomic()))
+            memRenamer->rename(inst);
 
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
@@ -972,8 +1034,11 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // register is unreachable until it gets recycled as a new destination
         // register (it will be marked as busy anyway next time it gets used).
         // This is instead required for fixed mapping registers which could
-        // be rereferenced as a source registers after the squash
-        scoreboard->setReg(hb_it->newPhysReg);
+        // be rereferenced as a source registers after the squash.
+        // A register shared by an eliminated move still belongs to an
+        // older instruction, which may not have written it yet.
+        if (!hb_it->shared)
+            scoreboard->setReg(hb_it->newPhysReg);
 
         // Notify potential listeners that the register mapping needs to be
         // removed because the instruction it was mapped to got squashed. Note
@@ -1043,6 +1108,87 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
     }
 }
 
+bool
+Rename::eliminate(const DynInstPtr &inst, ThreadID tid)
+{
+    if (!moveElimination && !zeroIdiomElimination)
+        return false;
+
+    if (inst->numDestRegs() != 1 || inst->isControl() || inst->isMemRef() ||
+        inst->isNonSpeculative() || inst->isSerializing())
+        return false;
+
+    const RegId &dest_reg = inst->destRegIdx(0);
+    if (!dest_reg.is(IntRegClass) || dest_reg.getNumPinnedWrites() != 0)
+        return false;
+
+    int src_idx;
+    if (moveElimination && inst->staticInst->isRegMove(src_idx)) {
+        UnifiedRenameMap *map = renameMap[tid];
+        RegId flat_dest_regid = dest_reg.flatten(*inst->tcBase()->getIsaPtr());
+        PhysRegIdPtr src_reg = inst->renamedSrcIdx(src_idx);
+        PhysRegIdPtr prev_reg = map->lookup(flat_dest_regid);
+
+        if (!src_reg->is(IntRegClass) || src_reg->isPinned() ||
+            prev_reg->getNumPinnedWrites() != 0)
+            return false;
+
+        UnifiedRenameMap::RenameInfo rename_result =
+            map->renameShared(flat_dest_regid, src_reg);
+
+        inst->flattenedDestIdx(0, flat_dest_regid);
+
+        DPRINTF(Rename, "[tid:%i] [sn:%llu] Eliminated move, arch reg %i "
+                "shares physical reg %i (%i).\n", tid, inst->seqNum,
+                dest_reg.index(), src_reg->index(), src_reg->flatIndex());
+
+        // Undoing or committing the mapping releases one mapping of the
+        // shared register, like any other rename.
+        historyBuffer[tid].push_front(RenameHistory(inst->seqNum,
+                    flat_dest_regid, rename_result.first,
+                    rename_result.second, true));
+
+        inst->renameDestReg(0, rename_result.first, rename_result.second);
+        inst->setEliminated();
+
+        ++stats.renamedOperands;
+        ++stats.movesEliminated;
+        return true;
+    }
+
+    if (zeroIdiomElimination && inst->staticInst->isZeroIdiom()) {
+        renameDestRegs(inst, tid);
+
+        PhysRegIdPtr dest = inst->renamedDestIdx(0);
+        cpu->setReg(dest, (RegVal)0, tid);
+        scoreboard->setReg(dest);
+        inst->setEliminated();
+
+        DPRINTF(Rename, "[tid:%i] [sn:%llu] Eliminated zero idiom, physical "
+                "reg %i (%i) set to zero.\n", tid, inst->seqNum,
+                dest->index(), dest->flatIndex());
+
+        ++stats.zeroIdiomsEliminated;
+        return true;
+    }
+
+    return false;
+}
+
+void
+Rename::replacePrevReg(const RegId &arch_reg, PhysRegIdPtr old_reg,
+                       PhysRegIdPtr new_reg, ThreadID tid)
+{
+    // The history buffer is ordered youngest first.
+    for (auto it = historyBuffer[tid].rbegin();
+         it != historyBuffer[tid].rend(); ++it) {
+        if (it->archReg == arch_reg && it->prevPhysReg == old_reg) {
+            it->prevPhysReg = new_reg;
+            return;
+        }
+    }
+}
+
 void
 Rename::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
 {
@@ -196,9 +196,25 @@ class Rename
      */
     void tick();
 
+    /** Would a tick leave rename unchanged apart from its per-cycle
+     * statistics? */
+    bool canSkipCycles();
+
+    /** Accounts the statistics of cycles in which the CPU skipped the
+     * tick because canSkipCycles() was true. */
+    void skipCycles(Cycles cycles);
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
+    /**
+     * Replaces the committed physical register of an architectural
+     * register in the rename history, so that the oldest in-flight rename
+     * of the register releases new_reg instead of old_reg.
+     */
+    void replacePrevReg(const RegId &arch_reg, PhysRegIdPtr old_reg,
+                        PhysRegIdPtr new_reg, ThreadID tid);
+
   private:
     /** Reset this pipeline stage */
     void resetStage();
@@ -255,6 +271,16 @@ class Rename
     /** Renames the destination registers of an instruction. */
     void renameDestRegs(const DynInstPtr &inst, ThreadID tid);
 
+    /**
+     * Eliminates a register move, by mapping its destination onto its
+     * source's physical register, or a zero idiom, by writing zero to its
+     * new destination register. Either way the instruction is complete
+     * once renamed and does not execute.
+     * @return true if the instruction was eliminated; its destination
+     * register has then been renamed.
+     */
+    bool eliminate(const DynInstPtr &inst, ThreadID tid);
+
     /** Should we SerializeBefore the current instruction */
     void handleMiscRegWaW(DynInstPtr &inst, ThreadID tid);
 
@@ -302,9 +328,10 @@ class Rename
     {
         RenameHistory(InstSeqNum _instSeqNum, const RegId& _archReg,
                       PhysRegIdPtr _newPhysReg,
-                      PhysRegIdPtr _prevPhysReg)
+                      PhysRegIdPtr _prevPhysReg, bool _shared = false)
             : instSeqNum(_instSeqNum), archReg(_archReg),
-              newPhysReg(_newPhysReg), prevPhysReg(_prevPhysReg)
+              newPhysReg(_newPhysReg), prevPhysReg(_prevPhysReg),
+              shared(_shared)
         {
         }
 
@@ -317,6 +344,10 @@ class Rename
         /** The old physical register that the arch. register was renamed to.
          */
         PhysRegIdPtr prevPhysReg;
+        /** The new physical register was already allocated to an older
+         * instruction (eliminated move).
+         */
+        bool shared;
     };
 
     /** A per-thread list of all destination register renames, used to either
@@ -372,6 +403,9 @@ class Rename
     /** Pointer to the scoreboard. */
     Scoreboard *scoreboard;
 
+    /** Memory renaming unit, links loads to in-flight stores. */
+    MemoryRenamer *memRenamer;
+
     /** Count of instructions in progress that have been sent off to the IQ
      * and ROB, but are not yet included in their occupancy counts.
      */
@@ -463,6 +497,12 @@ class Rename
     /** The number of threads active in rename. */
     ThreadID numThreads;
 
+    /** Eliminate register moves at rename. */
+    const bool moveElimination;
+
+    /** Eliminate zero idioms at rename. */
+    const bool zeroIdiomElimination;
+
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
@@ -536,6 +576,12 @@ class Rename
         statistics::Scalar intReturned;
         /** Number of registers freed and written back to floating point free list*/
         statistics::Scalar fpReturned;
+        /** Number of instructions renamed under data-independent timing. */
+        statistics::Scalar ditInsts;
+        /** Number of register moves eliminated at rename. */
+        statistics::Scalar movesEliminated;
+        /** Number of zero idioms eliminated at rename. */
+        statistics::Scalar zeroIdiomsEliminated;
     } stats;
 };
 
@@ -108,14 +108,37 @@ SimpleRenameMap::rename(const RegId& arch_reg)
 
 void
 UnifiedRenameMap::init(const BaseISA::RegClasses &regClasses,
-        PhysRegFile *_regFile, UnifiedFreeList *freeList)
+        PhysRegFile *_regFile, UnifiedFreeList *_freeList)
 {
     regFile = _regFile;
+    freeList = _freeList;
 
     for (int i = 0; i < renameMaps.size(); i++)
         renameMaps[i].init(*regClasses.at(i), &(freeList->freeLists[i]));
 }
 
+UnifiedRenameMap::RenameInfo
+UnifiedRenameMap::renameShared(const RegId& arch_reg, PhysRegIdPtr phys_reg)
+{
+    assert(arch_reg.isRenameable());
+    assert(phys_reg->is(arch_reg.classValue()));
+
+    PhysRegIdPtr prev_reg = lookup(arch_reg);
+
+    // Remapping a register onto itself needs no extra mapping; the
+    // history entry is then treated like a fixed mapping and neither
+    // freed nor undone.
+    if (prev_reg != phys_reg) {
+        setEntry(arch_reg, phys_reg);
+        freeList->shareReg(phys_reg);
+    }
+
+    DPRINTF(Rename, "Shared phys reg %d with reg %d, old mapping was %d\n",
+            phys_reg->flatIndex(), arch_reg, prev_reg->flatIndex());
+
+    return RenameInfo(phys_reg, prev_reg);
+}
+
 bool
 UnifiedRenameMap::canRename(DynInstPtr inst) const
 {
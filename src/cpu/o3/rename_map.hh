@@ -178,6 +178,9 @@ class UnifiedRenameMap
      */
     PhysRegFile *regFile;
 
+    /** The free list, which counts the sharers of shared registers. */
+    UnifiedFreeList *freeList;
+
   public:
 
     typedef SimpleRenameMap::RenameInfo RenameInfo;
@@ -185,14 +188,14 @@ class UnifiedRenameMap
     typedef std::array<UnifiedRenameMap, MaxThreads> PerThreadUnifiedRenameMap;
 
     /** Default constructor.  init() must be called prior to use. */
-    UnifiedRenameMap() : regFile(nullptr) {};
+    UnifiedRenameMap() : regFile(nullptr), freeList(nullptr) {};
 
     /** Destructor. */
     ~UnifiedRenameMap() {};
 
     /** Initializes rename map with given parameters. */
     void init(const BaseISA::RegClasses &regClasses,
-              PhysRegFile *_regFile, UnifiedFreeList *freeList);
+              PhysRegFile *_regFile, UnifiedFreeList *_freeList);
 
     /**
      * Tell rename map to get a new free physical register to remap
@@ -221,6 +224,18 @@ class UnifiedRenameMap
         return renameMaps[arch_reg.classValue()].rename(arch_reg);
     }
 
+    /**
+     * Map an architectural register onto a physical register that is
+     * already allocated, e.g. the source of an eliminated move, instead
+     * of a free one. The physical register is only freed once all of its
+     * mappings have been released.
+     * @param arch_reg The flattened architectural register to remap.
+     * @param phys_reg The allocated physical register to share.
+     * @return A RenameInfo pair indicating both the new and previous
+     * physical registers.
+     */
+    RenameInfo renameShared(const RegId& arch_reg, PhysRegIdPtr phys_reg);
+
     /**
      * Look up the physical register mapped to an architectural register.
      * This version takes a flattened architectural register id
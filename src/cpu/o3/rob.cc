@@ -98,6 +98,9 @@ ROB::ROB(CPU *_cpu, const BaseO3CPUParams &params)
         maxEntries[tid] = 0;
     }
 
+    for (ThreadID tid = 0; tid < numThreads; tid++)
+        instList[tid].reserve(maxEntries[tid]);
+
     resetState();
 }
 
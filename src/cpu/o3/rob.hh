@@ -45,6 +45,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/pooled_list.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -285,8 +286,8 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** ROB List of Instructions, preallocated to each thread's share. */
+    PooledList<DynInstPtr> instList[MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle.
      * A negative number means all instructions are squashed instantly
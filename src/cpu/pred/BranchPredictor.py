@@ -145,6 +145,37 @@ class SimpleBTB(BranchTargetBuffer):
     )
 
 
+class MultiLevelBTB(BranchTargetBuffer):
+    type = "MultiLevelBTB"
+    cxx_class = "gem5::branch_prediction::MultiLevelBTB"
+    cxx_header = "cpu/pred/multi_level_btb.hh"
+
+    instShiftAmt = Param.Unsigned(
+        Parent.instShiftAmt, "Number of bits to shift instructions by"
+    )
+    levels = VectorParam.BranchTargetBuffer(
+        [
+            SimpleBTB(numEntries=64, associativity=8),
+            SimpleBTB(numEntries=4096, associativity=4),
+            SimpleBTB(numEntries=16384, associativity=8),
+        ],
+        "BTB levels, fastest first",
+    )
+    levelLatencies = VectorParam.Cycles(
+        [0, 1, 4], "Number of bubble cycles for a hit in each level"
+    )
+    prefetchSource = Param.SimObject(
+        NULL,
+        "Object providing the 'InstPrefetch' probe point (e.g. the "
+        "FetchDirectedPrefetcher). Entries of prefetched blocks are moved "
+        "from the slower levels into the prefetch level.",
+    )
+    prefetchLevel = Param.Unsigned(1, "Level BTB prefetches are filled into")
+    prefetchBlockSize = Param.Unsigned(
+        64, "Size of the instruction block covered by one prefetch"
+    )
+
+
 class ConditionalPredictor(SimObject):
     type = "ConditionalPredictor"
     cxx_class = "gem5::branch_prediction::ConditionalPredictor"
@@ -233,6 +264,13 @@ class BranchPredictor(SimObject):
         "is on the false path and will be squashed later.",
     )
 
+    historyBufferSize = Param.Unsigned(
+        192,
+        "Number of branch history records preallocated per thread. It "
+        "should cover the branches in flight, so the ROB size is a good "
+        "choice. The buffer grows if it turns out to be too small.",
+    )
+
     btb = Param.BranchTargetBuffer(SimpleBTB(), "Branch target buffer (BTB)")
     ras = Param.ReturnAddrStack(
         ReturnAddrStack(), "Return address stack, set to NULL to disable RAS."
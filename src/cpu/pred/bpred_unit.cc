@@ -59,10 +59,18 @@ BPredUnit::BPredUnit(const Params &params)
     : SimObject(params), numThreads(params.numThreads),
       requiresBTBHit(params.requiresBTBHit),
       updateBTBAtSquash(params.updateBTBAtSquash),
-      instShiftAmt(params.instShiftAmt), predHist(numThreads), btb(params.btb),
+      instShiftAmt(params.instShiftAmt),
+      predHist(numThreads, HistoryRing(params.historyBufferSize)),
+      historyPools(numThreads), btb(params.btb),
       ras(params.ras), cPred(params.conditionalBranchPred),
       iPred(params.indirectBranchPred), stats(this)
 {
+    for (auto &pool : historyPools) {
+        for (unsigned i = 0; i < params.historyBufferSize; i++) {
+            pool.records.emplace_back();
+            pool.freeList.push_back(&pool.records.back());
+        }
+    }
 }
 
 
@@ -103,7 +111,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     assert(bpu_history!=nullptr);
 
     /** Push the record into the history buffer */
-    predHist[tid].push_front(bpu_history);
+    predHist[tid].push(bpu_history);
 
     DPRINTF(Branch, "[tid:%i] [sn:%llu] History entry added. "
             "predHist.size(): %i\n", tid, seqNum, predHist[tid].size());
@@ -114,7 +122,36 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
 void
 BPredUnit::insertPredictorHistory(ThreadID tid, PredictorHistory *&bpu_history)
 {
-    predHist[tid].push_front(bpu_history);
+    predHist[tid].push(bpu_history);
+}
+
+BPredUnit::PredictorHistory *
+BPredUnit::allocHistory(ThreadID tid, InstSeqNum sn, Addr pc,
+                        const StaticInstPtr &inst)
+{
+    HistoryPool &pool = historyPools[tid];
+    if (pool.freeList.empty()) {
+        pool.records.emplace_back();
+        pool.freeList.push_back(&pool.records.back());
+    }
+
+    PredictorHistory *hist = pool.freeList.back();
+    pool.freeList.pop_back();
+    hist->reset(tid, sn, pc, inst);
+    return hist;
+}
+
+void
+BPredUnit::freeHistory(PredictorHistory *&bpu_history)
+{
+    assert(bpu_history->bpHistory == nullptr);
+    assert(bpu_history->indirectHistory == nullptr);
+    assert(bpu_history->rasHistory == nullptr);
+
+    // Drop the reference so the static instruction is not kept alive.
+    bpu_history->inst = nullptr;
+    historyPools[bpu_history->tid].freeList.push_back(bpu_history);
+    bpu_history = nullptr;
 }
 
 bool
@@ -130,7 +167,7 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     // if prediction was wrong.
 
     BranchType brType = getBranchType(inst);
-    hist = new PredictorHistory(tid, seqNum, pc.instAddr(), inst);
+    hist = allocHistory(tid, seqNum, pc.instAddr(), inst);
 
     stats.lookups[tid][brType]++;
     ppBranches->notify(1);
@@ -339,14 +376,14 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
             "[sn:%llu]\n", tid, done_sn);
 
     while (!predHist[tid].empty() &&
-            predHist[tid].back()->seqNum <= done_sn) {
+            predHist[tid].oldest()->seqNum <= done_sn) {
 
-        // Iterate from the back to front. Least recent
-        // sequence number until the most recent done number
-        commitBranch(tid, *predHist[tid].rbegin());
+        // Iterate from the oldest to the youngest branch until
+        // the most recent done number
+        commitBranch(tid, predHist[tid].oldest());
 
-        delete predHist[tid].back();
-        predHist[tid].pop_back();
+        freeHistory(predHist[tid].oldest());
+        predHist[tid].popOldest();
         DPRINTF(Branch, "[tid:%i] [commit sn:%llu] pred_hist.size(): %i\n",
                 tid, done_sn, predHist[tid].size());
     }
@@ -404,9 +441,9 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
 
     while (!predHist[tid].empty() &&
-            predHist[tid].front()->seqNum > squashed_sn) {
+            predHist[tid].youngest()->seqNum > squashed_sn) {
 
-        auto hist = predHist[tid].front();
+        auto hist = predHist[tid].youngest();
 
         DPRINTF(Branch,
                 "[tid:%i, squash sn:%llu] Removing history for "
@@ -415,7 +452,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 
         squashHistory(tid, hist);
 
-        predHist[tid].pop_front();
+        predHist[tid].popYoungest();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] pred_hist.size(): %i\n",
                 tid, squashed_sn, predHist[tid].size());
@@ -452,8 +489,7 @@ BPredUnit::squashHistory(ThreadID tid, PredictorHistory* &history)
     // This call will  delete the bpHistory.
     cPred->squash(tid, history->bpHistory);
 
-    delete history;
-    history = nullptr;
+    freeHistory(history);
 }
 
 
@@ -488,7 +524,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
     // fix up the entry.
     if (!predHist[tid].empty()) {
 
-        PredictorHistory *hist = predHist[tid].front();
+        PredictorHistory *hist = predHist[tid].youngest();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] Mispredicted: %s, PC:%#x\n",
                     tid, squashed_sn, toString(hist->type), hist->pc);
@@ -626,19 +662,18 @@ void
 BPredUnit::dump()
 {
     int i = 0;
-    for (const auto& ph : predHist) {
+    for (auto& ph : predHist) {
         if (!ph.empty()) {
-            auto hist = ph.begin();
-
             cprintf("predHist[%i].size(): %i\n", i++, ph.size());
 
-            while (hist != ph.end()) {
+            // Youngest branch first.
+            for (size_t j = ph.size(); j-- > 0; ) {
+                const PredictorHistory *hist = ph[j];
                 cprintf("sn:%llu], PC:%#x, tid:%i, predTaken:%i, "
                         "bpHistory:%#x, rasHistory:%#x\n",
-                        (*hist)->seqNum, (*hist)->pc,
-                        (*hist)->tid, (*hist)->predTaken,
-                        (*hist)->bpHistory, (*hist)->rasHistory);
-                hist++;
+                        hist->seqNum, hist->pc,
+                        hist->tid, hist->predTaken,
+                        hist->bpHistory, hist->rasHistory);
             }
 
             cprintf("\n");
@@ -42,7 +42,9 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
+#include <algorithm>
 #include <deque>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "base/types.hh"
@@ -168,6 +170,19 @@ class BPredUnit : public SimObject
         return btb->getInst(tid, pc);
     }
 
+    /**
+     * Returns the number of cycles it takes the BTB to provide the entry
+     * of a given PC. Does not update statistics.
+     * @param tid The thread id.
+     * @param pc The PC to look up.
+     * @return The hit latency in cycles.
+     */
+    Cycles
+    BTBHitLatency(ThreadID tid, Addr pc)
+    {
+        return btb->hitLatency(tid, pc);
+    }
+
     /**
      * Updates the BTB with the target of a branch.
      * @param tid The thread id.
@@ -277,21 +292,38 @@ class BPredUnit : public SimObject
          */
         PredictorHistory(ThreadID _tid, InstSeqNum sn, Addr _pc,
                          const StaticInstPtr & inst)
-            : seqNum(sn), tid(_tid), pc(_pc),
-              inst(inst), type(getBranchType(inst)),
-              call(inst->isCall()), uncond(!inst->isCondCtrl()),
-              predTaken(false), actuallyTaken(false), condPred(false),
-              btbHit(false), targetProvider(TargetProvider::NoTarget),
-              resteered(false), mispredict(false), target(nullptr),
-              bpHistory(nullptr),
-              indirectHistory(nullptr), rasHistory(nullptr)
-        { }
-
-        ~PredictorHistory()
         {
-            assert(bpHistory == nullptr);
-            assert(indirectHistory == nullptr);
-            assert(rasHistory == nullptr);
+            reset(_tid, sn, _pc, inst);
+        }
+
+        /** Makes an unused history record for the history pool. */
+        PredictorHistory() = default;
+
+        /**
+         * Reinitializes a recycled record for a new branch. The target
+         * keeps its allocation as every prediction overwrites it.
+         */
+        void
+        reset(ThreadID _tid, InstSeqNum sn, Addr _pc,
+              const StaticInstPtr &_inst)
+        {
+            seqNum = sn;
+            tid = _tid;
+            pc = _pc;
+            inst = _inst;
+            type = getBranchType(_inst);
+            call = _inst->isCall();
+            uncond = !_inst->isCondCtrl();
+            predTaken = false;
+            actuallyTaken = false;
+            condPred = false;
+            btbHit = false;
+            targetProvider = TargetProvider::NoTarget;
+            resteered = false;
+            mispredict = false;
+            bpHistory = nullptr;
+            indirectHistory = nullptr;
+            rasHistory = nullptr;
         }
 
         PredictorHistory (const PredictorHistory&) = delete;
@@ -304,46 +336,46 @@ class BPredUnit : public SimObject
         }
 
         /** The sequence number for the predictor history entry. */
-        InstSeqNum seqNum;
+        InstSeqNum seqNum = 0;
 
         /** The thread id. */
-        const ThreadID tid;
+        ThreadID tid = InvalidThreadID;
 
         /** The PC associated with the sequence number. */
-        const Addr pc;
+        Addr pc = 0;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
 
         /** The type of the branch */
-        const BranchType type;
+        BranchType type = BranchType::NoBranch;
 
         /** Whether or not the instruction was a call. */
-        const bool call;
+        bool call = false;
 
         /** Was unconditional control */
-        const bool uncond;
+        bool uncond = false;
 
         /** Whether or not it was predicted taken. */
-        bool predTaken;
+        bool predTaken = false;
 
         /** To record the actual outcome of the branch */
-        bool actuallyTaken;
+        bool actuallyTaken = false;
 
         /** The prediction of the conditional predictor */
-        bool condPred;
+        bool condPred = false;
 
         /** Was BTB hit at prediction time */
-        bool btbHit;
+        bool btbHit = false;
 
         /** Which component provided the target */
-        TargetProvider targetProvider;
+        TargetProvider targetProvider = TargetProvider::NoTarget;
 
         /** Resteered */
-        bool resteered;
+        bool resteered = false;
 
         /** The branch was corrected hence was mispredicted. */
-        bool mispredict;
+        bool mispredict = false;
 
         /** The predicted target */
         std::unique_ptr<PCStateBase> target;
@@ -362,6 +394,25 @@ class BPredUnit : public SimObject
 
     };
 
+    /**
+     * Takes a history record for a new branch from the pool of the thread.
+     * The pool only grows if all of its records are in flight.
+     * @param tid The thread id.
+     * @param sn The sequence number of the branch.
+     * @param pc The PC of the branch.
+     * @param inst The branch instruction.
+     * @return The initialized history record.
+     */
+    PredictorHistory *allocHistory(ThreadID tid, InstSeqNum sn, Addr pc,
+                                   const StaticInstPtr &inst);
+
+    /**
+     * Returns a history record to the pool of its thread. All predictor
+     * state hanging off the record must have been released.
+     * @param bpu_history The record to free, set to nullptr.
+     */
+    void freeHistory(PredictorHistory *&bpu_history);
+
     /**
      * Pushes a `PredictorHistory` object into the branch predictor history
      * queue. This is used by the decoupled front-end to move predictions
@@ -421,12 +472,86 @@ class BPredUnit : public SimObject
     /** Number of bits to shift instructions by for predictor addresses. */
     const unsigned instShiftAmt;
 
+    /**
+     * Ring of the in-flight histories of a thread in program order. It is
+     * preallocated and only grows, by doubling, when more branches are in
+     * flight than it was sized for.
+     */
+    class HistoryRing
+    {
+      public:
+        explicit HistoryRing(size_t size) : slots(std::max<size_t>(size, 1))
+        {}
+
+        bool empty() const { return count == 0; }
+        size_t size() const { return count; }
+
+        /** Returns the i-th oldest history. */
+        PredictorHistory *&
+        operator[](size_t i)
+        {
+            return slots[(head + i) % slots.size()];
+        }
+
+        PredictorHistory *&oldest() { return (*this)[0]; }
+        PredictorHistory *&youngest() { return (*this)[count - 1]; }
+
+        void
+        push(PredictorHistory *hist)
+        {
+            if (count == slots.size())
+                grow();
+            (*this)[count++] = hist;
+        }
+
+        void
+        popOldest()
+        {
+            assert(count);
+            head = (head + 1) % slots.size();
+            count--;
+        }
+
+        void
+        popYoungest()
+        {
+            assert(count);
+            count--;
+        }
+
+      private:
+        void
+        grow()
+        {
+            std::vector<PredictorHistory *> grown(slots.size() * 2);
+            for (size_t i = 0; i < count; i++)
+                grown[i] = (*this)[i];
+            slots.swap(grown);
+            head = 0;
+        }
+
+        std::vector<PredictorHistory *> slots;
+        size_t head = 0;
+        size_t count = 0;
+    };
+
     /**
      * The per-thread predictor history. This is used to update the predictor
      * as instructions are committed, or restore it to the proper state after
      * a squash.
      */
-    std::vector<std::deque<PredictorHistory *>> predHist;
+    std::vector<HistoryRing> predHist;
+
+    /**
+     * Per-thread pool of history records. The records never move, so the
+     * rings and the FTQ can hold plain pointers to them.
+     */
+    struct HistoryPool
+    {
+        std::deque<PredictorHistory> records;
+        std::vector<PredictorHistory *> freeList;
+    };
+    std::vector<HistoryPool> historyPools;
 
     /** The BTB. */
     BranchTargetBuffer * btb;
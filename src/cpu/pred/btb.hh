@@ -88,6 +88,16 @@ class BranchTargetBuffer : public ClockedObject
      */
     virtual const StaticInstPtr getInst(ThreadID tid, Addr instPC) = 0;
 
+    /** Returns the number of cycles the BTB needs to provide the entry
+     * of a branch. A single level BTB provides all entries without
+     * bubbles. Does not update statistics.
+     *  @param inst_PC The address of the branch to look up.
+     *  @return The hit latency in cycles.
+     */
+    virtual Cycles hitLatency(ThreadID tid, Addr instPC)
+    {
+        return Cycles(0);
+    }
 
     /** Updates the BTB with the target of a branch.
      *  @param inst_pc The address of the branch being updated.
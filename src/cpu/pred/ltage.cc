@@ -72,21 +72,18 @@ LTAGE::init()
     TAGE::init();
 }
 
-void
-LTAGE::branchPlaceholder(ThreadID tid, Addr pc,
-                         bool uncond, void * &bpHistory)
+TAGE::TageBranchInfo *
+LTAGE::makeTageBranchInfo(Addr pc, bool conditional)
 {
-    LTageBranchInfo *bi = new LTageBranchInfo(*tage, *loopPredictor,
-                                              pc, !uncond);
-    bpHistory = (void*)(bi);
+    return new LTageBranchInfo(*tage, *loopPredictor, pc, conditional);
 }
 
 //prediction
 bool
 LTAGE::predict(ThreadID tid, Addr branch_pc, bool cond_branch, void* &b)
 {
-    LTageBranchInfo *bi = new LTageBranchInfo(*tage, *loopPredictor,
-                                              branch_pc, cond_branch);
+    LTageBranchInfo *bi = static_cast<LTageBranchInfo*>(
+        allocBranchInfo(branch_pc, cond_branch));
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, branch_pc, cond_branch,
@@ -153,8 +150,7 @@ LTAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
     tage->updateHistories(tid, pc, false, taken, target,
                            inst, bi->tageBranchInfo);
 
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 void
@@ -85,8 +85,6 @@ class LTAGE : public TAGE
     void update(ThreadID tid, Addr pc, bool taken,
                 void * &bp_history, bool squashed,
                 const StaticInstPtr & inst, Addr target) override;
-    void branchPlaceholder(ThreadID tid, Addr pc,
-                           bool uncond, void * &bp_history) override;
     void init() override;
 
   protected:
@@ -115,8 +113,17 @@ class LTAGE : public TAGE
             delete lpBranchInfo;
             lpBranchInfo = nullptr;
         }
+
+        void
+        reset(Addr pc, bool conditional) override
+        {
+            TageBranchInfo::reset(pc, conditional);
+            *lpBranchInfo = LoopPredictor::BranchInfo();
+        }
     };
 
+    TageBranchInfo *makeTageBranchInfo(Addr pc, bool conditional) override;
+
     /**
      * Get a branch prediction from LTAGE. *NOT* an override of
      * BpredUnit::predict().
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/pred/multi_level_btb.hh"
+
+#include <memory>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/BTB.hh"
+
+namespace gem5::branch_prediction
+{
+
+MultiLevelBTB::MultiLevelBTB(const MultiLevelBTBParams &p)
+    : BranchTargetBuffer(p),
+      levels(p.levels),
+      latencies(p.levelLatencies),
+      prefetchSource(p.prefetchSource),
+      prefetchLevel(p.prefetchLevel),
+      prefetchBlockSize(p.prefetchBlockSize),
+      instShiftAmt(p.instShiftAmt),
+      mlStats(this, p.levels.size())
+{
+    fatal_if(levels.empty(), "MultiLevelBTB requires at least one level");
+    fatal_if(levels.size() != latencies.size(),
+             "MultiLevelBTB: %i levels but %i latencies", levels.size(),
+             latencies.size());
+    fatal_if(prefetchSource && prefetchLevel >= levels.size() - 1,
+             "MultiLevelBTB: prefetch level must have a slower level");
+    fatal_if(!isPowerOf2(prefetchBlockSize),
+             "MultiLevelBTB: prefetch block size is not a power of 2");
+
+    DPRINTF(BTB, "BTB: Creating multi level BTB with %i levels.\n",
+            levels.size());
+}
+
+void
+MultiLevelBTB::regProbeListeners()
+{
+    BranchTargetBuffer::regProbeListeners();
+
+    if (prefetchSource == nullptr) {
+        return;
+    }
+    listeners.push_back(
+        prefetchSource->getProbeManager()->connect<ProbeListenerArgFunc<Addr>>(
+            "InstPrefetch",
+            [this](const Addr &addr) { prefetchBlock(addr); }));
+}
+
+void
+MultiLevelBTB::memInvalidate()
+{
+    for (auto level : levels) {
+        level->memInvalidate();
+    }
+}
+
+unsigned
+MultiLevelBTB::findLevel(ThreadID tid, Addr instPC) const
+{
+    unsigned l = 0;
+    while (l < levels.size() && !levels[l]->valid(tid, instPC)) {
+        l++;
+    }
+    return l;
+}
+
+void
+MultiLevelBTB::fill(ThreadID tid, Addr instPC, unsigned first, unsigned from)
+{
+    // Copy the target as updating a level may evict the source entry.
+    std::unique_ptr<PCStateBase> target(
+        levels[from]->lookup(tid, instPC)->clone());
+    StaticInstPtr inst = levels[from]->getInst(tid, instPC);
+    BranchType type = inst ? getBranchType(inst) : BranchType::NoBranch;
+
+    for (unsigned l = first; l < from; l++) {
+        levels[l]->update(tid, instPC, *target, type, inst);
+    }
+}
+
+bool
+MultiLevelBTB::valid(ThreadID tid, Addr instPC)
+{
+    return findLevel(tid, instPC) < levels.size();
+}
+
+const PCStateBase *
+MultiLevelBTB::lookup(ThreadID tid, Addr instPC, BranchType type)
+{
+    stats.lookups[type]++;
+
+    unsigned l = findLevel(tid, instPC);
+    if (l == levels.size()) {
+        stats.misses[type]++;
+        return nullptr;
+    }
+
+    mlStats.hits[l]++;
+    if (l > 0) {
+        DPRINTF(BTB, "BTB: PC %#x hit in level %i, promote.\n", instPC, l);
+        fill(tid, instPC, 0, l);
+    }
+    return levels[0]->lookup(tid, instPC, type);
+}
+
+const StaticInstPtr
+MultiLevelBTB::getInst(ThreadID tid, Addr instPC)
+{
+    unsigned l = findLevel(tid, instPC);
+    return l < levels.size() ? levels[l]->getInst(tid, instPC) : nullptr;
+}
+
+Cycles
+MultiLevelBTB::hitLatency(ThreadID tid, Addr instPC)
+{
+    unsigned l = findLevel(tid, instPC);
+    return l < levels.size() ? latencies[l] : Cycles(0);
+}
+
+void
+MultiLevelBTB::update(ThreadID tid, Addr instPC, const PCStateBase &target,
+                      BranchType type, StaticInstPtr inst)
+{
+    stats.updates[type]++;
+
+    for (auto level : levels) {
+        level->update(tid, instPC, target, type, inst);
+    }
+}
+
+void
+MultiLevelBTB::prefetchBlock(const Addr &addr)
+{
+    mlStats.prefetchProbes++;
+
+    const Addr blk_addr = addr & ~Addr(prefetchBlockSize - 1);
+    const Addr step = Addr(1) << instShiftAmt;
+
+    for (Addr pc = blk_addr; pc < blk_addr + prefetchBlockSize; pc += step) {
+        for (ThreadID tid = 0; tid < numThreads; tid++) {
+            unsigned l = findLevel(tid, pc);
+            if (l <= prefetchLevel || l == levels.size()) {
+                continue;
+            }
+            DPRINTF(BTB, "BTB: Prefetch PC %#x from level %i into %i.\n",
+                    pc, l, prefetchLevel);
+            fill(tid, pc, prefetchLevel, l);
+            mlStats.prefetched[prefetchLevel]++;
+        }
+    }
+}
+
+MultiLevelBTB::MultiLevelBTBStats::MultiLevelBTBStats(
+        statistics::Group *parent, unsigned num_levels)
+    : statistics::Group(parent, "multiLevel"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of BTB hits provided by each level"),
+      ADD_STAT(prefetchProbes, statistics::units::Count::get(),
+               "Number of instruction blocks probed for BTB prefetches"),
+      ADD_STAT(prefetched, statistics::units::Count::get(),
+               "Number of entries prefetched into each level")
+{
+    using namespace statistics;
+    hits.init(num_levels).flags(total | pdf);
+    prefetched.init(num_levels).flags(nozero);
+
+    for (unsigned l = 0; l < num_levels; l++) {
+        hits.subname(l, csprintf("L%i", l));
+        prefetched.subname(l, csprintf("L%i", l));
+    }
+}
+
+} // namespace gem5::branch_prediction
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_PRED_MULTI_LEVEL_BTB_HH__
+#define __CPU_PRED_MULTI_LEVEL_BTB_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/pred/btb.hh"
+#include "params/MultiLevelBTB.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5::branch_prediction
+{
+
+/**
+ * A hierarchy of BTBs where each level trades capacity for latency.
+ * Lookups search the levels fastest first. An entry found in a slower
+ * level is moved into all faster levels and the BAC stage stalls for the
+ * latency of the providing level (see hitLatency()). Updates are installed
+ * in every level so the hierarchy is inclusive.
+ *
+ * Optionally the BTB listens to the instruction prefetches issued by the
+ * fetch directed prefetcher. For every prefetched block the entries held
+ * only by levels slower than the prefetch level are copied into it, hiding
+ * the latency of the slow levels for branches ahead of fetch.
+ */
+class MultiLevelBTB : public BranchTargetBuffer
+{
+  public:
+    MultiLevelBTB(const MultiLevelBTBParams &params);
+
+    void memInvalidate() override;
+    bool valid(ThreadID tid, Addr instPC) override;
+    const PCStateBase *lookup(ThreadID tid, Addr instPC,
+                              BranchType type = BranchType::NoBranch) override;
+    void update(ThreadID tid, Addr instPC, const PCStateBase &target_pc,
+                BranchType type = BranchType::NoBranch,
+                StaticInstPtr inst = nullptr) override;
+    const StaticInstPtr getInst(ThreadID tid, Addr instPC) override;
+    Cycles hitLatency(ThreadID tid, Addr instPC) override;
+
+    void regProbeListeners() override;
+
+  private:
+    /** Returns the fastest level holding the branch or the number of
+     * levels if no level holds it. Does not touch replacement state. */
+    unsigned findLevel(ThreadID tid, Addr instPC) const;
+
+    /** Copies the entry of a branch from level `from` into all levels
+     * in [first, from). */
+    void fill(ThreadID tid, Addr instPC, unsigned first, unsigned from);
+
+    /** Called for every instruction prefetch of the prefetch source. */
+    void prefetchBlock(const Addr &addr);
+
+    /** The BTB levels, fastest first. */
+    std::vector<BranchTargetBuffer *> levels;
+
+    /** The hit latency of each level. */
+    std::vector<Cycles> latencies;
+
+    /** Object providing the instruction prefetch probe. */
+    SimObject *prefetchSource;
+
+    /** The level prefetched entries are copied into. */
+    const unsigned prefetchLevel;
+
+    /** The size of a prefetched instruction block. */
+    const unsigned prefetchBlockSize;
+
+    /** Number of bits to shift the PC by to step over instructions. */
+    const unsigned instShiftAmt;
+
+    /** Listener for the instruction prefetch probe. */
+    std::vector<ProbeListenerPtr<>> listeners;
+
+    struct MultiLevelBTBStats : public statistics::Group
+    {
+        MultiLevelBTBStats(statistics::Group *parent, unsigned num_levels);
+
+        /** Number of lookups provided by each level. */
+        statistics::Vector hits;
+        /** Number of blocks probed on behalf of the prefetcher. */
+        statistics::Scalar prefetchProbes;
+        /** Number of entries prefetched into each level. */
+        statistics::Vector prefetched;
+    } mlStats;
+};
+
+} // namespace gem5::branch_prediction
+
+#endif // __CPU_PRED_MULTI_LEVEL_BTB_HH__
@@ -68,6 +68,37 @@ TAGE::TAGE(const TAGEParams &params)
 {
 }
 
+TAGE::~TAGE()
+{
+    for (auto bi : freeBranchInfos)
+        delete bi;
+}
+
+TAGE::TageBranchInfo *
+TAGE::makeTageBranchInfo(Addr pc, bool conditional)
+{
+    return new TageBranchInfo(*tage, pc, conditional);
+}
+
+TAGE::TageBranchInfo *
+TAGE::allocBranchInfo(Addr pc, bool conditional)
+{
+    if (freeBranchInfos.empty())
+        return makeTageBranchInfo(pc, conditional);
+
+    TageBranchInfo *bi = freeBranchInfos.back();
+    freeBranchInfos.pop_back();
+    bi->reset(pc, conditional);
+    return bi;
+}
+
+void
+TAGE::freeBranchInfo(void * &bp_history)
+{
+    freeBranchInfos.push_back(static_cast<TageBranchInfo*>(bp_history));
+    bp_history = nullptr;
+}
+
 // PREDICTOR UPDATE
 void
 TAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
@@ -96,8 +127,7 @@ TAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
 
     // optional non speculative update of the histories
     tage->updateHistories(tid, pc, false, taken, target, inst, tage_bi);
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 void
@@ -105,15 +135,14 @@ TAGE::squash(ThreadID tid, void * &bp_history)
 {
     TageBranchInfo *bi = static_cast<TageBranchInfo*>(bp_history);
     tage->restoreHistState(tid, bi->tageBranchInfo);
-    DPRINTF(Tage, "Deleting branch info: %lx\n", bi->tageBranchInfo->branchPC);
-    delete bi;
-    bp_history = nullptr;
+    DPRINTF(Tage, "Freeing branch info: %lx\n", bi->tageBranchInfo->branchPC);
+    freeBranchInfo(bp_history);
 }
 
 bool
 TAGE::predict(ThreadID tid, Addr pc, bool cond_branch, void* &b)
 {
-    TageBranchInfo *bi = new TageBranchInfo(*tage, pc, cond_branch);
+    TageBranchInfo *bi = allocBranchInfo(pc, cond_branch);
     b = (void*)(bi);
     return tage->tagePredict(tid, pc, cond_branch, bi->tageBranchInfo);
 }
@@ -150,8 +179,7 @@ TAGE::updateHistories(ThreadID tid, Addr pc, bool uncond, bool taken,
 void
 TAGE::branchPlaceholder(ThreadID tid, Addr pc, bool uncond, void * &bpHistory)
 {
-    TageBranchInfo *bi = new TageBranchInfo(*tage, pc, !uncond);
-    bpHistory = (void*)(bi);
+    bpHistory = (void*)(allocBranchInfo(pc, !uncond));
 }
 
 } // namespace branch_prediction
@@ -93,14 +93,37 @@ class TAGE: public ConditionalPredictor
         {
             delete tageBranchInfo;
         }
+
+        /** Reinitializes a recycled branch info for a new branch. */
+        virtual void
+        reset(Addr pc, bool conditional)
+        {
+            tageBranchInfo->reset(pc, conditional);
+        }
     };
 
+    /**
+     * Branch infos of finished branches, kept for reuse so that a warmed
+     * up predictor does not allocate on predict, squash or commit.
+     */
+    std::vector<TageBranchInfo *> freeBranchInfos;
+
+    /** Makes a new branch info of the type used by this predictor. */
+    virtual TageBranchInfo *makeTageBranchInfo(Addr pc, bool conditional);
+
+    /** Takes a branch info from the free list, or makes a new one. */
+    TageBranchInfo *allocBranchInfo(Addr pc, bool conditional);
+
+    /** Returns a branch info to the free list and clears the pointer. */
+    void freeBranchInfo(void * &bp_history);
+
     virtual bool predict(ThreadID tid, Addr branch_pc, bool cond_branch,
                          void* &b);
 
   public:
 
     TAGE(const TAGEParams &params);
+    ~TAGE();
 
     // Base class methods.
     bool lookup(ThreadID tid, Addr pc, void* &bp_history) override;
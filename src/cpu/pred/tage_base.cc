@@ -38,6 +38,8 @@
 
 #include "cpu/pred/tage_base.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/Fetch.hh"
@@ -126,10 +128,16 @@ TAGEBase::init()
     // implementation
     assert(tagTableTagWidths[0] == 0);
 
+    fatal_if(nHistoryTables > tage_kernels::MaxTables,
+             "TAGE supports at most %d tagged tables",
+             tage_kernels::MaxTables);
+
     for (auto& history : threadHistory) {
-        history.computeIndices = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[0] = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[1] = new FoldedHistory[nHistoryTables+1];
+        history.folded.resize(3 * (nHistoryTables + 1));
+        history.computeIndices = history.folded.view(0);
+        history.computeTags[0] = history.folded.view(nHistoryTables + 1);
+        history.computeTags[1] =
+            history.folded.view(2 * (nHistoryTables + 1));
 
         initFoldedHistories(history);
     }
@@ -139,11 +147,20 @@ TAGEBase::init()
     btableHysteresis.resize(bimodalTableSize >> logRatioBiModalHystEntries,
                             true);
 
-    gtable = new TageEntry*[nHistoryTables + 1];
+    gtable = new TageTable[nHistoryTables + 1];
     buildTageTables();
 
     tableIndices = new int [nHistoryTables+1];
     tableTags = new int [nHistoryTables+1];
+
+    tableGeometry.init(nHistoryTables, logTagTableSizes, tagTableTagWidths,
+                       histLengths, pathHistBits);
+    activeTables = 0;
+    tagArrays.assign(nHistoryTables + 1, nullptr);
+    for (int i = 1; i <= nHistoryTables; i++) {
+        activeTables |= uint64_t(noSkip[i]) << i;
+        tagArrays[i] = gtable[i].tag;
+    }
     initialized = true;
 }
 
@@ -166,7 +183,7 @@ void
 TAGEBase::buildTageTables()
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        gtable[i].allocate(1<<(logTagTableSizes[i]));
     }
 }
 
@@ -336,13 +353,8 @@ TAGEBase::updateGHist(ThreadID tid, uint64_t bv, uint8_t n)
         bv >>= 1;
 
         // Update the folded histories with the new bit.
-        uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
-
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(gh_ptr);
-            tHist.computeTags[0][i].update(gh_ptr);
-            tHist.computeTags[1][i].update(gh_ptr);
-        }
+        const uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
+        tage_kernels::foldIn(tHist.folded, gh_ptr);
     }
 }
 
@@ -350,13 +362,18 @@ void
 TAGEBase::calculateIndicesAndTags(ThreadID tid, Addr branch_pc,
                                   BranchInfo* bi)
 {
-    // computes the table addresses and the partial tags
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tableIndices[i] = gindex(tid, branch_pc, i);
-        bi->tableIndices[i] = tableIndices[i];
-        tableTags[i] = gtag(tid, branch_pc, i);
-        bi->tableTags[i] = tableTags[i];
-    }
+    // computes the table addresses and the partial tags of all tables
+    // in one pass
+    const ThreadHistory &tHist = threadHistory[tid];
+    tage_kernels::computeIndicesAndTags(
+        tableGeometry, branch_pc >> instShiftAmt, tHist.pathHist,
+        tHist.computeIndices.comps(), tHist.computeTags[0].comps(),
+        tHist.computeTags[1].comps(), bi->tableIndices, bi->tableTags);
+
+    std::copy(bi->tableIndices + 1, bi->tableIndices + nHistoryTables + 1,
+              tableIndices + 1);
+    std::copy(bi->tableTags + 1, bi->tableTags + nHistoryTables + 1,
+              tableTags + 1);
     bi->valid = true;
 }
 
@@ -384,23 +401,20 @@ TAGEBase::tagePredict(ThreadID tid, Addr branch_pc,
 
     bi->hitBank = 0;
     bi->altBank = 0;
-    //Look for the bank with longest matching history
-    for (int i = nHistoryTables; i > 0; i--) {
-        if (noSkip[i] &&
-            gtable[i][tableIndices[i]].tag == tableTags[i]) {
-            bi->hitBank = i;
-            bi->hitBankIndex = tableIndices[bi->hitBank];
-            break;
-        }
-    }
-    //Look for the alternate bank
-    for (int i = bi->hitBank - 1; i > 0; i--) {
-        if (noSkip[i] &&
-            gtable[i][tableIndices[i]].tag == tableTags[i]) {
-            bi->altBank = i;
-            bi->altBankIndex = tableIndices[bi->altBank];
-            break;
-        }
+    //Compare the tags of all banks at once
+    uint64_t hits = tage_kernels::matchTags(nHistoryTables, tagArrays.data(),
+                                            tableIndices, tableTags);
+    hits &= activeTables;
+    //The bank with longest matching history provides the prediction,
+    //the next matching one the alternate prediction
+    if (hits) {
+        bi->hitBank = floorLog2(hits);
+        bi->hitBankIndex = tableIndices[bi->hitBank];
+        hits &= ~(1ULL << bi->hitBank);
+    }
+    if (hits) {
+        bi->altBank = floorLog2(hits);
+        bi->altBankIndex = tableIndices[bi->altBank];
     }
     //computes the prediction and the alternate prediction
     if (bi->hitBank > 0) {
@@ -689,11 +703,8 @@ TAGEBase::recordHistState(ThreadID tid, BranchInfo* bi)
     ThreadHistory &tHist = threadHistory[tid];
     bi->pathHist = tHist.pathHist;
 
-    for (int i = 1; i <= nHistoryTables; i++) {
-        bi->ci[i]  = tHist.computeIndices[i].comp;
-        bi->ct0[i] = tHist.computeTags[0][i].comp;
-        bi->ct1[i] = tHist.computeTags[1][i].comp;
-    }
+    // ci, ct0 and ct1 are laid out like the folded histories
+    std::copy(tHist.folded.comp.begin(), tHist.folded.comp.end(), bi->ci);
 }
 
 void
@@ -716,14 +727,10 @@ TAGEBase::restoreHistState(ThreadID tid, BranchInfo* bi)
     // Shift out the inserted bits from the folded history
     // and the global history vector
     for (int n = 0; n < bi->nGhist; n++) {
-        uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
+        const uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
 
         // First revert the folded history
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].restore(gh_ptr);
-            tHist.computeTags[0][i].restore(gh_ptr);
-            tHist.computeTags[1][i].restore(gh_ptr);
-        }
+        tage_kernels::foldOut(tHist.folded, gh_ptr);
         tHist.ptGhist++;
         // Make sure we do not go out of bounds.
         // If we do its likely that there where too many branches in flight
@@ -53,6 +53,7 @@
 
 #include "base/statistics.hh"
 #include "cpu/null_static_inst.hh"
+#include "cpu/pred/tage_kernels.hh"
 #include "cpu/static_inst.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
@@ -72,54 +73,43 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
-    struct TageEntry
+    // Partially tagged table in structure-of-arrays form, so the tags
+    // of a table are contiguous for the tag compare. Copies share the
+    // storage, which TAGE-SC-L uses to map several banks to one table.
+    struct TageTable
     {
-        int8_t ctr;
-        uint16_t tag;
-        uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
-    };
-
-    // Folded History Table - compressed history
-    // to mix with instruction PC to index partially
-    // tagged tables.
-    struct FoldedHistory
-    {
-        unsigned comp;
-        int compLength;
-        int origLength;
-        int outpoint;
-        int bufferSize;
-
-        FoldedHistory()
-        {
-            comp = 0;
-        }
+        int8_t *ctr = nullptr;
+        uint16_t *tag = nullptr;
+        uint8_t *u = nullptr;
 
-        void init(int original_length, int compressed_length)
+        // Tage Entry
+        struct TageEntry
         {
-            origLength = original_length;
-            compLength = compressed_length;
-            outpoint = original_length % compressed_length;
-        }
+            int8_t &ctr;
+            uint16_t &tag;
+            uint8_t &u;
+        };
 
-        void update(uint8_t * h)
+        void
+        allocate(size_t size)
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
-            comp ^= (comp >> compLength);
-            comp &= (1ULL << compLength) - 1;
+            ctr = new int8_t[size]();
+            tag = new uint16_t[size]();
+            u = new uint8_t[size]();
         }
 
-        void restore(uint8_t * h)
+        TageEntry
+        operator[](size_t index) const
         {
-            comp ^= h[origLength] << outpoint;
-            auto tmp = (comp & 1) ^ h[0];
-            comp = (tmp << (compLength-1)) | (comp >> 1);
+            return TageEntry{ctr[index], tag[index], u[index]};
         }
     };
 
+    // Folded History Table - compressed history
+    // to mix with instruction PC to index partially
+    // tagged tables.
+    using FoldedHistories = tage_kernels::FoldedHistories;
+
   public:
 
     // provider type
@@ -135,8 +125,8 @@ class TAGEBase : public SimObject
     // Primary branch history entry
     struct BranchInfo
     {
-        const Addr branchPC;
-        const bool condBranch;
+        Addr branchPC;
+        bool condBranch;
 
         int pathHist;
         int hitBank;
@@ -203,6 +193,31 @@ class TAGEBase : public SimObject
         {
             delete[] storage;
         }
+
+        /**
+         * Reinitializes a recycled branch info for a new branch. The
+         * index and tag storage is kept.
+         */
+        virtual void
+        reset(Addr pc, bool conditional)
+        {
+            branchPC = pc;
+            condBranch = conditional;
+            hitBank = 0;
+            hitBankIndex = 0;
+            altBank = 0;
+            altBankIndex = 0;
+            bimodalIndex = 0;
+            tagePred = false;
+            altTaken = false;
+            longestMatchPred = false;
+            pseudoNewAlloc = false;
+            provider = -1;
+            ghist = 0;
+            nGhist = 0;
+            modified = false;
+            valid = false;
+        }
     };
 
     virtual BranchInfo *makeBranchInfo(Addr pc, bool conditional);
@@ -217,7 +232,10 @@ class TAGEBase : public SimObject
 
     /**
      * Computes the index used to access a
-     * partially tagged table.
+     * partially tagged table. The base calculateIndicesAndTags()
+     * computes the same function for all tables at once in
+     * tage_kernels::computeIndicesAndTags(). Derived classes overriding
+     * gindex(), F() or gtag() must also override calculateIndicesAndTags().
      * @param tid The thread ID used to select the
      * global histories to use.
      * @param pc The unshifted branch PC.
@@ -495,7 +513,7 @@ class TAGEBase : public SimObject
 
     std::vector<bool> btablePrediction;
     std::vector<bool> btableHysteresis;
-    TageEntry **gtable;
+    TageTable *gtable;
 
     // Keep per-thread histories to
     // support SMT.
@@ -514,9 +532,12 @@ class TAGEBase : public SimObject
         // Index to most recent branch outcome
         int ptGhist;
 
-        // Speculative folded histories.
-        FoldedHistory *computeIndices;
-        FoldedHistory *computeTags[2];
+        // Speculative folded histories of all tables
+        FoldedHistories folded;
+        // Bank indexed views of the folded histories used for the
+        // indices and the two parts of the tags.
+        FoldedHistories::View computeIndices;
+        FoldedHistories::View computeTags[2];
     };
 
     std::vector<ThreadHistory> threadHistory;
@@ -530,6 +551,13 @@ class TAGEBase : public SimObject
     int *tableIndices;
     int *tableTags;
 
+    /** Per table parameters in SoA form for the batched kernels. */
+    tage_kernels::TableGeometry tableGeometry;
+    /** Bit mask of the tables enabled in noSkip. */
+    uint64_t activeTables;
+    /** The tag array of each table, bank indexed. */
+    std::vector<const uint16_t *> tagArrays;
+
     std::vector<int8_t> useAltPredForNewlyAllocated;
     int64_t tCounter;
     uint64_t logUResetPeriod;
@@ -0,0 +1,878 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Runs TAGEBase and a copy of the per table implementation it had before
+ * the batched kernels side by side on the same branch stream, including
+ * speculative history updates, mispredictions and squashes, and checks
+ * that every prediction and the final predictor state are bit-exact.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/tage_base.hh"
+#include "params/TAGEBase.hh"
+#include "sim/root.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace gem5
+{
+// The statistics framework resolves names through the root object,
+// which is not part of this test.
+Root *Root::_root = nullptr;
+} // namespace gem5
+
+namespace
+{
+
+const ThreadID tid = 0;
+// The base TAGE does not look at the instruction.
+const StaticInstPtr noInst;
+
+/** TAGEBase with the state compared by the test made accessible. */
+class TestTAGE : public TAGEBase
+{
+  public:
+    using TAGEBase::TAGEBase;
+    using TAGEBase::btableHysteresis;
+    using TAGEBase::btablePrediction;
+    using TAGEBase::gtable;
+    using TAGEBase::tCounter;
+    using TAGEBase::threadHistory;
+    using TAGEBase::useAltPredForNewlyAllocated;
+};
+
+/**
+ * Copy of TAGEBase as it was before the batched kernels: array of
+ * structures tables, one FoldedHistory object per table and history,
+ * and tables searched one at a time.
+ */
+class ReferenceTage
+{
+  public:
+    struct TageEntry
+    {
+        int8_t ctr = 0;
+        uint16_t tag = 0;
+        uint8_t u = 0;
+    };
+
+    struct FoldedHistory
+    {
+        unsigned comp = 0;
+        int compLength;
+        int origLength;
+        int outpoint;
+
+        void
+        init(int original_length, int compressed_length)
+        {
+            origLength = original_length;
+            compLength = compressed_length;
+            outpoint = original_length % compressed_length;
+        }
+
+        void
+        update(uint8_t *h)
+        {
+            comp = (comp << 1) | h[0];
+            comp ^= h[origLength] << outpoint;
+            comp ^= (comp >> compLength);
+            comp &= (1ULL << compLength) - 1;
+        }
+
+        void
+        restore(uint8_t *h)
+        {
+            comp ^= h[origLength] << outpoint;
+            auto tmp = (comp & 1) ^ h[0];
+            comp = (tmp << (compLength-1)) | (comp >> 1);
+        }
+    };
+
+    struct BranchInfo
+    {
+        Addr branchPC;
+        bool condBranch;
+        int pathHist = 0;
+        int hitBank = 0;
+        int hitBankIndex = 0;
+        int altBank = 0;
+        int altBankIndex = 0;
+        int bimodalIndex = 0;
+        bool tagePred = false;
+        bool altTaken = false;
+        bool longestMatchPred = false;
+        bool pseudoNewAlloc = false;
+        std::vector<int> tableIndices;
+        std::vector<int> tableTags;
+        std::vector<unsigned> ci, ct0, ct1;
+        unsigned provider = -1;
+        uint64_t ghist = 0;
+        uint8_t nGhist = 0;
+        bool modified = false;
+        bool valid = false;
+
+        BranchInfo(int n, Addr pc, bool conditional)
+            : branchPC(pc), condBranch(conditional),
+              tableIndices(n + 1), tableTags(n + 1),
+              ci(n + 1), ct0(n + 1), ct1(n + 1)
+        {}
+    };
+
+    explicit ReferenceTage(const TAGEBaseParams &p)
+        : logRatioBiModalHystEntries(p.logRatioBiModalHystEntries),
+          nHistoryTables(p.nHistoryTables),
+          tagTableCounterBits(p.tagTableCounterBits),
+          tagTableUBits(p.tagTableUBits),
+          histBufferSize(p.histBufferSize),
+          minHist(p.minHist), maxHist(p.maxHist),
+          pathHistBits(p.pathHistBits),
+          tagTableTagWidths(p.tagTableTagWidths),
+          logTagTableSizes(p.logTagTableSizes),
+          logUResetPeriod(p.logUResetPeriod),
+          useAltOnNaBits(p.useAltOnNaBits),
+          maxNumAlloc(p.maxNumAlloc),
+          takenOnlyHistory(p.takenOnlyHistory),
+          noSkip(p.noSkip),
+          instShiftAmt(p.instShiftAmt)
+    {
+        if (noSkip.empty())
+            noSkip.resize(nHistoryTables + 1, true);
+
+        tCounter = p.initialTCounterValue;
+        useAltPredForNewlyAllocated.resize(p.numUseAltOnNa, 0);
+        globalHist.resize(histBufferSize, 0);
+
+        histLengths.resize(nHistoryTables + 1);
+        histLengths[1] = minHist;
+        histLengths[nHistoryTables] = maxHist;
+        for (int i = 2; i <= nHistoryTables; i++) {
+            histLengths[i] = (int) (((double) minHist *
+                           pow ((double) (maxHist) / (double) minHist,
+                               (double) (i - 1) /
+                               (double) ((nHistoryTables- 1))))
+                           + 0.5);
+        }
+
+        computeIndices.resize(nHistoryTables + 1);
+        computeTags0.resize(nHistoryTables + 1);
+        computeTags1.resize(nHistoryTables + 1);
+        for (int i = 1; i <= nHistoryTables; i++) {
+            computeIndices[i].init(histLengths[i], logTagTableSizes[i]);
+            computeTags0[i].init(computeIndices[i].origLength,
+                                 tagTableTagWidths[i]);
+            computeTags1[i].init(computeIndices[i].origLength,
+                                 tagTableTagWidths[i] - 1);
+        }
+
+        const uint64_t bimodalTableSize = 1ULL << logTagTableSizes[0];
+        btablePrediction.resize(bimodalTableSize, false);
+        btableHysteresis.resize(
+            bimodalTableSize >> logRatioBiModalHystEntries, true);
+
+        gtable.resize(nHistoryTables + 1);
+        for (int i = 1; i <= nHistoryTables; i++)
+            gtable[i].resize(1 << logTagTableSizes[i]);
+        tableIndices.resize(nHistoryTables + 1);
+        tableTags.resize(nHistoryTables + 1);
+    }
+
+    int
+    bindex(Addr pc_in) const
+    {
+        return ((pc_in >> instShiftAmt) &
+                ((1ULL << (logTagTableSizes[0])) - 1));
+    }
+
+    int
+    F(int A, int size, int bank) const
+    {
+        int A1, A2;
+
+        A = A & ((1ULL << size) - 1);
+        A1 = (A & ((1ULL << logTagTableSizes[bank]) - 1));
+        A2 = (A >> logTagTableSizes[bank]);
+        A2 = ((A2 << bank) & ((1ULL << logTagTableSizes[bank]) - 1))
+           + (A2 >> (logTagTableSizes[bank] - bank));
+        A = A1 ^ A2;
+        A = ((A << bank) & ((1ULL << logTagTableSizes[bank]) - 1))
+          + (A >> (logTagTableSizes[bank] - bank));
+        return (A);
+    }
+
+    int
+    gindex(Addr pc, int bank) const
+    {
+        int index;
+        int hlen = (histLengths[bank] > pathHistBits) ? pathHistBits :
+                                                        histLengths[bank];
+        const unsigned int shiftedPc = pc >> instShiftAmt;
+        index =
+            shiftedPc ^
+            (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
+            computeIndices[bank].comp ^
+            F(pathHist, hlen, bank);
+
+        return (index & ((1ULL << (logTagTableSizes[bank])) - 1));
+    }
+
+    uint16_t
+    gtag(Addr pc, int bank) const
+    {
+        int tag = (pc >> instShiftAmt) ^
+                  computeTags0[bank].comp ^
+                  (computeTags1[bank].comp << 1);
+
+        return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
+    }
+
+    template<typename T>
+    static void
+    ctrUpdate(T &ctr, bool taken, int nbits)
+    {
+        if (taken) {
+            if (ctr < ((1 << (nbits - 1)) - 1))
+                ctr++;
+        } else {
+            if (ctr > -(1 << (nbits - 1)))
+                ctr--;
+        }
+    }
+
+    static void
+    unsignedCtrUpdate(uint8_t &ctr, bool up, unsigned nbits)
+    {
+        if (up) {
+            if (ctr < ((1 << nbits) - 1))
+                ctr++;
+        } else {
+            if (ctr)
+                ctr--;
+        }
+    }
+
+    void
+    baseUpdate(bool taken, BranchInfo *bi)
+    {
+        int inter = (btablePrediction[bi->bimodalIndex] << 1)
+            + btableHysteresis[bi->bimodalIndex >> logRatioBiModalHystEntries];
+        if (taken) {
+            if (inter < 3)
+                inter++;
+        } else if (inter > 0) {
+            inter--;
+        }
+        btablePrediction[bi->bimodalIndex] = inter >> 1;
+        btableHysteresis[bi->bimodalIndex >> logRatioBiModalHystEntries] =
+            inter & 1;
+    }
+
+    void
+    updateGHist(uint64_t bv, uint8_t n)
+    {
+        if (n == 0) return;
+
+        if (ptGhist < n) {
+            const int rollbackBuffer = 1000;
+            for (int i = 0; i < (maxHist + rollbackBuffer); i++) {
+                globalHist[histBufferSize - maxHist - rollbackBuffer + i] =
+                    globalHist[ptGhist + i];
+            }
+            ptGhist = histBufferSize - maxHist - rollbackBuffer;
+        }
+
+        for (int i = 0; i < n; i++) {
+            ptGhist--;
+            globalHist.at(ptGhist) = (bv & 1) ? 1 : 0;
+            bv >>= 1;
+
+            uint8_t *gh_ptr = &(globalHist[ptGhist]);
+            for (int i = 1; i <= nHistoryTables; i++) {
+                computeIndices[i].update(gh_ptr);
+                computeTags0[i].update(gh_ptr);
+                computeTags1[i].update(gh_ptr);
+            }
+        }
+    }
+
+    void
+    calculateIndicesAndTags(Addr branch_pc, BranchInfo *bi)
+    {
+        for (int i = 1; i <= nHistoryTables; i++) {
+            tableIndices[i] = gindex(branch_pc, i);
+            bi->tableIndices[i] = tableIndices[i];
+            tableTags[i] = gtag(branch_pc, i);
+            bi->tableTags[i] = tableTags[i];
+        }
+        bi->valid = true;
+    }
+
+    bool
+    tagePredict(Addr branch_pc, bool cond_branch, BranchInfo *bi)
+    {
+        if (!cond_branch)
+            return true;
+
+        calculateIndicesAndTags(branch_pc, bi);
+        bi->bimodalIndex = bindex(branch_pc);
+
+        bi->hitBank = 0;
+        bi->altBank = 0;
+        for (int i = nHistoryTables; i > 0; i--) {
+            if (noSkip[i] &&
+                gtable[i][tableIndices[i]].tag == tableTags[i]) {
+                bi->hitBank = i;
+                bi->hitBankIndex = tableIndices[bi->hitBank];
+                break;
+            }
+        }
+        for (int i = bi->hitBank - 1; i > 0; i--) {
+            if (noSkip[i] &&
+                gtable[i][tableIndices[i]].tag == tableTags[i]) {
+                bi->altBank = i;
+                bi->altBankIndex = tableIndices[bi->altBank];
+                break;
+            }
+        }
+        if (bi->hitBank > 0) {
+            if (bi->altBank > 0) {
+                bi->altTaken =
+                    gtable[bi->altBank][tableIndices[bi->altBank]].ctr >= 0;
+            } else {
+                bi->altTaken = btablePrediction[bi->bimodalIndex];
+            }
+
+            bi->longestMatchPred =
+                gtable[bi->hitBank][tableIndices[bi->hitBank]].ctr >= 0;
+            bi->pseudoNewAlloc =
+                abs(2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) <= 1;
+
+            if ((useAltPredForNewlyAllocated[0] < 0)
+                || ! bi->pseudoNewAlloc) {
+                bi->tagePred = bi->longestMatchPred;
+                bi->provider = TAGEBase::TAGE_LONGEST_MATCH;
+            } else {
+                bi->tagePred = bi->altTaken;
+                bi->provider = bi->altBank ? TAGEBase::TAGE_ALT_MATCH
+                                           : TAGEBase::BIMODAL_ALT_MATCH;
+            }
+        } else {
+            bi->altTaken = btablePrediction[bi->bimodalIndex];
+            bi->tagePred = bi->altTaken;
+            bi->longestMatchPred = bi->altTaken;
+            bi->provider = TAGEBase::BIMODAL_ONLY;
+        }
+        return bi->tagePred;
+    }
+
+    void
+    handleAllocAndUReset(bool alloc, bool taken, BranchInfo *bi, int nrand)
+    {
+        if (alloc) {
+            uint8_t min = 1;
+            for (int i = nHistoryTables; i > bi->hitBank; i--) {
+                if (gtable[i][bi->tableIndices[i]].u < min) {
+                    min = gtable[i][bi->tableIndices[i]].u;
+                }
+            }
+
+            int Y = nrand &
+                ((1ULL << (nHistoryTables - bi->hitBank - 1)) - 1);
+            int X = bi->hitBank + 1;
+            if (Y & 1) {
+                X++;
+                if (Y & 2)
+                    X++;
+            }
+            if (min > 0) {
+                gtable[X][bi->tableIndices[X]].u = 0;
+            }
+
+            unsigned numAllocated = 0;
+            for (int i = X; i <= nHistoryTables; i++) {
+                if (gtable[i][bi->tableIndices[i]].u == 0) {
+                    gtable[i][bi->tableIndices[i]].tag = bi->tableTags[i];
+                    gtable[i][bi->tableIndices[i]].ctr = (taken) ? 0 : -1;
+                    ++numAllocated;
+                    if (numAllocated == maxNumAlloc) {
+                        break;
+                    }
+                }
+            }
+        }
+
+        tCounter++;
+
+        if ((tCounter & ((1ULL << logUResetPeriod) - 1)) == 0) {
+            for (int i = 1; i <= nHistoryTables; i++) {
+                for (auto &entry : gtable[i])
+                    entry.u >>= 1;
+            }
+        }
+    }
+
+    void
+    handleTAGEUpdate(bool taken, BranchInfo *bi)
+    {
+        if (bi->hitBank > 0) {
+            ctrUpdate(gtable[bi->hitBank][bi->hitBankIndex].ctr, taken,
+                      tagTableCounterBits);
+            if (gtable[bi->hitBank][bi->hitBankIndex].u == 0) {
+                if (bi->altBank > 0) {
+                    ctrUpdate(gtable[bi->altBank][bi->altBankIndex].ctr,
+                              taken, tagTableCounterBits);
+                }
+                if (bi->altBank == 0) {
+                    baseUpdate(taken, bi);
+                }
+            }
+
+            if (bi->tagePred != bi->altTaken) {
+                unsignedCtrUpdate(gtable[bi->hitBank][bi->hitBankIndex].u,
+                                  bi->tagePred == taken, tagTableUBits);
+            }
+        } else {
+            baseUpdate(taken, bi);
+        }
+    }
+
+    void
+    condBranchUpdate(bool taken, BranchInfo *bi, int nrand)
+    {
+        bool alloc = (bi->tagePred != taken) &&
+                     (bi->hitBank < nHistoryTables);
+
+        if (bi->hitBank > 0) {
+            if (bi->pseudoNewAlloc) {
+                if (bi->longestMatchPred == taken) {
+                    alloc = false;
+                }
+                if (bi->longestMatchPred != bi->altTaken) {
+                    ctrUpdate(useAltPredForNewlyAllocated[0],
+                              bi->altTaken == taken, useAltOnNaBits);
+                }
+            }
+        }
+
+        handleAllocAndUReset(alloc, taken, bi, nrand);
+        handleTAGEUpdate(taken, bi);
+    }
+
+    int
+    calcNewPathHist(Addr pc, int cur_phist, bool taken) const
+    {
+        if (takenOnlyHistory && !taken) {
+            return cur_phist;
+        }
+        int pathbit = ((pc >> instShiftAmt) & 1);
+        cur_phist = (cur_phist << 1) + pathbit;
+        cur_phist = (cur_phist & ((1ULL << pathHistBits) - 1));
+        return cur_phist;
+    }
+
+    void
+    recordHistState(BranchInfo *bi)
+    {
+        bi->pathHist = pathHist;
+        for (int i = 1; i <= nHistoryTables; i++) {
+            bi->ci[i] = computeIndices[i].comp;
+            bi->ct0[i] = computeTags0[i].comp;
+            bi->ct1[i] = computeTags1[i].comp;
+        }
+    }
+
+    void
+    restoreHistState(BranchInfo *bi)
+    {
+        if (!bi->modified) {
+            return;
+        }
+
+        pathHist = bi->pathHist;
+
+        if (bi->nGhist == 0)
+            return;
+
+        for (int n = 0; n < bi->nGhist; n++) {
+            uint8_t *gh_ptr = &(globalHist[ptGhist]);
+            for (int i = 1; i <= nHistoryTables; i++) {
+                computeIndices[i].restore(gh_ptr);
+                computeTags0[i].restore(gh_ptr);
+                computeTags1[i].restore(gh_ptr);
+            }
+            ptGhist++;
+        }
+        bi->nGhist = 0;
+        bi->modified = false;
+    }
+
+    void
+    updateHistories(Addr branch_pc, bool speculative, bool taken,
+                    Addr target, BranchInfo *bi)
+    {
+        if (!speculative) {
+            nonSpecPathHist = calcNewPathHist(branch_pc, bi->pathHist, taken);
+            return;
+        }
+
+        if (!bi->modified) {
+            recordHistState(bi);
+        }
+        if (bi->modified) {
+            restoreHistState(bi);
+        }
+        if (!bi->valid && bi->condBranch) {
+            calculateIndicesAndTags(branch_pc, bi);
+        }
+
+        pathHist = calcNewPathHist(branch_pc, pathHist, taken);
+        if (takenOnlyHistory) {
+            if (taken) {
+                bi->ghist = (((branch_pc >> instShiftAmt) >> 2) ^
+                             ((target >> instShiftAmt) >> 3));
+                bi->nGhist = 2;
+            }
+        } else {
+            bi->ghist = taken ? 1 : 0;
+            bi->nGhist = 1;
+        }
+        updateGHist(bi->ghist, bi->nGhist);
+        bi->modified = true;
+    }
+
+    const unsigned logRatioBiModalHystEntries;
+    const int nHistoryTables;
+    const unsigned tagTableCounterBits;
+    const unsigned tagTableUBits;
+    const int histBufferSize;
+    const int minHist;
+    const int maxHist;
+    const unsigned pathHistBits;
+    std::vector<unsigned> tagTableTagWidths;
+    std::vector<int> logTagTableSizes;
+    const uint64_t logUResetPeriod;
+    const unsigned useAltOnNaBits;
+    const unsigned maxNumAlloc;
+    const bool takenOnlyHistory;
+    std::vector<bool> noSkip;
+    const unsigned instShiftAmt;
+
+    std::vector<int> histLengths;
+    std::vector<bool> btablePrediction;
+    std::vector<bool> btableHysteresis;
+    std::vector<std::vector<TageEntry>> gtable;
+    std::vector<int> tableIndices;
+    std::vector<int> tableTags;
+    std::vector<int8_t> useAltPredForNewlyAllocated;
+    int64_t tCounter;
+
+    int pathHist = 0;
+    int nonSpecPathHist = 0;
+    std::vector<uint8_t> globalHist;
+    int ptGhist = 0;
+    std::vector<FoldedHistory> computeIndices;
+    std::vector<FoldedHistory> computeTags0;
+    std::vector<FoldedHistory> computeTags1;
+};
+
+/** A correct path branch of the synthetic trace. */
+struct TraceBranch
+{
+    Addr pc;
+    bool conditional;
+    bool taken;
+    Addr target;
+};
+
+/**
+ * Generates a correct path trace from a set of static branches with
+ * biased, loop, history correlated and random behaviour.
+ */
+std::vector<TraceBranch>
+makeTrace(unsigned length, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    const int numStatic = 64;
+    std::vector<Addr> pcs(numStatic);
+    for (auto &pc : pcs)
+        pc = 0x400000 + ((rng() & 0xfffff) << 2);
+
+    std::vector<TraceBranch> trace;
+    std::vector<unsigned> loopCount(numStatic, 0);
+    uint64_t outcomes = 0;
+    for (unsigned n = 0; n < length; n++) {
+        const int b = rng() % numStatic;
+        bool taken;
+        bool conditional = true;
+        switch (b % 8) {
+          case 0:
+            conditional = false;
+            taken = true;
+            break;
+          case 1:
+          case 2:
+            taken = (rng() % 16) != 0;
+            break;
+          case 3:
+            taken = ++loopCount[b] % (3 + b % 5) != 0;
+            break;
+          case 4:
+          case 5:
+            taken = ((outcomes >> (b % 7)) ^ (outcomes >> (b % 13))) & 1;
+            break;
+          case 6:
+            taken = (outcomes >> (b % 23)) & 1;
+            break;
+          default:
+            taken = rng() & 1;
+            break;
+        }
+        outcomes = (outcomes << 1) | taken;
+        trace.push_back({pcs[b], conditional, taken,
+                         pcs[b] + 0x40 + ((Addr)(b * 36) << 2)});
+    }
+    return trace;
+}
+
+void
+expectSameHistories(TestTAGE &tage, ReferenceTage &ref)
+{
+    const auto &hist = tage.threadHistory[tid];
+    ASSERT_EQ(hist.pathHist, ref.pathHist);
+    ASSERT_EQ(hist.nonSpecPathHist, ref.nonSpecPathHist);
+    ASSERT_EQ(hist.ptGhist, ref.ptGhist);
+    ASSERT_EQ(hist.globalHist, ref.globalHist);
+    for (int i = 1; i <= ref.nHistoryTables; i++) {
+        ASSERT_EQ(hist.computeIndices[i].comp, ref.computeIndices[i].comp);
+        ASSERT_EQ(hist.computeTags[0][i].comp, ref.computeTags0[i].comp);
+        ASSERT_EQ(hist.computeTags[1][i].comp, ref.computeTags1[i].comp);
+    }
+}
+
+void
+expectSameTables(TestTAGE &tage, ReferenceTage &ref)
+{
+    ASSERT_EQ(tage.btablePrediction, ref.btablePrediction);
+    ASSERT_EQ(tage.btableHysteresis, ref.btableHysteresis);
+    ASSERT_EQ(tage.useAltPredForNewlyAllocated,
+              ref.useAltPredForNewlyAllocated);
+    ASSERT_EQ(tage.tCounter, ref.tCounter);
+    for (int i = 1; i <= ref.nHistoryTables; i++) {
+        for (int j = 0; j < ref.gtable[i].size(); j++) {
+            const auto entry = tage.gtable[i][j];
+            ASSERT_EQ(entry.ctr, ref.gtable[i][j].ctr) << i << ":" << j;
+            ASSERT_EQ(entry.tag, ref.gtable[i][j].tag) << i << ":" << j;
+            ASSERT_EQ(entry.u, ref.gtable[i][j].u) << i << ":" << j;
+        }
+    }
+}
+
+void
+expectSamePrediction(const TAGEBase::BranchInfo &bi,
+                     const ReferenceTage::BranchInfo &ref, int n)
+{
+    ASSERT_EQ(bi.tagePred, ref.tagePred);
+    ASSERT_EQ(bi.provider, ref.provider);
+    ASSERT_EQ(bi.hitBank, ref.hitBank);
+    ASSERT_EQ(bi.altBank, ref.altBank);
+    ASSERT_EQ(bi.altTaken, ref.altTaken);
+    ASSERT_EQ(bi.longestMatchPred, ref.longestMatchPred);
+    ASSERT_EQ(bi.pseudoNewAlloc, ref.pseudoNewAlloc);
+    ASSERT_EQ(bi.bimodalIndex, ref.bimodalIndex);
+    if (bi.hitBank)
+        ASSERT_EQ(bi.hitBankIndex, ref.hitBankIndex);
+    if (bi.altBank)
+        ASSERT_EQ(bi.altBankIndex, ref.altBankIndex);
+    for (int i = 1; i <= n; i++) {
+        ASSERT_EQ(bi.tableIndices[i], ref.tableIndices[i]) << "bank " << i;
+        ASSERT_EQ(bi.tableTags[i], ref.tableTags[i]) << "bank " << i;
+    }
+}
+
+TAGEBaseParams
+defaultParams()
+{
+    TAGEBaseParams p;
+    p.name = "tage";
+    p.eventq_index = 0;
+    p.numThreads = 1;
+    p.instShiftAmt = 2;
+    p.nHistoryTables = 7;
+    p.minHist = 5;
+    p.maxHist = 130;
+    p.tagTableTagWidths = {0, 9, 9, 10, 10, 11, 11, 12};
+    p.logTagTableSizes = {13, 9, 9, 9, 9, 9, 9, 9};
+    p.logRatioBiModalHystEntries = 2;
+    p.tagTableCounterBits = 3;
+    p.tagTableUBits = 2;
+    // Small enough for the global history to roll over several times.
+    p.histBufferSize = 4096;
+    p.pathHistBits = 16;
+    p.logUResetPeriod = 10;
+    p.numUseAltOnNa = 1;
+    p.initialTCounterValue = 1 << 9;
+    p.useAltOnNaBits = 4;
+    p.maxNumAlloc = 1;
+    p.speculativeHistUpdate = true;
+    p.takenOnlyHistory = false;
+    return p;
+}
+
+/**
+ * Drives both predictors the way the TAGE branch predictor does: predict
+ * and speculatively update the histories at fetch, keep a window of
+ * branches in flight, and when the oldest one resolves either squash the
+ * younger ones and repair the histories on a misprediction, or update the
+ * tables at commit.
+ */
+void
+checkPredictionStream(const TAGEBaseParams &p, unsigned length,
+                      unsigned seed)
+{
+    TestTAGE tage(p);
+    tage.init();
+    ReferenceTage ref(p);
+    const int n = p.nHistoryTables;
+
+    struct InFlight
+    {
+        unsigned pos;
+        bool predTaken;
+        TAGEBase::BranchInfo *bi;
+        ReferenceTage::BranchInfo *refBi;
+    };
+    std::deque<InFlight> window;
+    const auto trace = makeTrace(length, seed);
+    std::mt19937 rng(seed);
+
+    unsigned fetch = 0;
+    unsigned mispredicts = 0;
+    while (fetch < trace.size() || !window.empty()) {
+        if (fetch < trace.size() && window.size() < 1 + rng() % 12) {
+            const auto &br = trace[fetch];
+            auto bi = tage.makeBranchInfo(br.pc, br.conditional);
+            auto ref_bi = new ReferenceTage::BranchInfo(n, br.pc,
+                                                        br.conditional);
+            const bool pred = tage.tagePredict(tid, br.pc, br.conditional,
+                                               bi);
+            ASSERT_EQ(pred, ref.tagePredict(br.pc, br.conditional, ref_bi));
+            if (br.conditional)
+                expectSamePrediction(*bi, *ref_bi, n);
+
+            tage.updateHistories(tid, br.pc, true, pred, br.target,
+                                 noInst, bi);
+            ref.updateHistories(br.pc, true, pred, br.target, ref_bi);
+            window.push_back({fetch, pred, bi, ref_bi});
+            fetch++;
+            if (::testing::Test::HasFatalFailure())
+                return;
+            continue;
+        }
+
+        InFlight oldest = window.front();
+        const auto &br = trace[oldest.pos];
+        if (oldest.predTaken != br.taken) {
+            mispredicts++;
+            while (window.size() > 1) {
+                InFlight &youngest = window.back();
+                tage.restoreHistState(tid, youngest.bi);
+                ref.restoreHistState(youngest.refBi);
+                delete youngest.bi;
+                delete youngest.refBi;
+                window.pop_back();
+            }
+            tage.squash(tid, br.taken, br.target, noInst,
+                        oldest.bi);
+            ref.updateHistories(br.pc, true, br.taken, br.target,
+                                oldest.refBi);
+            fetch = oldest.pos + 1;
+            expectSameHistories(tage, ref);
+        }
+
+        if (br.conditional) {
+            const int nrand = rng();
+            tage.condBranchUpdate(tid, br.pc, br.taken, oldest.bi, nrand,
+                                  br.target, oldest.bi->tagePred);
+            ref.condBranchUpdate(br.taken, oldest.refBi, nrand);
+        }
+        tage.updateHistories(tid, br.pc, false, br.taken, br.target,
+                             noInst, oldest.bi);
+        ref.updateHistories(br.pc, false, br.taken, br.target,
+                            oldest.refBi);
+        delete oldest.bi;
+        delete oldest.refBi;
+        window.pop_front();
+
+        if (::testing::Test::HasFatalFailure())
+            return;
+    }
+
+    // Make sure the stream actually exercised squashes and the tables.
+    EXPECT_GT(mispredicts, length / 50);
+    expectSameHistories(tage, ref);
+    expectSameTables(tage, ref);
+}
+
+} // anonymous namespace
+
+TEST(TAGEBaseTest, PredictionStreamDefault)
+{
+    checkPredictionStream(defaultParams(), 60000, 1);
+}
+
+TEST(TAGEBaseTest, PredictionStreamSkippedBanksAndMultiAlloc)
+{
+    TAGEBaseParams p = defaultParams();
+    p.nHistoryTables = 12;
+    p.minHist = 4;
+    p.maxHist = 640;
+    p.tagTableTagWidths = {0, 7, 7, 8, 8, 9, 10, 11, 12, 12, 13, 14, 15};
+    p.logTagTableSizes = {12, 10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 12,
+                          12};
+    p.noSkip = {true, true, false, true, true, true, false, true, true,
+                true, true, false, true};
+    p.maxNumAlloc = 2;
+    p.logUResetPeriod = 8;
+    checkPredictionStream(p, 60000, 2);
+}
+
+TEST(TAGEBaseTest, PredictionStreamTakenOnlyHistory)
+{
+    TAGEBaseParams p = defaultParams();
+    p.takenOnlyHistory = true;
+    checkPredictionStream(p, 60000, 3);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/tage_kernels.hh"
+
+/*
+ * The kernels below are plain loops over the per table arrays without
+ * branches or calls, which is what the compiler needs to vectorize
+ * them. The shift amounts differ per table, so vectorizing them needs
+ * variable per lane shifts that the baseline x86-64 ISA lacks. On x86-64
+ * hosts an AVX2 clone of each kernel is therefore built next to the
+ * portable one and selected at load time when the host supports it.
+ * Other hosts compile the portable loops only.
+ */
+#if defined(__x86_64__) && defined(__ELF__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define TAGE_KERNEL [[gnu::target_clones("avx2", "default")]]
+#endif
+#endif
+
+#ifndef TAGE_KERNEL
+#define TAGE_KERNEL
+#endif
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace tage_kernels
+{
+
+TAGE_KERNEL void
+computeIndicesAndTags(const TableGeometry &g, uint32_t shifted_pc,
+                      uint32_t path_hist, const uint32_t *comp_idx,
+                      const uint32_t *comp_tag0, const uint32_t *comp_tag1,
+                      int *__restrict__ indices, int *__restrict__ tags)
+{
+    const uint32_t *index_mask = g.indexMask.data();
+    const uint32_t *tag_mask = g.tagMask.data();
+    const uint32_t *path_mask = g.pathMask.data();
+    const uint32_t *pc_shift = g.pcShift.data();
+    const uint32_t *log_size = g.logSize.data();
+    const uint32_t *rot_left = g.rotLeft.data();
+    const uint32_t *rot_right = g.rotRight.data();
+    // A signed trip count lets the compiler prove the loop terminates.
+    const int n = g.numTables;
+
+    for (int i = 1; i <= n; i++) {
+        // Path history shuffle (TAGEBase::F)
+        uint32_t a = path_hist & path_mask[i];
+        const uint32_t a1 = a & index_mask[i];
+        uint32_t a2 = a >> log_size[i];
+        a2 = ((a2 << rot_left[i]) & index_mask[i]) + (a2 >> rot_right[i]);
+        a = a1 ^ a2;
+        a = ((a << rot_left[i]) & index_mask[i]) + (a >> rot_right[i]);
+
+        const uint32_t index = shifted_pc ^ (shifted_pc >> pc_shift[i]) ^
+                               comp_idx[i] ^ a;
+        const uint32_t tag = shifted_pc ^ comp_tag0[i] ^ (comp_tag1[i] << 1);
+
+        indices[i] = index & index_mask[i];
+        tags[i] = tag & tag_mask[i];
+    }
+}
+
+TAGE_KERNEL uint64_t
+matchTags(unsigned num_tables, const uint16_t *const *tag_arrays,
+          const int *indices, const int *tags)
+{
+    uint64_t hits = 0;
+    // A 64-bit induction variable keeps the shifts in one lane width.
+    for (uint64_t i = 1; i <= num_tables; i++) {
+        const uint64_t match = tag_arrays[i][indices[i]] == tags[i];
+        hits |= match << i;
+    }
+    return hits;
+}
+
+TAGE_KERNEL void
+foldIn(FoldedHistories &f, const uint8_t *__restrict__ h)
+{
+    uint32_t *__restrict__ comp = f.comp.data();
+    const uint32_t *comp_length = f.compLength.data();
+    const uint32_t *orig_length = f.origLength.data();
+    const uint32_t *outpoint = f.outpoint.data();
+    const int n = f.size();
+    const uint32_t newest = h[0];
+
+    // Hosts cannot gather bytes, so the bits leaving the histories are
+    // read first and the folding is done on whole words.
+    uint32_t oldest[FoldedHistories::MaxSize];
+    for (int i = 0; i < n; i++) {
+        oldest[i] = h[orig_length[i]];
+    }
+    for (int i = 0; i < n; i++) {
+        uint32_t c = (comp[i] << 1) | newest;
+        c ^= oldest[i] << outpoint[i];
+        c ^= c >> comp_length[i];
+        comp[i] = c & ((1U << comp_length[i]) - 1);
+    }
+}
+
+TAGE_KERNEL void
+foldOut(FoldedHistories &f, const uint8_t *__restrict__ h)
+{
+    uint32_t *__restrict__ comp = f.comp.data();
+    const uint32_t *comp_length = f.compLength.data();
+    const uint32_t *orig_length = f.origLength.data();
+    const uint32_t *outpoint = f.outpoint.data();
+    const int n = f.size();
+    const uint32_t newest = h[0];
+
+    uint32_t oldest[FoldedHistories::MaxSize];
+    for (int i = 0; i < n; i++) {
+        oldest[i] = h[orig_length[i]];
+    }
+    for (int i = 0; i < n; i++) {
+        const uint32_t c = comp[i] ^ (oldest[i] << outpoint[i]);
+        const uint32_t tmp = (c & 1) ^ newest;
+        comp[i] = (tmp << (comp_length[i] - 1)) | (c >> 1);
+    }
+}
+
+} // namespace tage_kernels
+} // namespace branch_prediction
+} // namespace gem5
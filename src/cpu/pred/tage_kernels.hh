@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_TAGE_KERNELS_HH__
+#define __CPU_PRED_TAGE_KERNELS_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace tage_kernels
+{
+
+/** The kernels handle up to this many tagged tables. */
+constexpr int MaxTables = 63;
+
+/**
+ * Constant per table parameters of the partially tagged TAGE tables in
+ * structure-of-arrays form. Entry 0 belongs to the bimodal table and is
+ * unused, so the arrays can be indexed by bank number.
+ */
+struct TableGeometry
+{
+    unsigned numTables = 0;
+
+    /** Mask of the index bits of each table. */
+    std::vector<uint32_t> indexMask;
+    /** Mask of the tag bits of each table. */
+    std::vector<uint32_t> tagMask;
+    /** Mask of the path history bits mixed into the index. */
+    std::vector<uint32_t> pathMask;
+    /** Shift of the second PC term of the index hash. */
+    std::vector<uint32_t> pcShift;
+    /** Log2 of the table size. */
+    std::vector<uint32_t> logSize;
+    /** Rotation amounts of the path history shuffle. */
+    std::vector<uint32_t> rotLeft;
+    std::vector<uint32_t> rotRight;
+
+    /**
+     * @param num_tables Number of tagged tables.
+     * @param log_sizes Log2 of the size of each table (bank indexed).
+     * @param tag_widths The tag width of each table (bank indexed).
+     * @param hist_lengths The history length of each table (bank indexed).
+     * @param path_hist_bits The number of path history bits.
+     */
+    template <class SizeVec, class WidthVec, class HistVec>
+    void
+    init(unsigned num_tables, const SizeVec &log_sizes,
+         const WidthVec &tag_widths, const HistVec &hist_lengths,
+         unsigned path_hist_bits)
+    {
+        numTables = num_tables;
+        indexMask.assign(num_tables + 1, 0);
+        tagMask.assign(num_tables + 1, 0);
+        pathMask.assign(num_tables + 1, 0);
+        pcShift.assign(num_tables + 1, 0);
+        logSize.assign(num_tables + 1, 0);
+        rotLeft.assign(num_tables + 1, 0);
+        rotRight.assign(num_tables + 1, 0);
+
+        for (int i = 1; i <= (int)num_tables; i++) {
+            const int log_size = log_sizes[i];
+            const unsigned hlen =
+                ((unsigned)hist_lengths[i] > path_hist_bits)
+                    ? path_hist_bits : hist_lengths[i];
+            indexMask[i] = (1ULL << log_size) - 1;
+            tagMask[i] = (1ULL << tag_widths[i]) - 1;
+            pathMask[i] = (1ULL << hlen) - 1;
+            pcShift[i] = std::abs(log_size - i) + 1;
+            logSize[i] = log_size;
+            rotLeft[i] = i;
+            // Tables with more banks than index bits rotate by a negative
+            // amount. Hosts mask the shift count of a 32-bit shift to five
+            // bits which is replicated here.
+            rotRight[i] = (uint32_t)(log_size - i) & 31;
+        }
+    }
+};
+
+/**
+ * Folded (compressed) histories in structure-of-arrays form. A folded
+ * history XORs the last origLength bits of the global history into
+ * compLength bits and is updated incrementally as bits are shifted in
+ * and out of the global history. TAGE keeps three folded histories per
+ * tagged table, all of which are stored in one FoldedHistories object so
+ * that they are updated in a single pass. Bank indexed views select one
+ * group of them.
+ *
+ * Entries that are never initialized keep a compressed length of one
+ * bit and an original length of zero. Their value stays zero through
+ * any sequence of foldIn() and foldOut() calls, which matches the unused
+ * bank 0 entry of the per table histories.
+ */
+struct FoldedHistories
+{
+    /** Size of the largest supported set of folded histories. */
+    static constexpr unsigned MaxSize = 3 * (MaxTables + 1);
+
+    std::vector<uint32_t> comp;
+    std::vector<uint32_t> compLength;
+    std::vector<uint32_t> origLength;
+    std::vector<uint32_t> outpoint;
+
+    /** One folded history. */
+    struct Ref
+    {
+        uint32_t &comp;
+        uint32_t &compLength;
+        uint32_t &origLength;
+        uint32_t &outpoint;
+
+        void
+        init(int original_length, int compressed_length)
+        {
+            assert(compressed_length > 0 && compressed_length < 32);
+            origLength = original_length;
+            compLength = compressed_length;
+            outpoint = original_length % compressed_length;
+        }
+    };
+
+    /** A bank indexed group of folded histories. */
+    struct View
+    {
+        FoldedHistories *histories = nullptr;
+        unsigned offset = 0;
+
+        Ref operator[](int bank) const { return (*histories)[offset + bank]; }
+
+        /** The compressed values of the group, bank indexed. */
+        const uint32_t *comps() const
+        {
+            return histories->comp.data() + offset;
+        }
+    };
+
+    void
+    resize(unsigned size)
+    {
+        assert(size <= MaxSize);
+        comp.assign(size, 0);
+        compLength.assign(size, 1);
+        origLength.assign(size, 0);
+        outpoint.assign(size, 0);
+    }
+
+    unsigned size() const { return comp.size(); }
+
+    Ref
+    operator[](unsigned i)
+    {
+        return Ref{comp[i], compLength[i], origLength[i], outpoint[i]};
+    }
+
+    View view(unsigned offset) { return View{this, offset}; }
+};
+
+/**
+ * Computes the indices and partial tags of all tagged tables in one
+ * pass. Equivalent to TAGEBase::gindex() and TAGEBase::gtag() for every
+ * bank.
+ *
+ * @param g The table geometry.
+ * @param shifted_pc The branch PC shifted by the instruction shift.
+ * @param path_hist The speculative path history.
+ * @param comp_idx The folded index histories (bank indexed).
+ * @param comp_tag0 The first folded tag histories (bank indexed).
+ * @param comp_tag1 The second folded tag histories (bank indexed).
+ * @param indices Output of the table indices (bank indexed).
+ * @param tags Output of the partial tags (bank indexed).
+ */
+void computeIndicesAndTags(const TableGeometry &g, uint32_t shifted_pc,
+                           uint32_t path_hist, const uint32_t *comp_idx,
+                           const uint32_t *comp_tag0,
+                           const uint32_t *comp_tag1,
+                           int *__restrict__ indices,
+                           int *__restrict__ tags);
+
+/**
+ * Compares the tags stored in the indexed entries of all tagged tables
+ * against the computed partial tags in one pass.
+ *
+ * @param num_tables Number of tagged tables (at most MaxTables).
+ * @param tag_arrays The tag array of each table (bank indexed).
+ * @param indices The indices of the entries to compare (bank indexed).
+ * @param tags The computed partial tags (bank indexed).
+ * @return A bit mask where bit i is set if table i hits.
+ */
+uint64_t matchTags(unsigned num_tables, const uint16_t *const *tag_arrays,
+                   const int *indices, const int *tags);
+
+/**
+ * Shifts the newest global history bit h[0] into all folded histories
+ * and the bit that left each history, h[origLength], out.
+ *
+ * @param f The folded histories.
+ * @param h The global history, newest bit first.
+ */
+void foldIn(FoldedHistories &f, const uint8_t *h);
+
+/**
+ * Reverts foldIn() for the same global history pointer.
+ *
+ * @param f The folded histories.
+ * @param h The global history, newest bit first.
+ */
+void foldOut(FoldedHistories &f, const uint8_t *h);
+
+} // namespace tage_kernels
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_TAGE_KERNELS_HH__
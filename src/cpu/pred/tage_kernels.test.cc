@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+#include "cpu/pred/tage_kernels.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** Copy of the original per table TAGEBase::FoldedHistory */
+struct FoldedHistory
+{
+    unsigned comp = 0;
+    int compLength;
+    int origLength;
+    int outpoint;
+
+    void
+    init(int original_length, int compressed_length)
+    {
+        origLength = original_length;
+        compLength = compressed_length;
+        outpoint = original_length % compressed_length;
+    }
+
+    void
+    update(uint8_t *h)
+    {
+        comp = (comp << 1) | h[0];
+        comp ^= h[origLength] << outpoint;
+        comp ^= (comp >> compLength);
+        comp &= (1ULL << compLength) - 1;
+    }
+
+    void
+    restore(uint8_t *h)
+    {
+        comp ^= h[origLength] << outpoint;
+        auto tmp = (comp & 1) ^ h[0];
+        comp = (tmp << (compLength-1)) | (comp >> 1);
+    }
+};
+
+/**
+ * Reference model holding the histories of a single thread and computing
+ * indices and tags one table at a time as TAGEBase::gindex(), F() and
+ * gtag() did before the kernels.
+ */
+class ReferenceTage
+{
+  public:
+    ReferenceTage(int n, std::vector<int> log_sizes,
+                  std::vector<unsigned> tag_widths, unsigned min_hist,
+                  unsigned max_hist, unsigned path_hist_bits)
+        : nHistoryTables(n), logTagTableSizes(log_sizes),
+          tagTableTagWidths(tag_widths), pathHistBits(path_hist_bits),
+          histLengths(n + 1, 0), globalHist(4 * max_hist, 0),
+          computeIndices(n + 1), computeTags0(n + 1), computeTags1(n + 1)
+    {
+        // TAGEBase::calculateParameters()
+        histLengths[1] = min_hist;
+        histLengths[n] = max_hist;
+        for (int i = 2; i <= n; i++) {
+            histLengths[i] = (int) (((double) min_hist *
+                pow ((double) (max_hist) / (double) min_hist,
+                    (double) (i - 1) / (double) ((n - 1)))) + 0.5);
+        }
+        // TAGEBase::initFoldedHistories()
+        for (int i = 1; i <= n; i++) {
+            computeIndices[i].init(histLengths[i], logTagTableSizes[i]);
+            computeTags0[i].init(histLengths[i], tagTableTagWidths[i]);
+            computeTags1[i].init(histLengths[i], tagTableTagWidths[i] - 1);
+        }
+        ptGhist = globalHist.size() / 2;
+    }
+
+    int
+    F(int A, int size, int bank) const
+    {
+        int A1, A2;
+
+        A = A & ((1ULL << size) - 1);
+        A1 = (A & ((1ULL << logTagTableSizes[bank]) - 1));
+        A2 = (A >> logTagTableSizes[bank]);
+        A2 = ((A2 << bank) & ((1ULL << logTagTableSizes[bank]) - 1))
+           + (A2 >> (logTagTableSizes[bank] - bank));
+        A = A1 ^ A2;
+        A = ((A << bank) & ((1ULL << logTagTableSizes[bank]) - 1))
+          + (A >> (logTagTableSizes[bank] - bank));
+        return (A);
+    }
+
+    int
+    gindex(Addr pc, int bank) const
+    {
+        int index;
+        int hlen = (histLengths[bank] > pathHistBits) ? pathHistBits :
+                                                        histLengths[bank];
+        const unsigned int shiftedPc = pc >> instShiftAmt;
+        index =
+            shiftedPc ^
+            (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
+            computeIndices[bank].comp ^
+            F(pathHist, hlen, bank);
+
+        return (index & ((1ULL << (logTagTableSizes[bank])) - 1));
+    }
+
+    uint16_t
+    gtag(Addr pc, int bank) const
+    {
+        int tag = (pc >> instShiftAmt) ^
+                  computeTags0[bank].comp ^
+                  (computeTags1[bank].comp << 1);
+
+        return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
+    }
+
+    /** Shifts a branch outcome into the global and path histories. */
+    void
+    updateHistories(Addr pc, bool taken)
+    {
+        if (ptGhist == 0) {
+            std::copy(globalHist.begin(),
+                      globalHist.begin() + globalHist.size() / 2,
+                      globalHist.begin() + globalHist.size() / 2);
+            ptGhist = globalHist.size() / 2;
+        }
+        globalHist[--ptGhist] = taken;
+        pathHist = ((pathHist << 1) + ((pc >> instShiftAmt) & 1)) &
+                   ((1ULL << pathHistBits) - 1);
+        for (int i = 1; i <= nHistoryTables; i++) {
+            computeIndices[i].update(&globalHist[ptGhist]);
+            computeTags0[i].update(&globalHist[ptGhist]);
+            computeTags1[i].update(&globalHist[ptGhist]);
+        }
+    }
+
+    /** Shifts the newest outcome out of the folded histories. */
+    void
+    revertHistory()
+    {
+        for (int i = 1; i <= nHistoryTables; i++) {
+            computeIndices[i].restore(&globalHist[ptGhist]);
+            computeTags0[i].restore(&globalHist[ptGhist]);
+            computeTags1[i].restore(&globalHist[ptGhist]);
+        }
+        ptGhist++;
+    }
+
+    const int nHistoryTables;
+    const std::vector<int> logTagTableSizes;
+    const std::vector<unsigned> tagTableTagWidths;
+    const int pathHistBits;
+    const unsigned instShiftAmt = 2;
+    std::vector<int> histLengths;
+
+    std::vector<uint8_t> globalHist;
+    int ptGhist;
+    int pathHist = 0;
+    std::vector<FoldedHistory> computeIndices;
+    std::vector<FoldedHistory> computeTags0;
+    std::vector<FoldedHistory> computeTags1;
+};
+
+/**
+ * The folded histories of the reference model in the layout TAGEBase
+ * uses: index, first and second tag histories, each bank indexed.
+ */
+struct KernelHistories
+{
+    tage_kernels::FoldedHistories folded;
+    tage_kernels::FoldedHistories::View computeIndices;
+    tage_kernels::FoldedHistories::View computeTags[2];
+
+    explicit KernelHistories(const ReferenceTage &ref)
+    {
+        const int n = ref.nHistoryTables;
+        folded.resize(3 * (n + 1));
+        computeIndices = folded.view(0);
+        computeTags[0] = folded.view(n + 1);
+        computeTags[1] = folded.view(2 * (n + 1));
+        for (int i = 1; i <= n; i++) {
+            computeIndices[i].init(ref.histLengths[i],
+                                   ref.logTagTableSizes[i]);
+            computeTags[0][i].init(ref.histLengths[i],
+                                   ref.tagTableTagWidths[i]);
+            computeTags[1][i].init(ref.histLengths[i],
+                                   ref.tagTableTagWidths[i] - 1);
+        }
+    }
+
+    void
+    expectEqual(const ReferenceTage &ref, int step)
+    {
+        for (int i = 1; i <= ref.nHistoryTables; i++) {
+            ASSERT_EQ(computeIndices[i].comp, ref.computeIndices[i].comp)
+                << "step " << step << " bank " << i;
+            ASSERT_EQ(computeTags[0][i].comp, ref.computeTags0[i].comp)
+                << "step " << step << " bank " << i;
+            ASSERT_EQ(computeTags[1][i].comp, ref.computeTags1[i].comp)
+                << "step " << step << " bank " << i;
+        }
+        // The unused bank 0 entries must stay zero as the derived
+        // predictors may read them.
+        ASSERT_EQ(computeIndices[0].comp, 0) << "step " << step;
+        ASSERT_EQ(computeTags[0][0].comp, 0) << "step " << step;
+        ASSERT_EQ(computeTags[1][0].comp, 0) << "step " << step;
+    }
+};
+
+/**
+ * Runs a random branch stream through the reference model and the
+ * kernels. Checks the folded histories, indices, tags and the providing
+ * banks for every prediction and reverts part of the history now and
+ * then as a squash does.
+ */
+void
+checkPredictionStream(ReferenceTage &ref, uint64_t no_skip, unsigned seed)
+{
+    const int n = ref.nHistoryTables;
+
+    tage_kernels::TableGeometry geometry;
+    geometry.init(n, ref.logTagTableSizes, ref.tagTableTagWidths,
+                  ref.histLengths, ref.pathHistBits);
+    KernelHistories kernel(ref);
+
+    // Tag arrays of the tagged tables. Entries get allocated on the fly
+    // to produce a mix of hits and misses.
+    std::vector<std::vector<uint16_t>> tables(n + 1);
+    std::vector<const uint16_t *> tag_arrays(n + 1, nullptr);
+    for (int i = 1; i <= n; i++) {
+        tables[i].resize(1ULL << ref.logTagTableSizes[i], 0);
+        tag_arrays[i] = tables[i].data();
+    }
+
+    std::mt19937 rng(seed);
+    std::vector<Addr> pcs(16);
+    for (auto &pc : pcs) {
+        pc = (rng() & 0xffffff) << 2;
+    }
+
+    std::vector<int> indices(n + 1), tags(n + 1);
+
+    for (int step = 0; step < 20000; step++) {
+        const Addr pc = pcs[rng() % pcs.size()];
+
+        tage_kernels::computeIndicesAndTags(
+            geometry, pc >> ref.instShiftAmt, ref.pathHist,
+            kernel.computeIndices.comps(), kernel.computeTags[0].comps(),
+            kernel.computeTags[1].comps(), indices.data(), tags.data());
+
+        int ref_hit = 0;
+        int ref_alt = 0;
+        for (int i = 1; i <= n; i++) {
+            ASSERT_EQ(indices[i], ref.gindex(pc, i))
+                << "step " << step << " bank " << i;
+            ASSERT_EQ(tags[i], ref.gtag(pc, i))
+                << "step " << step << " bank " << i;
+        }
+        // TAGEBase::tagePredict() search for provider and alternate
+        for (int i = n; i > 0; i--) {
+            if (((no_skip >> i) & 1) && tables[i][indices[i]] == tags[i]) {
+                ref_hit = i;
+                break;
+            }
+        }
+        for (int i = ref_hit - 1; i > 0; i--) {
+            if (((no_skip >> i) & 1) && tables[i][indices[i]] == tags[i]) {
+                ref_alt = i;
+                break;
+            }
+        }
+
+        uint64_t hits = tage_kernels::matchTags(n, tag_arrays.data(),
+                                                indices.data(), tags.data());
+        hits &= no_skip;
+        int hit = 0;
+        int alt = 0;
+        if (hits) {
+            hit = floorLog2(hits);
+            hits &= ~(1ULL << hit);
+        }
+        if (hits) {
+            alt = floorLog2(hits);
+        }
+        ASSERT_EQ(hit, ref_hit) << "step " << step;
+        ASSERT_EQ(alt, ref_alt) << "step " << step;
+
+        // Allocate in one of the next longer tables
+        int bank = ref_hit + 1 + rng() % 2;
+        if (bank <= n) {
+            tables[bank][indices[bank]] = tags[bank];
+        }
+
+        // Mostly biased outcomes keep the histories repetitive enough
+        // for entries to hit again.
+        bool taken = ((pc >> ref.instShiftAmt) & 1) ^ (rng() % 8 == 0);
+        ref.updateHistories(pc, taken);
+        tage_kernels::foldIn(kernel.folded, &ref.globalHist[ref.ptGhist]);
+        kernel.expectEqual(ref, step);
+
+        // Squash a few of the latest outcomes and replay them with
+        // flipped directions.
+        if (rng() % 16 == 0 && ref.ptGhist + 4 < ref.globalHist.size() / 2) {
+            const int depth = 1 + rng() % 4;
+            for (int d = 0; d < depth; d++) {
+                tage_kernels::foldOut(kernel.folded,
+                                      &ref.globalHist[ref.ptGhist]);
+                ref.revertHistory();
+                kernel.expectEqual(ref, step);
+            }
+            for (int d = 0; d < depth; d++) {
+                ref.updateHistories(pc, rng() & 1);
+                tage_kernels::foldIn(kernel.folded,
+                                     &ref.globalHist[ref.ptGhist]);
+                kernel.expectEqual(ref, step);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(TageKernels, DefaultTage)
+{
+    ReferenceTage ref(7, {13, 9, 9, 9, 9, 9, 9, 9},
+                      {0, 9, 9, 10, 10, 11, 11, 12}, 5, 130, 16);
+    checkPredictionStream(ref, ~0ULL, 1);
+}
+
+TEST(TageKernels, SmallTablesAndSkippedBanks)
+{
+    ReferenceTage ref(8, {10, 8, 8, 8, 8, 9, 9, 9, 9},
+                      {0, 7, 7, 8, 8, 9, 10, 11, 12}, 4, 640, 27);
+    checkPredictionStream(ref, 0x1ULL << 1 | 0x1ULL << 3 | 0x1ULL << 4 |
+                               0x1ULL << 7 | 0x1ULL << 8, 2);
+}
+
+TEST(TageKernels, LongTags)
+{
+    ReferenceTage ref(12, {14, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+                           12, 12},
+                      {0, 7, 7, 8, 8, 9, 10, 11, 12, 12, 13, 14, 15},
+                      4, 640, 16);
+    checkPredictionStream(ref, ~0ULL, 3);
+}
@@ -125,9 +125,9 @@ TAGE_SC_L_TAGE::buildTageTables()
     // Trick! We only allocate entries for tables 1 and firstLongTagTable and
     // make the other tables point to these allocated entries
 
-    gtable[1] = new TageEntry[shortTagsTageFactor * (1 << logTagTableSize)];
-    gtable[firstLongTagTable] =
-        new TageEntry[longTagsTageFactor * (1 << logTagTableSize)];
+    gtable[1].allocate(shortTagsTageFactor * (1 << logTagTableSize));
+    gtable[firstLongTagTable].allocate(
+        longTagsTageFactor * (1 << logTagTableSize));
     for (int i = 2; i < firstLongTagTable; ++i) {
         gtable[i] = gtable[1];
     }
@@ -392,22 +392,18 @@ TAGE_SC_L_TAGE::extraAltCalc(TAGEBase::BranchInfo* bi)
     tage_scl_bi->altConf = (abs(2*ctr + 1) > 1);
 }
 
-void
-TAGE_SC_L::branchPlaceholder(ThreadID tid, Addr pc, bool uncond,
-                             void *&bp_history)
+TAGE::TageBranchInfo *
+TAGE_SC_L::makeTageBranchInfo(Addr pc, bool conditional)
 {
-    TageSCLBranchInfo *bi = new TageSCLBranchInfo(*tage, *statisticalCorrector,
-                                                  *loopPredictor, pc, !uncond);
-    bp_history = (void *)(bi);
+    return new TageSCLBranchInfo(*tage, *statisticalCorrector,
+                                 *loopPredictor, pc, conditional);
 }
 
 bool
 TAGE_SC_L::predict(ThreadID tid, Addr pc, bool cond_branch, void* &b)
 {
-    TageSCLBranchInfo *bi = new TageSCLBranchInfo(*tage,
-                                                  *statisticalCorrector,
-                                                  *loopPredictor,
-                                                  pc, cond_branch);
+    TageSCLBranchInfo *bi = static_cast<TageSCLBranchInfo*>(
+        allocBranchInfo(pc, cond_branch));
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, pc, cond_branch,
@@ -523,8 +519,7 @@ TAGE_SC_L::update(ThreadID tid, Addr pc, bool taken, void *&bp_history,
     }
 
 
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 void
@@ -98,6 +98,16 @@ class TAGE_SC_L_TAGE : public TAGEBase
         {}
         virtual ~BranchInfo()
         {}
+
+        void
+        reset(Addr pc, bool cond) override
+        {
+            TAGEBase::BranchInfo::reset(pc, cond);
+            lowConf = false;
+            highConf = false;
+            altConf = false;
+            medConf = false;
+        }
     };
 
     virtual TAGEBase::BranchInfo *makeBranchInfo(Addr pc, bool cond) override;
@@ -180,8 +190,6 @@ class TAGE_SC_L: public LTAGE
     void updateHistories(ThreadID tid, Addr pc, bool uncond,
                          bool taken, Addr target, const StaticInstPtr &inst,
                          void * &bp_history) override;
-    void branchPlaceholder(ThreadID tid, Addr pc, bool uncond,
-                           void *&bp_history) override;
 
   protected:
 
@@ -199,8 +207,17 @@ class TAGE_SC_L: public LTAGE
         {
             delete scBranchInfo;
         }
+
+        void
+        reset(Addr pc, bool cond_branch) override
+        {
+            LTageBranchInfo::reset(pc, cond_branch);
+            *scBranchInfo = StatisticalCorrector::BranchInfo();
+        }
     };
 
+    TageBranchInfo *makeTageBranchInfo(Addr pc, bool conditional) override;
+
     // more provider types
     enum
     {
@@ -61,6 +61,20 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    backdoorAccesses = Param.Bool(
+        False,
+        "Perform plain loads and stores directly on host memory through "
+        "backdoors handed out by the memory system. Backdoors are only "
+        "handed out when no cache sits between the CPU and memory.",
+    )
+    blockCache = Param.Bool(
+        False,
+        "Replay pre-decoded basic blocks instead of fetching and decoding "
+        "instructions executed before (single-threaded only)",
+    )
+    blockCacheSize = Param.Unsigned(
+        65536, "Number of cached basic blocks before the cache is flushed"
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
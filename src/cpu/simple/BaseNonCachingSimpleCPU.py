@@ -51,6 +51,7 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
     cxx_class = "gem5::NonCachingSimpleCPU"
 
     numThreads = 1
+    backdoorAccesses = True
 
     @classmethod
     def memory_mode(cls):
@@ -78,6 +78,7 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      backdoorAccesses(p.backdoorAccesses),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
@@ -88,6 +89,13 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
     data_amo_req = std::make_shared<Request>();
+
+    if (p.blockCache) {
+        fatal_if(p.numThreads > 1,
+                 "The block cache of %s requires a single thread.", name());
+        blockCache = std::make_unique<BasicBlockCache>(this,
+                                                       p.blockCacheSize);
+    }
 }
 
 
@@ -148,6 +156,12 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have changed behind our back while drained, e.g. by
+    // restoring a checkpoint.
+    if (blockCache) {
+        blockCache->clear();
+    }
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -196,6 +210,10 @@ AtomicSimpleCPU::switchOut()
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
+
+    if (blockCache) {
+        blockCache->clear();
+    }
 }
 
 
@@ -268,10 +286,178 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
     BaseCPU::suspendContext(thread_num);
 }
 
+Fault
+AtomicSimpleCPU::translate(const RequestPtr &req, BaseMMU::Mode mode)
+{
+    SimpleThread *thread = threadInfo[curThread]->thread;
+
+    if (numMainEventQueues == 1) {
+        return thread->mmu->translateAtomic(req, thread->getTC(), mode);
+    }
+
+    // SE-mode page tables are shared between CPUs and change on page
+    // faults, so look them up serialised with the memory system.
+    if (!FullSystem) {
+        EventQueue::ScopedMigration migrate(memEventQueue());
+        return thread->mmu->translateAtomic(req, thread->getTC(), mode);
+    }
+
+    // The TLBs belong to this CPU, and table walkers migrate to the
+    // memory system's queue for their accesses themselves. Other CPUs
+    // only touch the TLBs for broadcast invalidations, which hold the
+    // translation lock.
+    std::lock_guard<std::mutex> lock(thread->mmu->translationLock());
+    return thread->mmu->translateAtomic(req, thread->getTC(), mode);
+}
+
+void
+AtomicSimpleCPU::invalidateCode(Addr paddr, unsigned size)
+{
+    if (!blockCache) {
+        return;
+    }
+
+    if (curEventQueue() == eventQueue()) {
+        blockCache->invalidate(paddr, size);
+        return;
+    }
+
+    // Snooped from a CPU running on another host thread; the block
+    // cache is only touched by the thread simulating this CPU.
+    std::lock_guard<std::mutex> lock(pendingInvalidationsMutex);
+    pendingInvalidations.emplace_back(paddr, paddr + size);
+    hasPendingInvalidations = true;
+}
+
+void
+AtomicSimpleCPU::applyPendingInvalidations()
+{
+    std::lock_guard<std::mutex> lock(pendingInvalidationsMutex);
+    for (const auto &range : pendingInvalidations) {
+        blockCache->invalidate(range.start(), range.size());
+    }
+    pendingInvalidations.clear();
+    for (const MemBackdoor *backdoor : revokedBackdoors) {
+        dropBackdoor(backdoor);
+    }
+    revokedBackdoors.clear();
+    hasPendingInvalidations = false;
+}
+
 Tick
 AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
-    return port.sendAtomic(pkt);
+    // The memory system is shared with CPUs on other host threads.
+    EventQueue::ScopedMigration migrate(memEventQueue());
+
+    if (!backdoorAccesses) {
+        return port.sendAtomic(pkt);
+    }
+
+    MemBackdoorPtr bd = nullptr;
+    Tick latency = port.sendAtomicBackdoor(pkt, bd);
+
+    // If the target gave us a backdoor for next time, record it.
+    if (bd) {
+        recordBackdoor(bd);
+    }
+    return latency;
+}
+
+void
+AtomicSimpleCPU::recordBackdoor(MemBackdoorPtr bd)
+{
+    // Nothing to do if we already have it.
+    if (memBackdoors.insert(bd->range(), bd) == memBackdoors.end()) {
+        return;
+    }
+
+    DPRINTF(SimpleCPU, "Got memory backdoor for %s\n",
+            bd->range().to_string());
+
+    // Install a callback to erase this backdoor if it goes away.
+    auto callback = [this](const MemBackdoor &backdoor) {
+            if (numMainEventQueues == 1) {
+                panic_if(!dropBackdoor(&backdoor),
+                         "Got invalidation for unknown memory backdoor.");
+                return;
+            }
+
+            // Revoked by a CPU that may run on another host thread, e.g.
+            // when its load-locked makes memory track the address. Only
+            // the thread simulating this CPU touches memBackdoors. Until
+            // it drops the backdoor, it may still read through it, which
+            // is safe as backdoor writes are disabled in this setup.
+            std::lock_guard<std::mutex> lock(pendingInvalidationsMutex);
+            revokedBackdoors.push_back(&backdoor);
+            hasPendingInvalidations = true;
+        };
+    bd->addInvalidationCallback(callback);
+}
+
+bool
+AtomicSimpleCPU::dropBackdoor(const MemBackdoor *backdoor)
+{
+    if (lastBackdoor == backdoor) {
+        lastBackdoor = nullptr;
+    }
+    for (auto it = memBackdoors.begin(); it != memBackdoors.end(); it++) {
+        if (it->second == backdoor) {
+            memBackdoors.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+MemBackdoorPtr
+AtomicSimpleCPU::findBackdoor(Addr paddr, unsigned size)
+{
+    const Addr last = paddr + (size ? size - 1 : 0);
+    if (lastBackdoor && lastBackdoor->range().contains(paddr) &&
+        lastBackdoor->range().contains(last)) {
+        return lastBackdoor;
+    }
+
+    auto it = memBackdoors.contains(paddr);
+    if (it == memBackdoors.end() || !it->second->range().contains(last)) {
+        return nullptr;
+    }
+
+    lastBackdoor = it->second;
+    return lastBackdoor;
+}
+
+bool
+AtomicSimpleCPU::backdoorAccess(const RequestPtr &req, uint8_t *data,
+                                bool write)
+{
+    // Accesses with side effects the memory system or other CPUs must
+    // see, and accesses whose latency is simulated, use the port.
+    if (!backdoorAccesses || simulate_data_stalls ||
+        req->isLocalAccess() || req->isLLSC() || req->isLockedRMW() ||
+        req->isSwap() || req->isMasked() || req->isCacheMaintenance() ||
+        req->isPrefetch() || req->isMemMgmt()) {
+        return false;
+    }
+
+    // Other thread contexts observe writes through snoops.
+    if (write && system->threads.size() > 1) {
+        return false;
+    }
+
+    MemBackdoorPtr bd = findBackdoor(req->getPaddr(), req->getSize());
+    if (!bd || !(write ? bd->writeable() : bd->readable())) {
+        return false;
+    }
+
+    uint8_t *host = bd->ptr() + (req->getPaddr() - bd->range().start());
+    if (write) {
+        memcpy(host, data, req->getSize());
+    } else {
+        memcpy(data, host, req->getSize());
+    }
+    return true;
 }
 
 Tick
@@ -298,6 +484,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+
+        // Drop cached blocks of code written by someone else
+        cpu->invalidateCode(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +514,11 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    // Functional writes, e.g. by a loader, may overwrite cached code
+    if (pkt->isInvalidate() || pkt->isWrite()) {
+        cpu->invalidateCode(pkt->getAddr(), pkt->getSize());
+    }
 }
 
 bool
@@ -369,6 +563,13 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
+    // A locked read-modify-write keeps the memory system until its write
+    // completes, so that CPUs on other host threads cannot interleave.
+    if (flags.isSet(Request::LOCKED_RMW) && !lockedMigration) {
+        lockedMigration = std::make_unique<EventQueue::ScopedMigration>(
+            memEventQueue());
+    }
+
     dcache_latency = 0;
 
     req->taskId(taskId());
@@ -385,13 +586,20 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
         // translate to physical address
         if (predicate) {
-            fault = thread->mmu->translateAtomic(req, thread->getTC(),
-                                                 BaseMMU::Read);
+            fault = translate(req, BaseMMU::Read);
         }
 
         // Now do the access.
-        if (predicate && fault == NoFault &&
-            !req->getFlags().isSet(Request::NO_ACCESS)) {
+        const bool access = predicate && fault == NoFault &&
+            !req->getFlags().isSet(Request::NO_ACCESS);
+        if (access && backdoorAccess(req, data, false)) {
+            dcache_access = true;
+        } else if (access) {
+            // The load and the update of the monitor are atomic with
+            // respect to snoops from CPUs on other host threads.
+            EventQueue::ScopedMigration migrate(memEventQueue(),
+                                                req->isLLSC());
+
             Packet pkt(req, Packet::makeReadCmd(req));
             pkt.dataStatic(data);
 
@@ -472,11 +680,12 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
         // translate to physical address
         if (predicate)
-            fault = thread->mmu->translateAtomic(req, thread->getTC(),
-                                                 BaseMMU::Write);
+            fault = translate(req, BaseMMU::Write);
 
         // Now do the access.
         if (predicate && fault == NoFault) {
+            EventQueue::ScopedMigration migrate(memEventQueue(),
+                                                req->isLLSC());
             bool do_access = true;  // flag to suppress cache access
 
             if (req->isLLSC()) {
@@ -492,24 +701,33 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
             }
 
             if (do_access && !req->getFlags().isSet(Request::NO_ACCESS)) {
-                Packet pkt(req, Packet::makeWriteCmd(req));
-                pkt.dataStatic(data);
-
-                if (req->isLocalAccess()) {
-                    dcache_latency +=
-                        req->localAccessor(thread->getTC(), &pkt);
+                if (backdoorAccess(req, data, true)) {
+                    dcache_access = true;
                 } else {
-                    dcache_latency += sendPacket(dcachePort, &pkt);
-
-                    // Notify other threads on this CPU of write
-                    threadSnoop(&pkt, curThread);
+                    Packet pkt(req, Packet::makeWriteCmd(req));
+                    pkt.dataStatic(data);
+
+                    if (req->isLocalAccess()) {
+                        dcache_latency +=
+                            req->localAccessor(thread->getTC(), &pkt);
+                    } else {
+                        dcache_latency += sendPacket(dcachePort, &pkt);
+
+                        // Notify other threads on this CPU of write
+                        threadSnoop(&pkt, curThread);
+                    }
+                    dcache_access = true;
+                    panic_if(pkt.isError(), "Data write (%s) failed: %s",
+                            pkt.getAddrRange().to_string(), pkt.print());
+                    if (req->isSwap()) {
+                        assert(res && curr_frag_id == 0);
+                        memcpy(res, pkt.getConstPtr<uint8_t>(), size);
+                    }
                 }
-                dcache_access = true;
-                panic_if(pkt.isError(), "Data write (%s) failed: %s",
-                        pkt.getAddrRange().to_string(), pkt.print());
-                if (req->isSwap()) {
-                    assert(res && curr_frag_id == 0);
-                    memcpy(res, pkt.getConstPtr<uint8_t>(), size);
+
+                // Self-modifying code
+                if (blockCache) {
+                    blockCache->invalidate(req->getPaddr(), frag_size);
                 }
             }
 
@@ -576,8 +794,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
                  thread->pcState().instAddr(), std::move(amo_op));
 
     // translate to physical address
-    Fault fault = thread->mmu->translateAtomic(
-        req, thread->getTC(), BaseMMU::Write);
+    Fault fault = translate(req, BaseMMU::Write);
 
     // Now do the access.
     if (fault == NoFault && !req->getFlags().isSet(Request::NO_ACCESS)) {
@@ -597,6 +814,10 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
         panic_if(pkt.isError(), "Atomic access (%s) failed: %s",
                 pkt.getAddrRange().to_string(), pkt.print());
         assert(!req->isLLSC());
+
+        if (blockCache) {
+            blockCache->invalidate(req->getPaddr(), size);
+        }
     }
 
     if (fault != NoFault && req->isPrefetch()) {
@@ -628,43 +849,71 @@ AtomicSimpleCPU::tick()
     SimpleExecContext &t_info = *threadInfo[curThread];
     SimpleThread *thread = t_info.thread;
 
+    if (hasPendingInvalidations) {
+        applyPendingInvalidations();
+    }
+
     Tick latency = 0;
+    bool inst_started = false;
 
     for (int i = 0; i < width || locked; ++i) {
-        baseStats.numCycles++;
-        updateCycleCounters(BaseCPU::CPU_STATE_ON);
-
-        if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
-            checkForInterrupts();
-            checkPcEventQueue();
-        }
-
         // We must have just got suspended by a PC event
-        if (_status == Idle) {
+        if (!inst_started && !startInst()) {
+            lockedMigration.reset();
             tryCompleteDrain();
             return;
         }
-
-        serviceInstCountEvents();
+        inst_started = false;
 
         Fault fault = NoFault;
 
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+
+        // Continue replaying the current cached block, if any
+        const BasicBlockCache::Entry *cached = nullptr;
+        if (needToFetch && blockCache) {
+            checkBlockContext(t_info);
+            cached = blockCache->next(pc);
+            needToFetch = !cached;
+        }
+
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
-            fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseMMU::Execute);
+            fault = translate(ifetch_req, BaseMMU::Execute);
+            if (fault == NoFault && blockCache) {
+                cached = enterBlock(t_info);
+                needToFetch = !cached;
+            }
+        }
+
+        if (cached) {
+            switch (replayBlock(t_info, cached, i, latency)) {
+              case ReplayEnd::Idle:
+                lockedMigration.reset();
+                tryCompleteDrain();
+                return;
+              case ReplayEnd::Started:
+                inst_started = true;
+                break;
+              case ReplayEnd::Stopped:
+                break;
+            }
+            continue;
         }
 
         if (fault == NoFault) {
             Tick icache_latency = 0;
             bool icache_access = false;
-            dcache_access = false; // assume no dcache access
 
             if (needToFetch) {
+                if (decoderStale) {
+                    thread->decoder->reset();
+                    decoderStale = false;
+                }
+
                 // This is commented out because the decoder would act like
                 // a tiny cache otherwise. It wouldn't be flushed when needed
                 // like the I cache. It should be flushed, and when that works
@@ -677,55 +926,31 @@ AtomicSimpleCPU::tick()
                 //}
             }
 
-            preExecute();
-
-            Tick stall_ticks = 0;
-            if (curStaticInst) {
-                fault = curStaticInst->execute(&t_info, traceData);
-
-                // keep an instruction count
-                if (fault == NoFault) {
-                    postExecute();
-                    countInst();
-                    ppCommit->notify(std::make_pair(thread, curStaticInst));
-                } else if (traceData) {
-                    traceFault();
-                }
-
-                if (fault != NoFault &&
-                    std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
-                    // Retry execution of system calls after a delay.
-                    // Prevents immediate re-execution since conditions which
-                    // caused the retry are unlikely to change every tick.
-                    stall_ticks += clockEdge(syscallRetryLatency) - curTick();
+            if (needToFetch && blockCache && blockCache->recording()) {
+                std::unique_ptr<PCStateBase> fetch_pc(pc.clone());
+                preExecute();
+                if (t_info.stayAtPC || !curStaticInst) {
+                    blockCache->end();
+                } else {
+                    blockCache->record(std::move(fetch_pc),
+                        curMacroStaticInst ? curMacroStaticInst :
+                                             curStaticInst,
+                        thread->pcState());
                 }
+            } else {
+                preExecute();
             }
 
-            // @todo remove me after debugging with legion done
-            if (curStaticInst && (!curStaticInst->isMicroop() ||
-                        curStaticInst->isFirstMicroop())) {
-                instCnt++;
-            }
-
-            if (simulate_inst_stalls && icache_access)
-                stall_ticks += icache_latency;
-
-            if (simulate_data_stalls && dcache_access)
-                stall_ticks += dcache_latency;
-
-            if (stall_ticks) {
-                // the atomic cpu does its accounting in ticks, so
-                // keep counting in ticks but round to the clock
-                // period
-                latency += divCeil(stall_ticks, clockPeriod()) *
-                    clockPeriod();
-            }
-
+            fault = executeInst(t_info,
+                simulate_inst_stalls && icache_access ? icache_latency : 0,
+                latency);
         }
-        if (fault != NoFault || !t_info.stayAtPC)
-            advancePC(fault);
+
+        advanceInst(t_info, fault);
     }
 
+    lockedMigration.reset();
+
     if (tryCompleteDrain())
         return;
 
@@ -737,6 +962,178 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+bool
+AtomicSimpleCPU::startInst()
+{
+    baseStats.numCycles++;
+    updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+    if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
+        checkForInterrupts();
+        checkPcEventQueue();
+    }
+
+    if (_status == Idle)
+        return false;
+
+    serviceInstCountEvents();
+    return true;
+}
+
+Fault
+AtomicSimpleCPU::executeInst(SimpleExecContext &t_info, Tick fetch_stall,
+                             Tick &latency)
+{
+    SimpleThread *thread = t_info.thread;
+    Fault fault = NoFault;
+    Tick stall_ticks = fetch_stall;
+
+    dcache_access = false; // assume no dcache access
+
+    if (curStaticInst) {
+        fault = curStaticInst->execute(&t_info, traceData);
+
+        // keep an instruction count
+        if (fault == NoFault) {
+            postExecute();
+            countInst();
+            ppCommit->notify(std::make_pair(thread, curStaticInst));
+        } else if (traceData) {
+            traceFault();
+        }
+
+        if (fault != NoFault &&
+            std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
+            // Retry execution of system calls after a delay.
+            // Prevents immediate re-execution since conditions which
+            // caused the retry are unlikely to change every tick.
+            stall_ticks += clockEdge(syscallRetryLatency) - curTick();
+        }
+    }
+
+    // @todo remove me after debugging with legion done
+    if (curStaticInst && (!curStaticInst->isMicroop() ||
+                curStaticInst->isFirstMicroop())) {
+        instCnt++;
+    }
+
+    if (simulate_data_stalls && dcache_access)
+        stall_ticks += dcache_latency;
+
+    if (stall_ticks) {
+        // the atomic cpu does its accounting in ticks, so
+        // keep counting in ticks but round to the clock
+        // period
+        latency += divCeil(stall_ticks, clockPeriod()) *
+            clockPeriod();
+    }
+
+    return fault;
+}
+
+void
+AtomicSimpleCPU::advanceInst(SimpleExecContext &t_info, const Fault &fault)
+{
+    // Blocks end at control transfers, faults and instructions that may
+    // change the context, e.g. the translation regime
+    const bool ends_block = curStaticInst &&
+        (curStaticInst->isControl() || curStaticInst->isSerializing() ||
+         curStaticInst->isSerializeAfter() ||
+         curStaticInst->isSquashAfter() ||
+         curStaticInst->isNonSpeculative());
+    if (blockCache && (fault != NoFault || ends_block)) {
+        blockCache->end();
+        if (fault != NoFault) {
+            blockCache->leave();
+        }
+    }
+
+    if (fault != NoFault || !t_info.stayAtPC) {
+        // Faults may emulate system calls or access devices
+        EventQueue::ScopedMigration migrate(memEventQueue(),
+                                            fault != NoFault);
+        advancePC(fault);
+    }
+}
+
+AtomicSimpleCPU::ReplayEnd
+AtomicSimpleCPU::replayBlock(SimpleExecContext &t_info,
+                             const BasicBlockCache::Entry *entry, int &i,
+                             Tick &latency)
+{
+    SimpleThread *thread = t_info.thread;
+    decoderStale = true;
+
+    while (true) {
+        if (entry) {
+            // Replay the decode recorded in the block cache
+            thread->pcState(*entry->decodedPC);
+            preExecute(entry->inst);
+        } else {
+            // Continue the macroop of the last entry
+            preExecute();
+        }
+
+        const Fault fault = executeInst(t_info, 0, latency);
+        advanceInst(t_info, fault);
+
+        const bool in_macroop =
+            isRomMicroPC(thread->pcState().microPC()) || curMacroStaticInst;
+        if (fault != NoFault || (i + 1 >= width && !locked) ||
+            (!in_macroop && !blockCache->replaying())) {
+            return ReplayEnd::Stopped;
+        }
+
+        if (!startInst())
+            return ReplayEnd::Idle;
+
+        const PCStateBase &pc = thread->pcState();
+        entry = nullptr;
+        if (!isRomMicroPC(pc.microPC()) && !curMacroStaticInst) {
+            checkBlockContext(t_info);
+            entry = blockCache->next(pc);
+            // An interrupt or a PC event redirected execution
+            if (!entry)
+                return ReplayEnd::Started;
+        }
+        ++i;
+    }
+}
+
+void
+AtomicSimpleCPU::checkBlockContext(SimpleExecContext &t_info)
+{
+    SimpleThread *thread = t_info.thread;
+    blockCache->checkContext(curThread,
+                             thread->decoder->contextGeneration(),
+                             thread->mmu->translationGeneration());
+}
+
+const BasicBlockCache::Entry *
+AtomicSimpleCPU::enterBlock(SimpleExecContext &t_info)
+{
+    const PCStateBase &pc = t_info.thread->pcState();
+
+    // Only cache instructions fetched in one go from regular memory
+    if (t_info.fetchOffset != 0 || ifetch_req->isUncacheable()) {
+        blockCache->end();
+        return nullptr;
+    }
+
+    if (blockCache->recording()) {
+        return nullptr;
+    }
+
+    const Addr paddr = ifetch_req->getPaddr();
+    if (const BasicBlockCache::Entry *entry = blockCache->enter(pc, paddr)) {
+        return entry;
+    }
+
+    DPRINTF(SimpleCPU, "Recording basic block at %s\n", pc);
+    blockCache->begin(pc, paddr);
+    return nullptr;
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
@@ -41,8 +41,16 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/addr_range_map.hh"
 #include "cpu/simple/base.hh"
+#include "cpu/simple/block_cache.hh"
 #include "cpu/simple/exec_context.hh"
+#include "mem/backdoor.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -67,6 +75,43 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /** Cache of pre-decoded basic blocks, nullptr if disabled. */
+    std::unique_ptr<BasicBlockCache> blockCache;
+
+    /** Set when instructions were replayed from the block cache, so
+     * the decoder must be reset before it decodes fetched bytes. */
+    bool decoderStale = false;
+
+    /** Whether plain data accesses use memory backdoors. */
+    const bool backdoorAccesses;
+
+    /** Backdoors handed out by the memory system, by physical range. */
+    AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
+
+    /** Backdoor used by the last lookup. */
+    MemBackdoorPtr lastBackdoor = nullptr;
+
+    /**
+     * When CPUs are simulated in parallel, each atomic CPU has its own
+     * event queue while devices and the memory system stay on the
+     * system's. Accesses to shared state then migrate to that queue,
+     * which serialises them; backdoor accesses and instruction
+     * execution proceed in parallel. With a single event queue the
+     * migrations are no-ops.
+     */
+    EventQueue *memEventQueue() const { return system->eventQueue(); }
+
+    /** Migration held for the duration of a locked read-modify-write. */
+    std::unique_ptr<EventQueue::ScopedMigration> lockedMigration;
+
+    /** Code invalidations snooped from CPUs on other host threads and
+     * backdoors revoked by them, applied by this CPU at the start of
+     * its next tick. */
+    std::mutex pendingInvalidationsMutex;
+    std::vector<AddrRange> pendingInvalidations;
+    std::vector<const MemBackdoor *> revokedBackdoors;
+    std::atomic<bool> hasPendingInvalidations{false};
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -104,6 +149,98 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool tryCompleteDrain();
 
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
+
+    /** Translates a request. Table walks and SE-mode page tables are
+     * serialised with the memory system. */
+    Fault translate(const RequestPtr &req, BaseMMU::Mode mode);
+
+    /** Drops cached code in a physical range written by others. */
+    void invalidateCode(Addr paddr, unsigned size);
+
+    /** Applies the code invalidations and backdoor revocations
+     * received from other threads. */
+    void applyPendingInvalidations();
+
+    /** Records a backdoor and drops it again once it is revoked. */
+    void recordBackdoor(MemBackdoorPtr bd);
+
+    /** Forgets a backdoor, returning whether it was known. */
+    bool dropBackdoor(const MemBackdoor *backdoor);
+
+    /**
+     * Returns the backdoor covering a physical range or nullptr if
+     * there is none.
+     */
+    MemBackdoorPtr findBackdoor(Addr paddr, unsigned size);
+
+    /**
+     * Performs a translated data access directly on host memory if a
+     * backdoor covers it and the access has no side effects beyond
+     * reading or writing memory.
+     *
+     * @return Whether the access was performed.
+     */
+    bool backdoorAccess(const RequestPtr &req, uint8_t *data, bool write);
+
+    /**
+     * Looks up the block cache at the current, translated PC. Starts
+     * recording a new block on a miss.
+     *
+     * @return The first entry of the cached block starting at the PC or
+     * nullptr if the instruction must be fetched.
+     */
+    const BasicBlockCache::Entry *enterBlock(SimpleExecContext &t_info);
+
+    /** Drops the cached blocks if the thread, its decoder context or its
+     * translations changed since they were recorded. */
+    void checkBlockContext(SimpleExecContext &t_info);
+
+    /**
+     * Starts an instruction: counts its cycle and services interrupts,
+     * PC events and instruction count events.
+     *
+     * @return False if a PC event suspended the thread.
+     */
+    bool startInst();
+
+    /**
+     * Executes curStaticInst, if any, and adds its stall time to
+     * latency.
+     *
+     * @param fetch_stall Time spent fetching the instruction.
+     * @return The fault raised by the instruction.
+     */
+    Fault executeInst(SimpleExecContext &t_info, Tick fetch_stall,
+                      Tick &latency);
+
+    /** Ends the current block if needed and moves to the next PC. */
+    void advanceInst(SimpleExecContext &t_info, const Fault &fault);
+
+    /** How a call to replayBlock() returned. */
+    enum class ReplayEnd
+    {
+        /** The next instruction has not been started. */
+        Stopped,
+        /** The next instruction was started but is not in the block,
+         * e.g. because an interrupt was taken. */
+        Started,
+        /** A PC event suspended the thread. */
+        Idle
+    };
+
+    /**
+     * Executes the cached block entered at entry back to back, without
+     * translating or fetching its instructions, until the block ends,
+     * an instruction faults or the tick's width is used up.
+     *
+     * @param i Index of the entry's instruction in the current tick,
+     * advanced past each further instruction executed.
+     * @param latency Stall time of the tick, increased by the
+     * instructions executed.
+     */
+    ReplayEnd replayBlock(SimpleExecContext &t_info,
+                          const BasicBlockCache::Entry *entry, int &i,
+                          Tick &latency);
     virtual Tick fetchInstMem();
 
     /**
@@ -141,7 +278,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +288,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
@@ -344,7 +344,7 @@ BaseSimpleCPU::serviceInstCountEvents()
 }
 
 void
-BaseSimpleCPU::preExecute()
+BaseSimpleCPU::preExecute(const StaticInstPtr &predecoded)
 {
     SimpleExecContext &t_info = *threadInfo[curThread];
     SimpleThread* thread = t_info.thread;
@@ -365,18 +365,20 @@ BaseSimpleCPU::preExecute()
                 pc_state.microPC(), curMacroStaticInst);
     } else if (!curMacroStaticInst) {
         //We're not in the middle of a macro instruction
-        StaticInstPtr instPtr = NULL;
+        StaticInstPtr instPtr = predecoded;
 
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetch_pc =
-            (pc_state.instAddr() & decoder->pcMask()) + t_info.fetchOffset;
+        if (!instPtr) {
+            //Predecode, ie bundle up an ExtMachInst
+            //If more fetch data is needed, pass it in.
+            Addr fetch_pc = (pc_state.instAddr() & decoder->pcMask()) +
+                t_info.fetchOffset;
 
-        decoder->moreBytes(pc_state, fetch_pc);
+            decoder->moreBytes(pc_state, fetch_pc);
 
-        //Decode an instruction if one is ready. Otherwise, we'll have to
-        //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pc_state);
+            //Decode an instruction if one is ready. Otherwise, we'll have
+            //to fetch beyond the MachInst at the current pc.
+            instPtr = decoder->decode(pc_state);
+        }
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pc_state);
@@ -136,7 +136,14 @@ class BaseSimpleCPU : public BaseCPU
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
     void serviceInstCountEvents();
-    void preExecute();
+    /**
+     * Decodes the next instruction and prepares its execution.
+     *
+     * @param predecoded Instruction decoded at the current PC earlier,
+     * in which case the thread's PC must already hold the PC state
+     * produced by that decode and fetching is skipped.
+     */
+    void preExecute(const StaticInstPtr &predecoded = StaticInstPtr());
     void postExecute();
     void advancePC(const Fault &fault);
 
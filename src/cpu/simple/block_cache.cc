@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "cpu/simple/block_cache.hh"
+
+namespace gem5
+{
+
+BasicBlockCache::BasicBlockCache(statistics::Group *parent,
+                                 unsigned max_blocks)
+    : maxBlocks(max_blocks), stats(parent)
+{
+}
+
+const BasicBlockCache::Entry *
+BasicBlockCache::enter(const PCStateBase &pc, Addr paddr)
+{
+    Block *blk = blockMap.lookup(pc.instAddr());
+    if (!blk || blk->paddr != paddr ||
+        !blk->entries.front().fetchPC->equals(pc)) {
+        cur = nullptr;
+        return nullptr;
+    }
+
+    ++stats.blocksEntered;
+    ++stats.replayedInsts;
+    cur = blk;
+    pos = 1;
+    return &blk->entries.front();
+}
+
+void
+BasicBlockCache::begin(const PCStateBase &pc, Addr paddr)
+{
+    if (blocks.size() >= maxBlocks) {
+        clear();
+        ++stats.flushes;
+    }
+
+    building = std::make_unique<Block>();
+    building->vaddr = pc.instAddr();
+    building->paddr = paddr;
+}
+
+void
+BasicBlockCache::record(std::unique_ptr<PCStateBase> fetch_pc,
+                        const StaticInstPtr &inst,
+                        const PCStateBase &decoded_pc)
+{
+    assert(building);
+
+    const Addr addr = fetch_pc->instAddr();
+    if ((!building->entries.empty() && addr != building->nextAddr) ||
+        pageOf(addr) != pageOf(building->vaddr)) {
+        end();
+        return;
+    }
+
+    set(fallThroughPC, decoded_pc);
+    fallThroughPC->advance();
+    building->nextAddr = fallThroughPC->instAddr();
+
+    building->entries.push_back(
+        Entry{inst, std::move(fetch_pc),
+              std::unique_ptr<PCStateBase>(decoded_pc.clone())});
+}
+
+void
+BasicBlockCache::end()
+{
+    std::unique_ptr<Block> blk = std::move(building);
+    if (!blk || blk->entries.empty()) {
+        return;
+    }
+
+    ++stats.blocksRecorded;
+    blockMap.lookup(blk->vaddr) = blk.get();
+    codePages[pageOf(blk->paddr)].push_back(blk.get());
+    blocks.push_back(std::move(blk));
+}
+
+void
+BasicBlockCache::invalidatePages(Addr paddr, unsigned size)
+{
+    const Addr first = pageOf(paddr);
+    const Addr last = pageOf(paddr + (size ? size - 1 : 0));
+    if (building && pageOf(building->paddr) >= first &&
+        pageOf(building->paddr) <= last) {
+        building.reset();
+    }
+
+    for (Addr page = first; page <= last; page++) {
+        auto it = codePages.find(page);
+        if (it == codePages.end()) {
+            continue;
+        }
+
+        for (Block *blk : it->second) {
+            blk->valid = false;
+            Block *&slot = blockMap.lookup(blk->vaddr);
+            if (slot == blk) {
+                slot = nullptr;
+            }
+        }
+        codePages.erase(it);
+        ++stats.invalidations;
+    }
+
+    if (cur && !cur->valid) {
+        cur = nullptr;
+    }
+}
+
+void
+BasicBlockCache::clear()
+{
+    blockMap.clear();
+    codePages.clear();
+    blocks.clear();
+    building.reset();
+    cur = nullptr;
+}
+
+BasicBlockCache::BasicBlockCacheStats::BasicBlockCacheStats(
+        statistics::Group *parent)
+    : statistics::Group(parent, "blockCache"),
+      ADD_STAT(replayedInsts, statistics::units::Count::get(),
+               "Number of instructions replayed from cached blocks"),
+      ADD_STAT(blocksRecorded, statistics::units::Count::get(),
+               "Number of basic blocks recorded"),
+      ADD_STAT(blocksEntered, statistics::units::Count::get(),
+               "Number of times execution entered a cached block"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of code pages invalidated by writes"),
+      ADD_STAT(flushes, statistics::units::Count::get(),
+               "Number of times the cache was flushed for capacity")
+{
+}
+
+} // namespace gem5
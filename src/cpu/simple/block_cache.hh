@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __CPU_SIMPLE_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_BLOCK_CACHE_HH__
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/decode_cache.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+/**
+ * A cache of pre-decoded basic blocks used by the atomic CPU to skip
+ * fetching and decoding instructions it has executed before.
+ *
+ * A block is a run of sequentially fetched instructions within one
+ * 4 KiB page, recorded the first time it executes and ending at a
+ * control instruction. Every entry keeps the PC the instruction was
+ * fetched at and the PC state produced by decoding it, so replaying an
+ * entry is equivalent to fetching and decoding it again as long as the
+ * PC matches, the code at that physical address has not been written,
+ * and neither the thread, its decoder context nor its translations
+ * changed.
+ *
+ * Blocks are found by virtual address through a decode_cache::AddrMap
+ * and checked against the physical address of their first instruction,
+ * which the CPU still translates whenever it enters a block.
+ */
+class BasicBlockCache
+{
+  public:
+    struct Entry
+    {
+        StaticInstPtr inst;
+        /** PC at which the instruction was fetched. */
+        std::unique_ptr<PCStateBase> fetchPC;
+        /** PC state after decoding the instruction. */
+        std::unique_ptr<PCStateBase> decodedPC;
+    };
+
+    /**
+     * @param parent Statistics group the cache statistics belong to.
+     * @param max_blocks Number of blocks recorded before all of them
+     * are dropped.
+     */
+    BasicBlockCache(statistics::Group *parent, unsigned max_blocks);
+
+    ~BasicBlockCache() { blockMap.clear(); }
+
+    /**
+     * Drops all blocks if they were recorded by another thread, or if
+     * the decoder context or the translations of the thread changed
+     * since.
+     *
+     * @param tid The thread about to execute.
+     * @param decoder_generation Context generation of its decoder.
+     * @param mmu_generation Translation generation of its MMU.
+     */
+    void
+    checkContext(ThreadID tid, uint64_t decoder_generation,
+                 uint64_t mmu_generation)
+    {
+        if (tid != contextThread ||
+            decoder_generation != contextGeneration ||
+            mmu_generation != translationGeneration) {
+            clear();
+            contextThread = tid;
+            contextGeneration = decoder_generation;
+            translationGeneration = mmu_generation;
+        }
+    }
+
+    /**
+     * Follows the current block.
+     *
+     * @return The next entry of the current block if it was fetched at
+     * pc, nullptr otherwise, in which case the current block is left.
+     */
+    const Entry *
+    next(const PCStateBase &pc)
+    {
+        if (cur && pos < cur->entries.size() &&
+            cur->entries[pos].fetchPC->equals(pc)) {
+            ++stats.replayedInsts;
+            return &cur->entries[pos++];
+        }
+        cur = nullptr;
+        return nullptr;
+    }
+
+    /**
+     * Enters the block starting at pc, if any.
+     *
+     * @param paddr Physical address pc translates to.
+     * @return The first entry of the block or nullptr on a miss.
+     */
+    const Entry *enter(const PCStateBase &pc, Addr paddr);
+
+    /** Returns whether the current block has entries left. */
+    bool
+    replaying() const
+    {
+        return cur && pos < cur->entries.size();
+    }
+
+    /** Leaves the current block. */
+    void leave() { cur = nullptr; }
+
+    /** Starts recording a block at pc. */
+    void begin(const PCStateBase &pc, Addr paddr);
+
+    /** Returns whether a block is being recorded. */
+    bool recording() const { return building != nullptr; }
+
+    /**
+     * Appends a decoded instruction to the block being recorded. The
+     * block ends instead if the instruction does not follow the last
+     * one, e.g. after an interrupt, or lies on a different page.
+     *
+     * @param fetch_pc PC the instruction was fetched at.
+     * @param inst The decoded (macro) instruction.
+     * @param decoded_pc PC state after decoding the instruction.
+     */
+    void record(std::unique_ptr<PCStateBase> fetch_pc,
+                const StaticInstPtr &inst, const PCStateBase &decoded_pc);
+
+    /** Ends the block being recorded and makes it available. */
+    void end();
+
+    /** Drops the blocks holding code in the given physical range. */
+    void
+    invalidate(Addr paddr, unsigned size)
+    {
+        if (!codePages.empty() || building) {
+            invalidatePages(paddr, size);
+        }
+    }
+
+    /** Drops all blocks. */
+    void clear();
+
+  private:
+    static constexpr unsigned PageShift = 12;
+
+    static Addr pageOf(Addr addr) { return addr >> PageShift; }
+
+    struct Block
+    {
+        Addr vaddr;
+        Addr paddr;
+        /** Address of the instruction following the last entry. */
+        Addr nextAddr;
+        bool valid = true;
+        std::vector<Entry> entries;
+    };
+
+    void invalidatePages(Addr paddr, unsigned size);
+
+    const unsigned maxBlocks;
+
+    /** Blocks by the virtual address of their first instruction. */
+    decode_cache::AddrMap<Block *> blockMap;
+
+    /** Storage of all recorded blocks, including invalidated ones. */
+    std::vector<std::unique_ptr<Block>> blocks;
+
+    /** Blocks recorded from each physical page. */
+    std::unordered_map<Addr, std::vector<Block *>> codePages;
+
+    /** Block being replayed and the index of its next entry. */
+    Block *cur = nullptr;
+    size_t pos = 0;
+
+    /** Block being recorded. */
+    std::unique_ptr<Block> building;
+
+    /** Scratch PC used to find the fall-through of an instruction. */
+    std::unique_ptr<PCStateBase> fallThroughPC;
+
+    ThreadID contextThread = 0;
+    uint64_t contextGeneration = 0;
+    uint64_t translationGeneration = 0;
+
+    struct BasicBlockCacheStats : public statistics::Group
+    {
+        BasicBlockCacheStats(statistics::Group *parent);
+
+        statistics::Scalar replayedInsts;
+        statistics::Scalar blocksRecorded;
+        statistics::Scalar blocksEntered;
+        statistics::Scalar invalidations;
+        statistics::Scalar flushes;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_BLOCK_CACHE_HH__
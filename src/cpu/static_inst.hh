@@ -351,6 +351,20 @@ class StaticInst : public RefCounted, public StaticInstFlags
     virtual std::unique_ptr<PCStateBase> branchTarget(
             ThreadContext *tc) const;
 
+    /**
+     * Return whether this instruction does nothing but copy a source
+     * register, unmodified, to its only destination register. A CPU may
+     * then eliminate it by mapping the destination onto the source.
+     * @param src_idx Set to the index of the copied source register.
+     */
+    virtual bool isRegMove(int &src_idx) const { return false; }
+
+    /**
+     * Return whether this instruction always writes zero to its only
+     * destination register, whatever the values of its sources.
+     */
+    virtual bool isZeroIdiom() const { return false; }
+
     /**
      * Return string representation of disassembled instruction.
      * The default version of this function will call the internal
@@ -53,6 +53,7 @@ namespace prefetch
 FetchDirectedPrefetcher::FetchDirectedPrefetcher(
     const FetchDirectedPrefetcherParams &p)
     : Base(p),
+      ppInstPrefetch(nullptr),
       cpu(p.cpu),
       cache(nullptr),
       markReqAsPrefetch(p.mark_req_as_prefetch),
@@ -73,19 +74,18 @@ FetchDirectedPrefetcher::notifyFTQInsert(const o3::FetchTargetPtr &ft)
     for (Addr blk_addr = start_blk_addr; blk_addr <= end_blk_addr;
          blk_addr += blkSize) {
 
-        // Check if the address is already in the prefetch queue
-        auto it = std::find(pfq.begin(), pfq.end(), blk_addr);
-        if (it != pfq.end()) {
-            DPRINTF(HWPrefetch, "%#x already in prefetch_queue\n", blk_addr);
-            stats.pfInPFQ++;
-            continue;
-        }
-
-        it = std::find(translationq.begin(), translationq.end(), blk_addr);
-        if (it != translationq.end()) {
-            DPRINTF(HWPrefetch, "%#x already in translation queue\n",
-                    blk_addr);
-            stats.pfInTQ++;
+        // Check if the address is already in one of the queues
+        auto idx = addrIndex.find(blk_addr);
+        if (idx != addrIndex.end()) {
+            if (idx->second->inPFQ) {
+                DPRINTF(HWPrefetch, "%#x already in prefetch_queue\n",
+                        blk_addr);
+                stats.pfInPFQ++;
+            } else {
+                DPRINTF(HWPrefetch, "%#x already in translation queue\n",
+                        blk_addr);
+                stats.pfInTQ++;
+            }
             continue;
         }
 
@@ -97,23 +97,136 @@ FetchDirectedPrefetcher::notifyFTQInsert(const o3::FetchTargetPtr &ft)
             stats.tqDrops++;
             continue;
         }
-        // TODO add also check for pfq to save unnecessary translations
-        // Maybe merge the two queues
-        translationq.emplace_back(*this, blk_addr, ft->getTid(), ft->ftNum());
+        auto it = translationq.emplace(translationq.end(), *this, blk_addr,
+                                       ft);
+        addrIndex.emplace(blk_addr, it);
+        ftIndex.emplace(it->ftn, it);
         DPRINTF(HWPrefetch, "Start translation for %#x, reqID=%i, ctxID=%i\n",
-                blk_addr, translationq.back().req->requestorId(),
-                translationq.back().req->contextId());
-        translationq.back().startTranslation();
+                blk_addr, it->req->requestorId(), it->req->contextId());
         stats.tqInserts++;
         stats.tqSizeDistAtNotify.sample(translationq.size());
         stats.pfqSizeDistAtNotify.sample(pfq.size());
+        translate(it);
+    }
+}
+
+void
+FetchDirectedPrefetcher::translate(RequestIt it)
+{
+    const Addr vpage = pageAddress(it->addr);
+    auto batch = pageBatches.find(vpage);
+
+    if (batch != pageBatches.end() &&
+        batch->second.contextId == it->req->contextId()) {
+        // The page is already being translated. Reuse its result.
+        DPRINTF(HWPrefetch, "%#x waits for translation of page %#x\n",
+                it->addr, vpage);
+        batch->second.followers.push_back(it);
+        stats.translationsSaved++;
+        return;
+    }
+
+    if (batch == pageBatches.end()) {
+        pageBatches.emplace(vpage,
+                            PageBatch{it->req->contextId(), {}});
+        it->leader = true;
+    }
+    stats.translationsIssued++;
+    // May complete immediately, so this must be the last use of `it`.
+    it->startTranslation();
+}
+
+void
+FetchDirectedPrefetcher::unindexFT(RequestIt it)
+{
+    auto range = ftIndex.equal_range(it->ftn);
+    for (auto idx = range.first; idx != range.second; ++idx) {
+        if (idx->second == it) {
+            ftIndex.erase(idx);
+            return;
+        }
+    }
+}
+
+void
+FetchDirectedPrefetcher::eraseRequest(RequestIt it)
+{
+    unindexFT(it);
+    addrIndex.erase(it->addr);
+    if (it->inPFQ) {
+        pfq.erase(it);
+    } else {
+        translationq.erase(it);
+    }
+}
+
+void
+FetchDirectedPrefetcher::recordTimeliness(const o3::FetchTargetPtr &ft)
+{
+    if (ft->prefetched() != MaxTick) {
+        // At least one prefetch left before fetch needed the block.
+        stats.ftPrefetchTimely++;
+        stats.prefetchToFetch.sample(
+            ticksToCycles(ft->fetched() - ft->prefetched()));
+        return;
+    }
+
+    // Prefetches still queued when fetch arrives are late.
+    if (ftIndex.count(ft->ftNum())) {
+        stats.ftPrefetchLate++;
+    }
+}
+
+void
+FetchDirectedPrefetcher::notifyDemandFetch(const CacheAccessProbeArg &acc,
+                                           bool miss)
+{
+    const PacketPtr pkt = acc.pkt;
+    if (!pkt->req->isInstFetch() || pkt->cmd.isHWPrefetch() ||
+            pkt->req->requestorId() == requestorId) {
+        return;
+    }
+
+    const Addr blk_addr = blockAddress(pkt->getAddr());
+    if (miss) {
+        if (pendingFills.erase(blk_addr))
+            stats.pfLateFetch++;
+    } else if (acc.cache.hasBeenPrefetched(pkt->getAddr(), pkt->isSecure(),
+                                           requestorId)) {
+        stats.pfUsefulFetch++;
     }
 }
 
+void
+FetchDirectedPrefetcher::notifyFill(const CacheAccessProbeArg &acc)
+{
+    pendingFills.erase(blockAddress(acc.pkt->getAddr()));
+}
+
 void
 FetchDirectedPrefetcher::notifyFTQRemove(const o3::FetchTargetPtr &ft)
 {
+    // Fetch targets that are squashed never got fetched.
+    if (ft->fetched() != MaxTick) {
+        recordTimeliness(ft);
+    }
+
+    // Fetch no longer waits for the blocks of this fetch target.
+    auto fills = ftPendingFills.equal_range(ft->ftNum());
+    for (auto fill = fills.first; fill != fills.second; ++fill) {
+        auto pending = pendingFills.find(fill->second);
+        if (pending != pendingFills.end() &&
+                pending->second == ft->ftNum()) {
+            pendingFills.erase(pending);
+        }
+    }
+    ftPendingFills.erase(fills.first, fills.second);
+
     if (!squashPrefetches) {
+        // The requests still go ahead, but no longer belong to a fetch
+        // target in the FTQ.
+        auto range = ftIndex.equal_range(ft->ftNum());
+        ftIndex.erase(range.first, range.second);
         return;
     }
 
@@ -122,45 +235,72 @@ FetchDirectedPrefetcher::notifyFTQRemove(const o3::FetchTargetPtr &ft)
     // the `pfq` when translation is complete. We cannot simply remove
     // them from the `translationq` as the asynchronous
     // `translationComplete` callback assumes the `translationq` still
-    // contains the entry.
-    for (auto &pr : translationq) {
-        if (pr.ftn == ft->ftNum()) {
-            pr.markCanceled();
-            stats.pfSquashed++;
-        }
+    // contains the entry. Remove any existing prefetch requests that
+    // belong to this fetch target.
+    auto range = ftIndex.equal_range(ft->ftNum());
+    std::vector<RequestIt> requests;
+    for (auto idx = range.first; idx != range.second; ++idx) {
+        requests.push_back(idx->second);
     }
+    ftIndex.erase(range.first, range.second);
 
-    // Remove any existing prefetch requests that belong to this fetch
-    // target.
-    auto it = pfq.begin();
-    while (it != pfq.end()) {
-        if (it->ftn == ft->ftNum()) {
+    for (auto it : requests) {
+        if (it->inPFQ) {
             // Delete packet: created but never sent to the cache.
             if (it->pkt != nullptr) {
                 delete it->pkt;
             }
-            it = pfq.erase(it);
-            stats.pfSquashed++;
+            addrIndex.erase(it->addr);
+            pfq.erase(it);
         } else {
-            ++it;
+            it->markCanceled();
         }
+        stats.pfSquashed++;
     }
 }
 
 void
-FetchDirectedPrefetcher::translationComplete(PrefetchRequest *pfr, bool failed)
+FetchDirectedPrefetcher::translationFinished(PrefetchRequest *pfr,
+                                             bool failed)
 {
-    auto it = translationq.begin();
-    while (it != translationq.end()) {
-        if (&(*it) == pfr) {
-            break;
+    std::vector<RequestIt> followers;
+    Addr paddr_page = 0;
+    Request::Flags flags = 0;
+
+    if (pfr->leader) {
+        auto batch = pageBatches.find(pageAddress(pfr->addr));
+        assert(batch != pageBatches.end());
+        followers = std::move(batch->second.followers);
+        pageBatches.erase(batch);
+
+        if (!failed) {
+            paddr_page = pfr->req->getPaddr() - pageOffset(pfr->addr);
+            flags = pfr->req->getFlags();
         }
-        ++it;
     }
-    assert(it != translationq.end());
+
+    translationComplete(pfr, failed);
+
+    // All blocks of the page share the translation of the leader.
+    for (auto it : followers) {
+        if (!failed) {
+            it->req->setPaddr(paddr_page + pageOffset(it->addr));
+            it->req->setFlags(flags);
+        }
+        translationComplete(&*it, failed);
+    }
+}
+
+void
+FetchDirectedPrefetcher::translationComplete(PrefetchRequest *pfr, bool failed)
+{
+    auto idx = addrIndex.find(pfr->addr);
+    assert(idx != addrIndex.end() && &*idx->second == pfr);
+    auto it = idx->second;
     warn_if_once(cacheSnoop && (cache == nullptr),
                  "Cache is not set. Cache snooping will not work!\n");
 
+    bool queued = false;
     if (failed) {
         DPRINTF(HWPrefetch, "Translation of %#x failed\n", it->addr);
         stats.translationFail++;
@@ -191,7 +331,9 @@ FetchDirectedPrefetcher::translationComplete(PrefetchRequest *pfr, bool failed)
                         it->addr, it->pkt->getAddr(), pfq.size());
 
                 stats.pfCandidatesAdded++;
-                pfq.push_back(*it);
+                it->inPFQ = true;
+                pfq.splice(pfq.end(), translationq, it);
+                queued = true;
                 stats.pfqInserts++;
             } else {
                 DPRINTF(HWPrefetch, "Prefetch queue full, dropping %#x\n",
@@ -200,7 +342,9 @@ FetchDirectedPrefetcher::translationComplete(PrefetchRequest *pfr, bool failed)
             }
         }
     }
-    translationq.erase(it);
+    if (!queued) {
+        eraseRequest(it);
+    }
     stats.tqPops++;
 }
 
@@ -212,10 +356,28 @@ FetchDirectedPrefetcher::getPacket()
     }
     PacketPtr pkt = pfq.front().pkt;
 
+    if (auto ft = pfq.front().ft.lock()) {
+        if (ft->prefetched() == MaxTick) {
+            stats.createToPrefetch.sample(
+                ticksToCycles(curTick() - ft->created()));
+        }
+        ft->markPrefetched(curTick());
+    }
+
     DPRINTF(HWPrefetch, "Issue Prefetch to: pkt:%#x, PC:%#x, PFQ size:%i\n",
             pkt->getAddr(), pfq.front().addr, pfq.size());
 
-    pfq.pop_front();
+    ppInstPrefetch->notify(pfq.front().addr);
+    // Track the fill while its fetch target is in the FTQ. Removing the
+    // fetch target stops the tracking, so prefetches the cache drops
+    // never pile up.
+    const o3::FTSeqNum ftn = pfq.front().ftn;
+    if (ftIndex.count(ftn)) {
+        const Addr blk_addr = blockAddress(pkt->getAddr());
+        pendingFills[blk_addr] = ftn;
+        ftPendingFills.emplace(ftn, blk_addr);
+    }
+    eraseRequest(pfq.begin());
     stats.pfqPops++;
 
     prefetchStats.pfIssued++;
@@ -223,19 +385,23 @@ FetchDirectedPrefetcher::getPacket()
 }
 
 FetchDirectedPrefetcher::PrefetchRequest::PrefetchRequest(
-    FetchDirectedPrefetcher &_owner, uint64_t _addr, ThreadID tid,
-    o3::FTSeqNum _ftn)
+    FetchDirectedPrefetcher &_owner, uint64_t _addr,
+    const o3::FetchTargetPtr &_ft)
     : owner(_owner),
       addr(_addr),
-      ftn(_ftn),
+      ftn(_ft->ftNum()),
+      ft(_ft),
       req(nullptr),
       pkt(nullptr),
       readyTime(MaxTick),
-      canceled(false)
+      canceled(false),
+      inPFQ(false),
+      leader(false)
 {
     req = std::make_shared<Request>(addr, owner.blkSize, Request::INST_FETCH,
                                     owner.requestorId, addr,
-                                    owner.cpu->getContext(tid)->contextId());
+                                    owner.cpu->getContext(_ft->getTid())
+                                        ->contextId());
     if (owner.markReqAsPrefetch) {
         req->setFlags(Request::PREFETCH);
     }
@@ -265,7 +431,16 @@ FetchDirectedPrefetcher::PrefetchRequest::finish(const Fault &fault,
                                                  BaseMMU::Mode mode)
 {
     bool failed = (fault != NoFault);
-    owner.translationComplete(this, failed);
+    owner.translationFinished(this, failed);
+}
+
+void
+FetchDirectedPrefetcher::regProbePoints()
+{
+    Base::regProbePoints();
+
+    ppInstPrefetch = new ProbePointArg<Addr>(getProbeManager(),
+                                             "InstPrefetch");
 }
 
 void
@@ -273,6 +448,16 @@ FetchDirectedPrefetcher::regProbeListeners()
 {
     Base::regProbeListeners();
 
+    if (probeManager) {
+        typedef ProbeListenerArgFunc<CacheAccessProbeArg> AccessListener;
+        listeners.push_back(probeManager->connect<AccessListener>("Hit",
+            [this](const CacheAccessProbeArg &acc)
+            { notifyDemandFetch(acc, false); }));
+        listeners.push_back(probeManager->connect<AccessListener>("Miss",
+            [this](const CacheAccessProbeArg &acc)
+            { notifyDemandFetch(acc, true); }));
+    }
+
     if (cpu == nullptr) {
         warn("FetchDirectedPrefetcher: No CPU to listen from registered\n");
         return;
@@ -312,6 +497,11 @@ FetchDirectedPrefetcher::Stats::Stats(statistics::Group *parent, int pfq_size,
                "Number of prefetches that failed translation"),
       ADD_STAT(translationSuccess, statistics::units::Count::get(),
                "Number of prefetches that succeeded translation"),
+      ADD_STAT(translationsIssued, statistics::units::Count::get(),
+               "Number of page translations sent to the MMU"),
+      ADD_STAT(translationsSaved, statistics::units::Count::get(),
+               "Number of prefetches that reused the pending translation of "
+               "another prefetch to the same page"),
       ADD_STAT(pfqSizeDistAtNotify, statistics::units::Count::get(),
                "Distribution of the prefetch queue size at the time of "
                "notification of a new fetch target"),
@@ -329,10 +519,30 @@ FetchDirectedPrefetcher::Stats::Stats(statistics::Group *parent, int pfq_size,
       ADD_STAT(tqPops, statistics::units::Count::get(),
                "Number of uses into the prefetch translation queue"),
       ADD_STAT(tqDrops, statistics::units::Count::get(),
-               "Number of drops into the prefetch translation queue")
+               "Number of drops into the prefetch translation queue"),
+      ADD_STAT(ftPrefetchTimely, statistics::units::Count::get(),
+               "Number of fetched fetch targets whose prefetch was issued "
+               "before fetch reached them"),
+      ADD_STAT(ftPrefetchLate, statistics::units::Count::get(),
+               "Number of fetched fetch targets whose prefetch was still "
+               "queued when fetch reached them"),
+      ADD_STAT(pfUsefulFetch, statistics::units::Count::get(),
+               "Number of demand instruction fetches that hit a block "
+               "brought in by this prefetcher"),
+      ADD_STAT(pfLateFetch, statistics::units::Count::get(),
+               "Number of demand instruction fetches that missed on a block "
+               "this prefetcher was still fetching"),
+      ADD_STAT(createToPrefetch, statistics::units::Cycle::get(),
+               "Distribution of the cycles between creating a fetch target "
+               "and issuing its first prefetch"),
+      ADD_STAT(prefetchToFetch, statistics::units::Cycle::get(),
+               "Distribution of the cycles between issuing the first "
+               "prefetch of a fetch target and fetch consuming it")
 {
     pfqSizeDistAtNotify.init(0, pfq_size, 4);
     tqSizeDistAtNotify.init(0, tq_size, 4);
+    createToPrefetch.init(0, 256, 8).flags(statistics::nozero);
+    prefetchToFetch.init(0, 256, 8).flags(statistics::nozero);
 }
 
 } // namespace prefetch
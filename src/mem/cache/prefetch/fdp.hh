@@ -44,12 +44,16 @@
 #define __MEM_CACHE_PREFETCH_FDP_HH__
 
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "cpu/base.hh"
 #include "cpu/o3/ftq.hh"
 #include "mem/cache/base.hh"
 #include "mem/cache/prefetch/base.hh"
+#include "sim/probe/probe.hh"
 
 namespace gem5
 {
@@ -67,6 +71,7 @@ class FetchDirectedPrefetcher : public Base
     ~FetchDirectedPrefetcher() = default;
 
     /** Base class overrides */
+    void regProbePoints() override;
     void regProbeListeners() override;
     void
     setCache(BaseCache *_cache)
@@ -87,10 +92,17 @@ class FetchDirectedPrefetcher : public Base
     void notify(const CacheAccessProbeArg &acc,
                 const PrefetchInfo &pfi) override {};
 
+    /** A block was filled, possibly completing one of our prefetches. */
+    void notifyFill(const CacheAccessProbeArg &acc) override;
+
   private:
     /** Array of probe listeners */
     std::vector<ProbeListenerPtr<>> listeners;
 
+    /** Probe point notified with the virtual address of every issued
+     * instruction prefetch. */
+    ProbePointArg<Addr> *ppInstPrefetch;
+
     /** Pointer to the CPU object that contains the FTQ */
     BaseCPU *cpu;
 
@@ -119,7 +131,7 @@ class FetchDirectedPrefetcher : public Base
     struct PrefetchRequest : public BaseMMU::Translation
     {
         PrefetchRequest(FetchDirectedPrefetcher &_owner, uint64_t _addr,
-                        ThreadID tid, o3::FTSeqNum ftn);
+                        const o3::FetchTargetPtr &ft);
 
         /** Owner of the packet */
         FetchDirectedPrefetcher &owner;
@@ -130,6 +142,10 @@ class FetchDirectedPrefetcher : public Base
         /** The fetch target number that created this request */
         const o3::FTSeqNum ftn;
 
+        /** The fetch target itself, to timestamp the prefetch issue. Does
+         * not keep a squashed fetch target alive. */
+        std::weak_ptr<o3::FetchTarget> ft;
+
         /** The request and packet that will be sent to the cache. */
         RequestPtr req;
         PacketPtr pkt;
@@ -142,6 +158,14 @@ class FetchDirectedPrefetcher : public Base
          * proceed to the prefetch queue. */
         bool canceled;
 
+        /** Whether the request has moved from the translation queue to
+         * the prefetch queue. */
+        bool inPFQ;
+
+        /** Whether this request translates the page on behalf of the
+         * other pending requests to the same page. */
+        bool leader;
+
         bool
         operator==(const int &a) const
         {
@@ -178,6 +202,42 @@ class FetchDirectedPrefetcher : public Base
     std::list<PrefetchRequest> pfq;
     std::list<PrefetchRequest> translationq;
 
+    /** Requests move between the queues by splicing, so an iterator stays
+     * valid for the whole life of a request. */
+    using RequestIt = std::list<PrefetchRequest>::iterator;
+
+    /** Index of all requests in either queue by block address. Used to
+     * filter redundant prefetches without scanning the queues. */
+    std::unordered_map<Addr, RequestIt> addrIndex;
+
+    /** Index of the live requests by the fetch target that created them.
+     * Canceled translations are removed from it. */
+    std::unordered_multimap<o3::FTSeqNum, RequestIt> ftIndex;
+
+    /** A page translation in flight and the requests waiting for it. */
+    struct PageBatch
+    {
+        ContextID contextId;
+        std::vector<RequestIt> followers;
+    };
+
+    /** Pending page translations by virtual page address. */
+    std::unordered_map<Addr, PageBatch> pageBatches;
+
+    /** Translates a new request, or attaches it to a translation in
+     * flight for the same page. */
+    void translate(RequestIt it);
+
+    /** Removes a request from its queue and from the indices. */
+    void eraseRequest(RequestIt it);
+
+    /** Removes a request from the fetch target index. */
+    void unindexFT(RequestIt it);
+
+    /** A translation issued to the MMU has completed. Completes the
+     * request and all requests batched with it. */
+    void translationFinished(PrefetchRequest *pf_req, const bool failed);
+
     /** Notifies the prefetcher that a new fetch target was
      * inserted into the FTQ. */
     void notifyFTQInsert(const o3::FetchTargetPtr &ft);
@@ -186,6 +246,23 @@ class FetchDirectedPrefetcher : public Base
      * removed from the FTQ */
     void notifyFTQRemove(const o3::FetchTargetPtr &ft);
 
+    /** Classifies the prefetches of a fetch target that fetch consumed
+     * as timely or late. */
+    void recordTimeliness(const o3::FetchTargetPtr &ft);
+
+    /** Classifies a demand instruction fetch seen by the cache. A hit on
+     * a block this prefetcher brought in makes the prefetch useful, a
+     * miss on a block it is still prefetching makes it late. */
+    void notifyDemandFetch(const CacheAccessProbeArg &acc, bool miss);
+
+    /** Blocks of issued prefetches that have not been filled yet, with
+     * the fetch target the prefetch was issued for. Tracking stops when
+     * that fetch target leaves the FTQ. */
+    std::unordered_map<Addr, o3::FTSeqNum> pendingFills;
+
+    /** The blocks each fetch target in the FTQ added to pendingFills. */
+    std::unordered_multimap<o3::FTSeqNum, Addr> ftPendingFills;
+
     /** A translation has completed and can now be added to the PFQ. */
     void translationComplete(PrefetchRequest *pf_req, const bool failed);
 
@@ -206,6 +283,8 @@ class FetchDirectedPrefetcher : public Base
 
         statistics::Scalar translationFail;
         statistics::Scalar translationSuccess;
+        statistics::Scalar translationsIssued;
+        statistics::Scalar translationsSaved;
 
         statistics::Distribution pfqSizeDistAtNotify;
         statistics::Distribution tqSizeDistAtNotify;
@@ -215,6 +294,13 @@ class FetchDirectedPrefetcher : public Base
         statistics::Scalar tqInserts;
         statistics::Scalar tqPops;
         statistics::Scalar tqDrops;
+
+        statistics::Scalar ftPrefetchTimely;
+        statistics::Scalar ftPrefetchLate;
+        statistics::Scalar pfUsefulFetch;
+        statistics::Scalar pfLateFetch;
+        statistics::Distribution createToPrefetch;
+        statistics::Distribution prefetchToFetch;
     } stats;
 };
 
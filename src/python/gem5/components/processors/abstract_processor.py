@@ -33,6 +33,7 @@ from typing import (
     Optional,
 )
 
+import m5
 from m5.objects import (
     Root,
     SubSystem,
@@ -60,6 +61,9 @@ class AbstractProcessor(SubSystem):
         """
         super().__init__()
 
+        self._parallel_fast_forward = False
+        self._parallel_quantum = None
+
         if cores:
             # In the stdlib we assume the system processor conforms to a single
             # ISA target.
@@ -95,6 +99,38 @@ class AbstractProcessor(SubSystem):
         """Called to set up anything needed after ``m5.instantiate``."""
         pass
 
+    def enable_parallel_fast_forward(
+        self, quantum: Optional[int] = None, deterministic: bool = False
+    ) -> None:
+        """Simulate the atomic cores of this processor in parallel.
+
+        Each atomic core gets its own event queue and the event queues run
+        on separate host threads, synchronizing every ``quantum`` ticks
+        (``Root.sim_quantum``). Devices and the memory system stay on event
+        queue 0. Cores migrate to it for memory accesses not served through
+        a memory backdoor and for page table walks, so most work runs in
+        parallel without caches between the cores and memory and with
+        ``backdoorAccesses`` enabled on the cores.
+
+        How accesses of different cores interleave within a quantum
+        depends on host scheduling, so parallel runs are not reproducible,
+        and scheduled exits may be delayed by up to one quantum.
+        With ``deterministic=True`` the cores stay on a single event queue
+        and are simulated serially, which makes runs reproducible.
+
+        :param quantum: Synchronization quantum in ticks. Defaults to 1us.
+        :param deterministic: Keep simulating the cores serially.
+        """
+        self._parallel_fast_forward = not deterministic
+        # Converting a time to ticks needs the global frequency, which is
+        # only fixed in _pre_instantiate.
+        self._parallel_quantum = quantum
+
+    def _get_parallel_cores(self) -> List[AbstractCore]:
+        """Returns the cores which may be placed on their own event queue
+        by ``enable_parallel_fast_forward``."""
+        return self.get_cores()
+
     def _pre_instantiate(self, root: Root) -> None:
         """Called in the `AbstractBoard`'s `_pre_instantiate` method. This is
         called after `connect_things`, after the creation of the root object
@@ -102,7 +138,29 @@ class AbstractProcessor(SubSystem):
 
         Subclasses should override this method to set up any connections.
         """
-        pass
+        if not self._parallel_fast_forward:
+            return
+
+        from m5.objects import BaseAtomicSimpleCPU
+
+        atomic_cpus = [
+            core.get_simobject()
+            for core in self._get_parallel_cores()
+            if isinstance(core.get_simobject(), BaseAtomicSimpleCPU)
+        ]
+        if len(atomic_cpus) < 2:
+            return
+
+        for i, cpu in enumerate(atomic_cpus):
+            for obj in cpu.descendants():
+                obj.eventq_index = 0
+            cpu.eventq_index = i + 1
+
+        m5.ticks.fixGlobalFrequency()
+        if self._parallel_quantum is None:
+            root.sim_quantum = m5.ticks.fromSeconds(1e-6)
+        else:
+            root.sim_quantum = self._parallel_quantum
 
     def switch(self) -> None:
         """Switch the processor to a different core type.
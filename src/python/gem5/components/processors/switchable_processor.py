@@ -118,6 +118,10 @@ class SwitchableProcessor(AbstractProcessor):
         for core_list in self._switchable_cores.values():
             yield from core_list
 
+    @overrides(AbstractProcessor)
+    def _get_parallel_cores(self) -> List[AbstractCore]:
+        return list(self._all_cores())
+
     def switch_to_processor(self, switchable_core_key: str):
         # Run various checks.
         if not hasattr(self, "_board"):
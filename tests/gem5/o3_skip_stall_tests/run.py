@@ -0,0 +1,181 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Simulates two identical systems with an O3 CPU, one of which skips the
+cycles in which only a stalled front-end is active, and checks that both
+end up with the same statistics.
+"""
+
+import argparse
+import os
+import re
+
+import m5
+from m5.objects import *
+
+valid_cpu = {
+    "X86DerivO3CPU": X86O3CPU,
+    "ArmDerivO3CPU": ArmO3CPU,
+    "RiscvDerivO3CPU": RiscvO3CPU,
+}
+
+# Stats that only exist to count the skipping itself.
+ignored_stats = ("stallSkips", "skippedStallCycles")
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", type=str)
+parser.add_argument("--cpu", choices=valid_cpu.keys())
+parser.add_argument(
+    "--decoupled",
+    action="store_true",
+    help="Use the decoupled front-end with an adaptive FTQ depth",
+)
+
+args = parser.parse_args()
+
+
+def make_system(skip):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = "1GHz"
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = "timing"
+    system.mem_ranges = [AddrRange("512MiB")]
+
+    system.cpu = valid_cpu[args.cpu]()
+    system.cpu.skipStalledCycles = skip
+
+    if args.decoupled:
+        system.cpu.branchPred = BranchPredictor(
+            instShiftAmt=(
+                2 if "Arm" in args.cpu else 1 if "Riscv" in args.cpu else 0
+            ),
+            conditionalBranchPred=TAGE_SC_L_64KB(),
+            requiresBTBHit=True,
+            takenOnlyHistory=True,
+        )
+        system.cpu.decoupledFrontEnd = True
+        system.cpu.fetchBufferSize = 16
+        system.cpu.fetchTargetWidth = 32
+        system.cpu.ftqAdaptiveDepth = True
+        # Short epochs so that skips have to stop at depth updates.
+        system.cpu.ftqDepthEpoch = 64
+        system.cpu.minInstSize = (
+            4 if "Arm" in args.cpu else 2 if "Riscv" in args.cpu else 1
+        )
+
+    # Small caches in front of DRAM to get long memory stalls.
+    system.cpu.l1i = Cache(
+        size="4KiB",
+        assoc=2,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=4,
+        tgts_per_mshr=8,
+    )
+    system.cpu.l1d = Cache(
+        size="4KiB",
+        assoc=2,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=4,
+        tgts_per_mshr=8,
+    )
+    system.membus = SystemXBar()
+    system.cpu.l1i.cpu_side = system.cpu.icache_port
+    system.cpu.l1d.cpu_side = system.cpu.dcache_port
+    system.cpu.l1i.mem_side = system.membus.cpu_side_ports
+    system.cpu.l1d.mem_side = system.membus.cpu_side_ports
+
+    system.cpu.createInterruptController()
+    if args.cpu == "X86DerivO3CPU":
+        system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+        system.cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+        system.cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+    system.mem_ctrl = MemCtrl(dram=DDR3_1600_8x8())
+    system.mem_ctrl.dram.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.mem_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    return system
+
+
+root = Root(full_system=False)
+root.skip = make_system(True)
+root.base = make_system(False)
+
+m5.instantiate()
+
+# The simulation exits once the threads of both systems have exited.
+exit_event = m5.simulate()
+if exit_event.getCause() != "exiting with last active thread context":
+    print(f"Unexpected exit: {exit_event.getCause()}")
+    exit(1)
+
+m5.stats.dump()
+
+
+def read_stats(prefix):
+    stats = {}
+    stat_re = re.compile(rf"^{prefix}\.(\S+)\s+(.*?)\s*(#.*)?$")
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+        for line in f:
+            match = stat_re.match(line)
+            if match and not match.group(1).endswith(ignored_stats):
+                stats[match.group(1)] = match.group(2).split()
+    return stats
+
+
+skip_stats = read_stats("skip")
+base_stats = read_stats("base")
+
+mismatches = [
+    name
+    for name in sorted(skip_stats.keys() | base_stats.keys())
+    if skip_stats.get(name) != base_stats.get(name)
+]
+for name in mismatches:
+    print(
+        f"Mismatch {name}: skip {skip_stats.get(name)} "
+        f"base {base_stats.get(name)}"
+    )
+
+if mismatches or not base_stats:
+    exit(1)
+
+print(f"All {len(base_stats)} stats match")
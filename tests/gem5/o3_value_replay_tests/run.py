@@ -0,0 +1,177 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Simulates two identical systems with an O3 CPU that predicts load values,
+one recovering from value mispredictions by squashing and one by
+selectively replaying the dependents of the load. Both have to commit the
+same instructions, and the replaying system has to recover at least one
+misprediction by replay.
+
+Instructions must not issue before the replays recomputing their operands
+complete; the IQ asserts this at issue, so a debug or opt build fails this
+test if a consumer, for instance one still in the skid buffer when the
+replay started, is not held back.
+"""
+
+import argparse
+import os
+import re
+
+import m5
+from m5.objects import *
+
+valid_cpu = {
+    "X86DerivO3CPU": X86O3CPU,
+    "ArmDerivO3CPU": ArmO3CPU,
+    "RiscvDerivO3CPU": RiscvO3CPU,
+}
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", type=str)
+parser.add_argument("--cpu", choices=valid_cpu.keys())
+
+args = parser.parse_args()
+
+
+def make_system(replay):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = "1GHz"
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = "timing"
+    system.mem_ranges = [AddrRange("512MiB")]
+
+    system.cpu = valid_cpu[args.cpu]()
+    # A low confidence threshold makes mispredictions frequent.
+    system.cpu.loadValuePredictor = LoadValuePredictor(
+        enabled=True,
+        mode="Stride",
+        confidenceBits=2,
+        confidenceThreshold=1,
+        selectiveReplay=replay,
+    )
+
+    # Small caches in front of DRAM, so that loads stay in flight long
+    # enough for their predicted values to be consumed.
+    system.cpu.l1i = Cache(
+        size="4KiB",
+        assoc=2,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=4,
+        tgts_per_mshr=8,
+    )
+    system.cpu.l1d = Cache(
+        size="4KiB",
+        assoc=2,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=4,
+        tgts_per_mshr=8,
+    )
+    system.membus = SystemXBar()
+    system.cpu.l1i.cpu_side = system.cpu.icache_port
+    system.cpu.l1d.cpu_side = system.cpu.dcache_port
+    system.cpu.l1i.mem_side = system.membus.cpu_side_ports
+    system.cpu.l1d.mem_side = system.membus.cpu_side_ports
+
+    system.cpu.createInterruptController()
+    if args.cpu == "X86DerivO3CPU":
+        system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+        system.cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+        system.cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+    system.mem_ctrl = MemCtrl(dram=DDR3_1600_8x8())
+    system.mem_ctrl.dram.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.mem_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    return system
+
+
+root = Root(full_system=False)
+root.replay = make_system(True)
+root.squash = make_system(False)
+
+m5.instantiate()
+
+# The simulation exits once the threads of both systems have exited.
+exit_event = m5.simulate()
+if exit_event.getCause() != "exiting with last active thread context":
+    print(f"Unexpected exit: {exit_event.getCause()}")
+    exit(1)
+
+m5.stats.dump()
+
+
+def read_stats(prefix):
+    stats = {}
+    stat_re = re.compile(rf"^{prefix}\.cpu\.(\S+)\s+(\S+)")
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+        for line in f:
+            match = stat_re.match(line)
+            if match:
+                stats[match.group(1)] = match.group(2)
+    return stats
+
+
+replay_stats = read_stats("replay")
+squash_stats = read_stats("squash")
+
+failed = False
+for name in ("commitStats0.numInsts", "commitStats0.numOps"):
+    if replay_stats.get(name) != squash_stats.get(name):
+        print(
+            f"Mismatch {name}: replay {replay_stats.get(name)} "
+            f"squash {squash_stats.get(name)}"
+        )
+        failed = True
+
+replays = int(replay_stats.get("iew.valueMispredReplays", 0))
+if replays == 0:
+    print("No value misprediction was recovered by replay")
+    failed = True
+
+if failed:
+    exit(1)
+
+print(
+    f"Replayed {replays} value mispredictions, "
+    f"{replay_stats.get('iew.valueReplayedInsts')} instructions "
+    f"re-executed, {replay_stats.get('replayDelayedInserts')} inserted "
+    "instructions waited for a replayed operand"
+)
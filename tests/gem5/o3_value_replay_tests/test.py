@@ -0,0 +1,73 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs workloads on two identical O3 systems predicting load values, one
+recovering from mispredictions by selective replay and one by squashing,
+and checks that both commit the same instructions.
+"""
+
+import re
+
+from testlib import *
+
+workloads = ("Bubblesort", "FloatMM")
+
+valid_isas = {
+    constants.vega_x86_tag: "X86DerivO3CPU",
+    constants.arm_tag: "ArmDerivO3CPU",
+    constants.riscv_tag: "RiscvDerivO3CPU",
+}
+
+base_path = joinpath(config.bin_path, "o3_value_replay_tests")
+
+base_url = config.resource_url + "/test-progs/cpu-tests/bin/"
+
+isa_url = {
+    constants.vega_x86_tag: base_url + "x86",
+    constants.arm_tag: base_url + "arm",
+    constants.riscv_tag: base_url + "riscv",
+}
+
+for isa in valid_isas:
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        url = isa_url[isa] + "/" + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        cpu = valid_isas[isa]
+        gem5_verify_config(
+            name=f"o3_value_replay_test_{cpu}_{workload}",
+            verifiers=(
+                verifier.MatchRegex(
+                    re.compile(r"Replayed \d+ value mispredictions")
+                ),
+            ),
+            config=joinpath(getcwd(), "run.py"),
+            config_args=[f"--cpu={cpu}", binary],
+            valid_isas=(constants.all_compiled_tag,),
+            fixtures=[workload_binary],
+        )
@@ -0,0 +1,102 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Builds and runs the multi-core atomic system of the parallel fast-forward
+test. run.py imports it in a separate gem5 process for every run, as a
+process can only instantiate one simulation.
+"""
+
+import os
+import re
+import time
+
+# Stats describing the host rather than the simulation.
+host_stats = ("hostSeconds", "hostTickRate", "hostMemory", "hostInstRate",
+              "hostOpRate")
+
+
+def read_stats(outdir):
+    """Returns the last dumped value of every board stat."""
+    stats = {}
+    stat_re = re.compile(r"^board\.(\S+)\s+(.*?)\s*(#.*)?$")
+    with open(os.path.join(outdir, "stats.txt")) as f:
+        for line in f:
+            match = stat_re.match(line)
+            if match and not match.group(1).endswith(host_stats):
+                stats[match.group(1)] = match.group(2).split()
+    return stats
+
+
+def run_fast_forward(run):
+    """Simulates one copy of the binary per core to completion.
+
+    :param run: Tuple of the mode ("single", "deterministic" or
+                "parallel"), the ISA name, the binary and the core count.
+    :returns: The host seconds spent simulating and the board stats.
+    """
+    mode, isa, binary, num_cores = run
+
+    import m5
+
+    from gem5.components.boards.simple_board import SimpleBoard
+    from gem5.components.cachehierarchies.classic.no_cache import NoCache
+    from gem5.components.memory import SingleChannelDDR3_1600
+    from gem5.components.processors.cpu_types import CPUTypes
+    from gem5.components.processors.simple_processor import SimpleProcessor
+    from gem5.isas import get_isa_from_str
+    from gem5.resources.resource import BinaryResource
+    from gem5.simulate.simulator import Simulator
+
+    processor = SimpleProcessor(
+        cpu_type=CPUTypes.ATOMIC,
+        num_cores=num_cores,
+        isa=get_isa_from_str(isa),
+    )
+    for core in processor.get_cores():
+        core.get_simobject().backdoorAccesses = True
+
+    if mode == "deterministic":
+        processor.enable_parallel_fast_forward(deterministic=True)
+    elif mode == "parallel":
+        processor.enable_parallel_fast_forward()
+
+    board = SimpleBoard(
+        clk_freq="1GHz",
+        processor=processor,
+        memory=SingleChannelDDR3_1600(size="512MiB"),
+        cache_hierarchy=NoCache(),
+    )
+    board.set_se_multi_binary_workload(
+        [BinaryResource(local_path=binary) for _ in range(num_cores)]
+    )
+
+    simulator = Simulator(board=board)
+    start = time.perf_counter()
+    simulator.run()
+    seconds = time.perf_counter() - start
+
+    m5.stats.dump()
+    return seconds, read_stats(m5.options.outdir)
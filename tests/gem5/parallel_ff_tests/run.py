@@ -0,0 +1,104 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Fast-forwards a multi-core atomic system three times, each run in its own
+gem5 process: with all cores on a single event queue, with
+enable_parallel_fast_forward(deterministic=True), and with the cores on
+parallel event queues.
+
+The deterministic run has to match the single-queue run in every stat.
+The parallel run interleaves the cores differently, so only the
+instructions each core committed are compared. The wall-clock time of the
+single-queue and the parallel run is reported as the scaling of the
+parallel fast-forward.
+"""
+
+import argparse
+import re
+
+from fast_forward import run_fast_forward
+
+from gem5.utils.multiprocessing import Pool
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", type=str)
+parser.add_argument("--isa", type=str, required=True)
+parser.add_argument("--cores", type=int, default=4)
+
+args = parser.parse_args()
+
+modes = ("single", "deterministic", "parallel")
+
+# One fresh process per run, and one run at a time so that the runs do
+# not compete for host cores.
+with Pool(processes=1, maxtasksperchild=1) as pool:
+    results = pool.map(
+        run_fast_forward,
+        [(mode, args.isa, args.binary, args.cores) for mode in modes],
+        chunksize=1,
+    )
+seconds = {mode: result[0] for mode, result in zip(modes, results)}
+stats = {mode: result[1] for mode, result in zip(modes, results)}
+
+failed = not stats["single"]
+
+
+def compare(mode, names):
+    global failed
+    mismatches = [
+        name
+        for name in names
+        if stats[mode].get(name) != stats["single"].get(name)
+    ]
+    for name in mismatches:
+        print(
+            f"Mismatch {name}: {mode} {stats[mode].get(name)} "
+            f"single {stats['single'].get(name)}"
+        )
+    failed = failed or bool(mismatches) or not names
+    return not mismatches
+
+
+names = sorted(stats["single"].keys() | stats["deterministic"].keys())
+if compare("deterministic", names):
+    print(f"Deterministic run: all {len(names)} stats match")
+
+inst_re = re.compile(r"^processor\.cores\d+\.core\..*\.num(Insts|Ops)$")
+names = sorted(name for name in stats["single"] if inst_re.match(name))
+if compare("parallel", names):
+    print(f"Parallel run: all {len(names)} instruction counts match")
+
+speedup = seconds["single"] / seconds["parallel"]
+print(
+    f"Wall clock on {args.cores} cores: single queue "
+    f"{seconds['single']:.2f}s, deterministic "
+    f"{seconds['deterministic']:.2f}s, parallel "
+    f"{seconds['parallel']:.2f}s, speedup {speedup:.2f}x "
+    f"({speedup / args.cores:.0%} parallel efficiency)"
+)
+
+if failed:
+    exit(1)
@@ -0,0 +1,70 @@
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Fast-forwards a multi-core atomic system with the cores on one event queue,
+with enable_parallel_fast_forward(deterministic=True) and in parallel,
+checks the stats against the single-queue run and reports the wall-clock
+scaling.
+"""
+
+import re
+
+from testlib import *
+
+workloads = ("FloatMM",)
+
+valid_isas = {
+    constants.vega_x86_tag: "x86",
+    constants.arm_tag: "arm",
+    constants.riscv_tag: "riscv",
+}
+
+base_path = joinpath(config.bin_path, "parallel_ff_tests")
+
+base_url = config.resource_url + "/test-progs/cpu-tests/bin/"
+
+for isa_tag, isa in valid_isas.items():
+    path = joinpath(base_path, isa)
+    for workload in workloads:
+        url = base_url + isa + "/" + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        gem5_verify_config(
+            name=f"parallel_ff_test_{isa}_{workload}",
+            verifiers=(
+                verifier.MatchRegex(
+                    re.compile(r"Deterministic run: all \d+ stats match")
+                ),
+                verifier.MatchRegex(
+                    re.compile(r"Parallel run: all \d+ instruction counts")
+                ),
+            ),
+            config=joinpath(getcwd(), "run.py"),
+            config_args=[f"--isa={isa}", "--cores=4", binary],
+            valid_isas=(constants.all_compiled_tag,),
+            fixtures=[workload_binary],
+        )
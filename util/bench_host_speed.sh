@@ -0,0 +1,70 @@
+#!/bin/bash
+#
+# Compare O3 host simulation speed (simulated instructions per host second)
+# of two gem5 builds on one polybench binary, e.g. before and after a
+# change to the O3 model.
+#
+# Usage: ./util/bench_host_speed.sh BEFORE_GEM5 AFTER_GEM5 [BENCH] [RUNS]
+#   BENCH defaults to gemm_base, RUNS to 3. Extra config options can be
+#   passed through the CONFIG_ARGS environment variable.
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+cd "$ROOT_DIR"
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 BEFORE_GEM5 AFTER_GEM5 [BENCH] [RUNS]" >&2
+    exit 1
+fi
+
+BEFORE=$1
+AFTER=$2
+BENCH=${3:-gemm_base}
+RUNS=${4:-3}
+CONFIG=$ROOT_DIR/configs/example/arm/fdp_neoverse_v2_binary.py
+BINARY=$ROOT_DIR/polybench_binaries/$BENCH
+OUT_ROOT=host_speed_out/$BENCH
+
+fail() {
+    echo "$0: $*" >&2
+    exit 1
+}
+
+for gem5 in "$BEFORE" "$AFTER"; do
+    [ -x "$gem5" ] || fail "gem5 binary '$gem5' not found or not executable"
+done
+[ -f "$CONFIG" ] || fail "config '$CONFIG' not found"
+[ -f "$BINARY" ] || fail "benchmark binary '$BINARY' not found"
+
+# Print the median hostInstRate of all runs of one build.
+measure() {
+    local gem5=$1
+    local label=$2
+    local rates=()
+
+    for run in $(seq 1 "$RUNS"); do
+        local outdir="$OUT_ROOT/$label/$run"
+        mkdir -p "$outdir"
+        "$gem5" -d "$outdir" "$CONFIG" --binary "$BINARY" $CONFIG_ARGS \
+            > "$outdir/stdout.log" 2>&1 ||
+            fail "$gem5 failed, see $outdir/stdout.log"
+        local rate=$(awk '$1 == "hostInstRate" { print $2; exit }' \
+            "$outdir/stats.txt" 2>/dev/null)
+        [ -n "$rate" ] || fail "no hostInstRate in $outdir/stats.txt"
+        rates+=("$rate")
+    done
+
+    printf "%s\n" "${rates[@]}" | sort -n | \
+        awk '{ r[NR] = $1 } END { print r[int((NR + 1) / 2)] }'
+}
+
+echo "Benchmark: $BENCH, $RUNS run(s) per build"
+before_rate=$(measure "$BEFORE" before)
+after_rate=$(measure "$AFTER" after)
+
+echo "before: $before_rate inst/s"
+echo "after:  $after_rate inst/s"
+awk -v b="$before_rate" -v a="$after_rate" \
+    'BEGIN { printf "speedup: %.3fx\n", a / b }'
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2025 All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#/
+
+# This script converts a protobuf pipeline trace recorded by the O3
+# PipeTrace probe listener into text that existing viewers understand.
+# The default output is the O3PipeView format read by util/o3-pipeview.py
+# and by Konata, and --konata writes Konata's native Kanata log instead.
+# The Python package for the messages is generated on demand, or can be
+# built manually using:
+# protoc --python_out=. pipe_trace.proto
+
+import argparse
+import sys
+
+import protolib
+
+# Import the pipeline trace proto definitions
+try:
+    import pipe_trace_pb2
+except:
+    print(
+        "Did not find protobuf pipe trace definitions, attempting to generate"
+    )
+    from subprocess import call
+
+    error = call(
+        [
+            "protoc",
+            "--python_out=util",
+            "--proto_path=src/proto",
+            "src/proto/pipe_trace.proto",
+        ]
+    )
+    if not error:
+        print("Generated pipe trace proto definitions")
+
+        try:
+            import google.protobuf
+        except:
+            print("Please install Python protobuf module")
+            exit(-1)
+
+        import pipe_trace_pb2
+    else:
+        print("Failed to import pipe trace proto definitions")
+        exit(-1)
+
+
+# Stage fields in pipeline order, with the O3PipeView and Kanata names
+stages = (
+    ("decode", "Dc"),
+    ("rename", "Rn"),
+    ("dispatch", "Ds"),
+    ("issue", "Is"),
+    ("complete", "Cm"),
+)
+
+flag_names = (
+    (pipe_trace_pb2.PipeTraceRecord.ValuePredicted, "vp"),
+    (pipe_trace_pb2.PipeTraceRecord.CompSimplified, "cs"),
+    (pipe_trace_pb2.PipeTraceRecord.MemRenamed, "mr"),
+    (pipe_trace_pb2.PipeTraceRecord.Eliminated, "elim"),
+)
+
+
+def stage_tick(rec, field):
+    """Absolute tick of a stage, or 0 if it was never reached."""
+    if rec.HasField(field):
+        return rec.fetch_tick + getattr(rec, field)
+    return 0
+
+
+def annotate(rec, disasm):
+    names = [name for bit, name in flag_names if rec.flags & bit]
+    if names:
+        return "%s [%s]" % (disasm, ",".join(names))
+    return disasm
+
+
+def write_pipeview(out, rec, disasm):
+    out.write(
+        "O3PipeView:fetch:%d:0x%08x:%d:%d:%s\n"
+        % (rec.fetch_tick, rec.pc, rec.upc, rec.seq_num, disasm)
+    )
+    for field, _ in stages:
+        out.write("O3PipeView:%s:%d\n" % (field, stage_tick(rec, field)))
+    # A zero retire tick marks the instruction as squashed. Store
+    # completion is not recorded by the trace.
+    out.write("O3PipeView:retire:%d:store:0\n" % stage_tick(rec, "commit"))
+
+
+def konata_events(rec, disasm, uid, period):
+    """Kanata commands for one record as (cycle, order, text) tuples."""
+    cycle = lambda tick: tick // period
+    last = cycle(rec.fetch_tick)
+    events = [
+        (last, 0, "I\t%d\t%d\t%d" % (uid, rec.seq_num, rec.tid)),
+        (last, 1, "L\t%d\t0\t%#x: %s" % (uid, rec.pc, disasm)),
+        (last, 2, "S\t%d\t0\tF" % uid),
+    ]
+    for field, name in stages:
+        if rec.HasField(field):
+            last = cycle(stage_tick(rec, field))
+            events.append((last, 2, "S\t%d\t0\t%s" % (uid, name)))
+    if rec.squashed:
+        events.append((last + 1, 3, "R\t%d\t%d\t1" % (uid, uid)))
+    else:
+        last = cycle(stage_tick(rec, "commit"))
+        events.append((last, 2, "S\t%d\t0\tCmt" % uid))
+        events.append((last + 1, 3, "R\t%d\t%d\t0" % (uid, uid)))
+    return events
+
+
+def write_konata(out, events):
+    events.sort(key=lambda e: (e[0], e[1]))
+    out.write("Kanata\t0004\n")
+    if not events:
+        return
+    cur = events[0][0]
+    out.write("C=\t%d\n" % cur)
+    for cycle, _, text in events:
+        if cycle != cur:
+            out.write("C\t%d\n" % (cycle - cur))
+            cur = cycle
+        out.write(text + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a protobuf O3 pipeline trace to text"
+    )
+    parser.add_argument("input", help="protobuf pipeline trace")
+    parser.add_argument("output", help="text output file")
+    parser.add_argument(
+        "--konata",
+        action="store_true",
+        help="write the Kanata log format instead of O3PipeView",
+    )
+    args = parser.parse_args()
+
+    # Open the file in read mode
+    proto_in = protolib.openFileRd(args.input)
+
+    try:
+        text_out = open(args.output, "w")
+    except OSError:
+        print("Failed to open ", args.output, " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4)
+
+    if magic_number != b"gem5":
+        print("Unrecognized file", args.input)
+        exit(-1)
+
+    print("Parsing pipe trace header")
+
+    header = pipe_trace_pb2.PipeTraceHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    print("Object id:", header.obj_id)
+    print("Tick frequency:", header.tick_freq)
+    print("Clock period:", header.clock_period)
+
+    if header.ver != 0:
+        print("Warning: file version newer than decoder:", header.ver)
+        print("This decoder may not understand how to decode this file")
+
+    print("Parsing instructions")
+
+    period = max(header.clock_period, 1)
+    disasm = {}
+    events = []
+    num_insts = 0
+    rec = pipe_trace_pb2.PipeTraceRecord()
+
+    while protolib.decodeMessage(proto_in, rec):
+        key = (rec.pc, rec.upc)
+        if rec.HasField("disasm"):
+            disasm[key] = rec.disasm
+        text = annotate(rec, disasm.get(key, "?"))
+
+        if args.konata:
+            events.extend(konata_events(rec, text, num_insts, period))
+        else:
+            write_pipeview(text_out, rec, text)
+        num_insts += 1
+
+    if args.konata:
+        write_konata(text_out, events)
+
+    print("Parsed instructions:", num_insts)
+
+    # We're done
+    text_out.close()
+    proto_in.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Microbenchmark of the host time the O3 LSQ spends searching its queues
+ * per simulated load, with the linear scans and with AddrRangeIndex.
+ *
+ * Replays a synthetic load/store stream through load and store queues of
+ * the configured sizes. Every load searches the older stores for a
+ * forwarding candidate and every store searches the younger loads for an
+ * ordering violation, mirroring LSQUnit::read and
+ * LSQUnit::checkViolations. Both searches must find the same entries.
+ *
+ * Usage: lsq_index_bench [LQ_ENTRIES] [SQ_ENTRIES] [LOADS] [FOOTPRINT]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "base/addr_range_index.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Entry
+{
+    uint64_t idx;
+    Addr addr;
+    Addr size;
+};
+
+struct Queues
+{
+    std::deque<Entry> lq;
+    std::deque<Entry> sq;
+    AddrRangeIndex lqIndex{6};
+    AddrRangeIndex sqIndex{6};
+    std::vector<AddrRangeIndex::Key> hits;
+    uint64_t nextIdx = 1;
+};
+
+bool
+overlaps(const Entry &a, Addr addr, Addr size)
+{
+    return a.addr < addr + size && addr < a.addr + a.size;
+}
+
+/** Youngest older store overlapping the load, 0 if none. */
+uint64_t
+forwardLinear(Queues &q, Addr addr, Addr size)
+{
+    for (auto it = q.sq.rbegin(); it != q.sq.rend(); ++it) {
+        if (overlaps(*it, addr, size)) {
+            return it->idx;
+        }
+    }
+    return 0;
+}
+
+uint64_t
+forwardIndexed(Queues &q, Addr addr, Addr size)
+{
+    q.sqIndex.lookup(addr, size, q.hits);
+    for (auto it = q.hits.rbegin(); it != q.hits.rend(); ++it) {
+        const Entry &st = q.sq[*it - q.sq.front().idx];
+        if (overlaps(st, addr, size)) {
+            return st.idx;
+        }
+    }
+    return 0;
+}
+
+/** Number of loads overlapping the store. */
+unsigned
+violationsLinear(Queues &q, Addr addr, Addr size)
+{
+    unsigned found = 0;
+    for (const auto &ld : q.lq) {
+        found += overlaps(ld, addr, size);
+    }
+    return found;
+}
+
+unsigned
+violationsIndexed(Queues &q, Addr addr, Addr size)
+{
+    unsigned found = 0;
+    q.lqIndex.lookup(addr, size, q.hits);
+    for (auto idx : q.hits) {
+        found += overlaps(q.lq[idx - q.lq.front().idx], addr, size);
+    }
+    return found;
+}
+
+template <typename Queue>
+void
+push(Queue &queue, AddrRangeIndex &index, size_t capacity, uint64_t idx,
+     Addr addr, Addr size)
+{
+    if (queue.size() == capacity) {
+        index.erase(queue.front().idx);
+        queue.pop_front();
+    }
+    // Indices are only contiguous within a queue, as in CircularQueue.
+    queue.push_back({idx, addr, size});
+    index.insert(idx, addr, size);
+}
+
+struct Op
+{
+    bool store;
+    Addr addr;
+    Addr size;
+};
+
+/** The access stream, generated up front so it is not timed. */
+std::vector<Op>
+makeStream(unsigned loads, Addr footprint)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<Addr> addr_dist(0, footprint / 8 - 1);
+    std::vector<Op> ops;
+
+    for (unsigned done = 0; done < loads;) {
+        // Mostly 8 byte accesses, some unaligned 16 byte ones that can
+        // cross a cache line. One in three accesses is a store.
+        const bool store = rng() % 3 == 0;
+        const Addr addr = addr_dist(rng) * 8 + (rng() % 4 == 0 ? 4 : 0);
+        const Addr size = rng() % 4 == 0 ? 16 : 8;
+        ops.push_back({store, addr, size});
+        done += !store;
+    }
+    return ops;
+}
+
+double
+run(bool indexed, size_t lq_entries, size_t sq_entries,
+    const std::vector<Op> &ops, unsigned loads, uint64_t &checksum)
+{
+    Queues q;
+    uint64_t lq_idx = 1, sq_idx = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Op &op : ops) {
+        if (op.store) {
+            checksum += indexed ? violationsIndexed(q, op.addr, op.size) :
+                                  violationsLinear(q, op.addr, op.size);
+            push(q.sq, q.sqIndex, sq_entries, sq_idx++, op.addr, op.size);
+        } else {
+            checksum += indexed ? forwardIndexed(q, op.addr, op.size) :
+                                  forwardLinear(q, op.addr, op.size);
+            push(q.lq, q.lqIndex, lq_entries, lq_idx++, op.addr, op.size);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           loads;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const size_t lq_entries = argc > 1 ? std::atoi(argv[1]) : 128;
+    const size_t sq_entries = argc > 2 ? std::atoi(argv[2]) : 72;
+    const unsigned loads = argc > 3 ? std::atoi(argv[3]) : 2000000;
+    const Addr footprint = argc > 4 ? std::atoll(argv[4]) : 64 * 1024;
+
+    const std::vector<Op> ops = makeStream(loads, footprint);
+    uint64_t linear_sum = 0, indexed_sum = 0;
+    const double linear = run(false, lq_entries, sq_entries, ops, loads,
+                              linear_sum);
+    const double indexed = run(true, lq_entries, sq_entries, ops, loads,
+                               indexed_sum);
+
+    if (linear_sum != indexed_sum) {
+        std::fprintf(stderr, "Indexed search found different entries!\n");
+        return 1;
+    }
+
+    std::printf("LQ %zu SQ %zu, %u loads, %llu byte footprint\n",
+                lq_entries, sq_entries, loads,
+                (unsigned long long)footprint);
+    std::printf("linear:  %8.1f ns per load\n", linear);
+    std::printf("indexed: %8.1f ns per load\n", indexed);
+    std::printf("speedup: %8.2fx\n", linear / indexed);
+    return 0;
+}